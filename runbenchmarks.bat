@@ -0,0 +1,13 @@
+@ECHO OFF
+
+SETLOCAL ENABLEDELAYEDEXPANSION
+
+TITLE Running OpenCOR's benchmarks...
+
+SET AppExe=%~dp0build\bin\OpenCOR.com
+
+IF NOT EXIST !AppExe! (
+    ECHO OpenCOR must first be built before its benchmarks can be run.
+) ELSE (
+    !AppExe! -c PythonShell %~dp0src\benchmarks\benchmarks.py --opencor !AppExe! %*
+)
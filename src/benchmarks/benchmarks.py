@@ -0,0 +1,311 @@
+# OpenCOR's simulation benchmarks
+#
+# Usage (from OpenCOR's root directory, using runbenchmarks[.bat]):
+#     runbenchmarks [--output <file>] [--compare <baseline>] [--tolerance <t>]
+#                   [--solver <name> ...] [--ending-point <p>] [--point-interval <i>]
+#                   [--dae] [<model> ...]
+#
+# Note: runbenchmarks[.bat] also passes --opencor <executable> to us, so that we
+#       can run each benchmark in its own instance of OpenCOR...
+#
+# By default, all the bundled models (i.e. models/*.cellml) are benchmarked
+# using all of our ODE solvers. For each model/solver pair, we report (as JSON)
+# the time it takes to load/compile the model, the wall time of the simulation,
+# its throughput (in RHS evaluations per second), the time it takes to export
+# its results to CSV using our CSV data store (and the corresponding throughput,
+# in bytes per second) and the peak RSS of the instance of OpenCOR that ran the
+# benchmark.
+#
+# With --dae, our DAE test models (i.e. models with algebraic loops) are instead
+# benchmarked using CVODE and a fine point interval, which is where the number
+# of CVODE steps and RHS evaluations (also reported) matters the most.
+#
+# When comparing against a baseline (i.e. the JSON output of a previous run),
+# any metric that got worse by more than the given tolerance (10% by default)
+# is reported as a regression and we exit with a non-zero code.
+
+import argparse
+import glob
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import time
+
+import opencor as oc
+
+try:
+    import resource
+except ImportError:
+    resource = None
+
+ODE_SOLVERS = ['CVODE', 'Dormand-Prince', 'Euler (forward)', 'Heun', 'IDA', 'Runge-Kutta (2nd order)', 'Runge-Kutta (4th order)']
+FIXED_STEP_ODE_SOLVERS = ['Euler (forward)', 'Heun', 'Runge-Kutta (2nd order)', 'Runge-Kutta (4th order)']
+FIXED_STEP_ODE_SOLVERS_STEP = 0.01
+
+DAE_MODELS = ['parabola_dae_model.cellml', 'parabola_variant_dae_model.cellml', 'simple_dae_model.cellml']
+DAE_ODE_SOLVERS = ['CVODE', 'IDA']
+DAE_POINT_INTERVAL = 0.001
+
+# Metrics that we compare against a baseline, and whether a higher value is
+# better
+
+METRICS = {
+    'jit_time': False,
+    'wall_time': False,
+    'rhs_evaluations_per_second': True,
+    'export_throughput': True,
+    'peak_rss': False,
+    'steps': False,
+    'rhs_evaluations': False,
+}
+
+
+def peak_rss():
+    # Return the peak RSS of our process (in bytes), if we can determine it
+    # Note: this is a process-wide high-water mark, hence we run each benchmark
+    #       in its own instance of OpenCOR (see run_benchmark())...
+
+    if resource is None:
+        return None
+
+    res = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+
+    # Note: ru_maxrss is in kilobytes on Linux, but in bytes on macOS...
+
+    return res if sys.platform == 'darwin' else 1024 * res
+
+
+def export_results(results):
+    # Export the results of our simulation to a temporary CSV file, using our
+    # CSV data store, and return the size of that file
+
+    file_descriptor, file_name = tempfile.mkstemp(suffix='.csv')
+
+    os.close(file_descriptor)
+
+    try:
+        results.data_store().export_data(file_name, 'CSV')
+
+        return os.path.getsize(file_name)
+    finally:
+        os.remove(file_name)
+
+
+def benchmark(model, solver, args):
+    # Open (i.e. load and compile) our model
+
+    start = time.perf_counter()
+    simulation = oc.open_simulation(model)
+    jit_time = time.perf_counter() - start
+
+    try:
+        if not simulation.valid():
+            return {'model': model, 'solver': solver, 'error': 'The model is not valid.'}
+
+        # Set up our simulation
+
+        data = simulation.data()
+
+        if args.ending_point is not None:
+            data.set_ending_point(args.ending_point)
+
+        if args.point_interval is not None:
+            data.set_point_interval(args.point_interval)
+
+        data.set_ode_solver(solver)
+
+        if solver in FIXED_STEP_ODE_SOLVERS:
+            data.set_ode_solver_property('Step', FIXED_STEP_ODE_SOLVERS_STEP)
+
+        # Run our simulation, making sure that it is instrumented
+
+        simulation.set_instrumented(True)
+
+        start = time.perf_counter()
+        success = simulation.run()
+        wall_time = time.perf_counter() - start
+
+        if not success:
+            return {'model': model, 'solver': solver, 'error': 'The simulation could not be run.'}
+
+        # Export our results
+
+        results = simulation.results()
+        statistics = dict(simulation.statistics())
+        rhs_evaluations = statistics.get('rhsEvaluations')
+
+        start = time.perf_counter()
+        export_size = export_results(results)
+        export_time = time.perf_counter() - start
+
+        return {
+            'model': model,
+            'solver': solver,
+            'jit_time': jit_time,
+            'wall_time': wall_time,
+            'points': statistics.get('points'),
+            'rhs_evaluations_per_second': rhs_evaluations / wall_time if rhs_evaluations and wall_time > 0.0 else None,
+            'export_time': export_time,
+            'export_throughput': export_size / export_time if export_time > 0.0 else None,
+            'peak_rss': peak_rss(),
+            'steps': statistics.get('steps'),
+            'rhs_evaluations': rhs_evaluations,
+            'statistics': statistics,
+        }
+    finally:
+        oc.close_simulation(simulation)
+
+
+def run_benchmark(model, solver, args):
+    # Run our benchmark in its own instance of OpenCOR, so that its peak RSS is
+    # not affected by our other benchmarks, and retrieve its result from a
+    # temporary JSON file
+
+    file_descriptor, file_name = tempfile.mkstemp(suffix='.json')
+
+    os.close(file_descriptor)
+
+    try:
+        command = [args.opencor, '-c', 'PythonShell', os.path.abspath(__file__),
+                   '--benchmark-output', file_name, '--solver', solver]
+
+        if args.ending_point is not None:
+            command += ['--ending-point', repr(args.ending_point)]
+
+        if args.point_interval is not None:
+            command += ['--point-interval', repr(args.point_interval)]
+
+        subprocess.run(command + [model], stdout=subprocess.DEVNULL)
+
+        try:
+            with open(file_name) as file:
+                return json.load(file)
+        except ValueError:
+            return {'model': model, 'solver': solver, 'error': 'The benchmark could not be run.'}
+    finally:
+        os.remove(file_name)
+
+
+def compare(results, baseline, tolerance):
+    # Compare our results against the given baseline and return the
+    # regressions, if any
+
+    baseline_results = {(result['model'], result['solver']): result for result in baseline['results']}
+    res = []
+
+    for result in results:
+        baseline_result = baseline_results.get((result['model'], result['solver']))
+
+        if baseline_result is None:
+            continue
+
+        for metric, higher_is_better in METRICS.items():
+            value = result.get(metric)
+            baseline_value = baseline_result.get(metric)
+
+            if not value or not baseline_value:
+                continue
+
+            change = (value - baseline_value) / baseline_value
+
+            if (-change if higher_is_better else change) > tolerance:
+                res.append({
+                    'model': result['model'],
+                    'solver': result['solver'],
+                    'metric': metric,
+                    'baseline': baseline_value,
+                    'value': value,
+                    'change': change,
+                })
+
+    return res
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run OpenCOR's simulation benchmarks.")
+
+    parser.add_argument('models', nargs='*', help='the models to benchmark (default: models/*.cellml)')
+    parser.add_argument('--solver', action='append', dest='solvers', help='an ODE solver to use (default: all)')
+    parser.add_argument('--ending-point', type=float, help='the ending point of the simulations')
+    parser.add_argument('--point-interval', type=float, help='the point interval of the simulations')
+    parser.add_argument('--output', help='the file to which the results are to be saved (default: stdout)')
+    parser.add_argument('--compare', help='a baseline against which the results are to be compared')
+    parser.add_argument('--tolerance', type=float, default=0.1, help='the tolerance for a regression (default: 0.1)')
+    parser.add_argument('--dae', action='store_true',
+                        help='benchmark our DAE test models using CVODE and a fine point interval')
+    parser.add_argument('--opencor', help='the OpenCOR executable to use to run each benchmark')
+    parser.add_argument('--benchmark-output', help=argparse.SUPPRESS)
+
+    args = parser.parse_args()
+
+    # Run a single benchmark and save its result, if requested (i.e. we are
+    # being run by run_benchmark())
+
+    if args.benchmark_output:
+        with open(args.benchmark_output, 'w') as file:
+            json.dump(benchmark(os.path.normpath(os.path.abspath(args.models[0])), args.solvers[0], args), file)
+
+        return 0
+
+    if not args.opencor:
+        parser.error('the OpenCOR executable must be specified using --opencor')
+
+    models_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'models')
+
+    if args.dae:
+        models = args.models or [os.path.join(models_dir, 'tests', 'cellml', model) for model in DAE_MODELS]
+        solvers = args.solvers or DAE_ODE_SOLVERS
+
+        if args.point_interval is None:
+            args.point_interval = DAE_POINT_INTERVAL
+    else:
+        models = args.models or sorted(glob.glob(os.path.join(models_dir, '*.cellml')))
+        solvers = args.solvers or ODE_SOLVERS
+
+    models = [os.path.normpath(os.path.abspath(model)) for model in models]
+
+    # Run our benchmarks
+
+    results = []
+
+    for model in models:
+        for solver in solvers:
+            print('Benchmarking %s using %s...' % (os.path.basename(model), solver), file=sys.stderr)
+
+            results.append(run_benchmark(model, solver, args))
+
+    report = {
+        'platform': platform.platform(),
+        'python': platform.python_version(),
+        'results': results,
+    }
+
+    # Compare our results against a baseline, if requested
+
+    if args.compare:
+        with open(args.compare) as file:
+            report['regressions'] = compare(results, json.load(file), args.tolerance)
+
+    # Output our report
+
+    output = json.dumps(report, indent=2)
+
+    if args.output:
+        with open(args.output, 'w') as file:
+            file.write(output + '\n')
+    else:
+        print(output)
+
+    for regression in report.get('regressions', []):
+        print('Regression: %s using %s, %s went from %g to %g (%+.1f%%)'
+              % (os.path.basename(regression['model']), regression['solver'], regression['metric'],
+                 regression['baseline'], regression['value'], 100.0 * regression['change']), file=sys.stderr)
+
+    return 1 if report.get('regressions') else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -37,6 +37,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 #include <QCoreApplication>
 #include <QDir>
 #include <QSettings>
+#include <QThread>
 
 //==============================================================================
 
@@ -44,11 +45,21 @@ namespace OpenCOR {
 
 //==============================================================================
 
+static const auto CommandSeparator = QStringLiteral("::");
+
+//==============================================================================
+
+static CliApplication *cliApplication = nullptr;
+
+//==============================================================================
+
 CliApplication::CliApplication(int &pArgC, char *pArgV[]) // NOLINT(hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
 {
     // Create our CLI application
 
     mCliApplication = new QCoreApplication(pArgC, pArgV);
+
+    cliApplication = this;
 }
 
 //==============================================================================
@@ -77,25 +88,47 @@ CliApplication::~CliApplication()
 
     delete mCliApplication;
     delete mPluginManager;
+
+    cliApplication = nullptr;
 }
 
 //==============================================================================
 
-void CliApplication::loadPlugins()
+void CliApplication::loadPlugins(const QString &pPluginName)
 {
-    // Load all the plugins by creating our plugin manager
+    // Load the plugins by creating our plugin manager
+    // Note: if we are given the name of a plugin, then only that plugin and its
+    //       dependencies get loaded while solvers get deferred until they are
+    //       first needed, i.e. when Core::solverInterfaces() gets called. To
+    //       that end, we let the Core plugin know how to activate them...
+
+    mPluginManager = new PluginManager(false, pPluginName);
+
+    if (mPluginManager->hasDeferredPlugins()) {
+        qApp->setProperty(DeferredPluginsActivatorSignature.toUtf8().constData(),
+                          quint64(&CliApplication::activateDeferredPlugins));
+    }
 
-    mPluginManager = new PluginManager(false);
+    // Initialise our loaded plugins
 
+    initializePlugins(mPluginManager->loadedPlugins());
+}
+
+//==============================================================================
+
+void CliApplication::initializePlugins(const Plugins &pPlugins)
+{
     // Retrieve some categories of plugins
 
-    for (auto plugin : mPluginManager->loadedPlugins()) {
+    Plugins pluginPlugins;
+
+    for (auto plugin : pPlugins) {
         if (qobject_cast<CliInterface *>(plugin->instance()) != nullptr) {
             mLoadedCliPlugins << plugin;
         }
 
         if (qobject_cast<PluginInterface *>(plugin->instance()) != nullptr) {
-            mLoadedPluginPlugins << plugin;
+            pluginPlugins << plugin;
         }
 
         if (qobject_cast<SolverInterface *>(plugin->instance()) != nullptr) {
@@ -103,15 +136,17 @@ void CliApplication::loadPlugins()
         }
     }
 
+    mLoadedPluginPlugins << pluginPlugins;
+
     // Initialise the plugins themselves
 
-    for (auto plugin : mLoadedPluginPlugins) {
+    for (auto plugin : pluginPlugins) {
         qobject_cast<PluginInterface *>(plugin->instance())->initializePlugin();
     }
 
     // Let our various plugins know that all of them have been initialised
 
-    for (auto plugin : mLoadedPluginPlugins) {
+    for (auto plugin : pluginPlugins) {
         qobject_cast<PluginInterface *>(plugin->instance())->pluginsInitialized(mPluginManager->loadedPlugins());
     }
 
@@ -120,7 +155,7 @@ void CliApplication::loadPlugins()
     QSettings settings;
 
     settings.beginGroup(SettingsPlugins);
-        for (auto plugin : mLoadedPluginPlugins) {
+        for (auto plugin : pluginPlugins) {
             settings.beginGroup(plugin->name());
                 qobject_cast<PluginInterface *>(plugin->instance())->loadSettings(settings);
             settings.endGroup();
@@ -130,6 +165,43 @@ void CliApplication::loadPlugins()
 
 //==============================================================================
 
+void CliApplication::activateDeferredPlugins()
+{
+    // Activate our deferred plugins, but only once, hence we first reset our
+    // deferred plugins activator
+    // Note: our plugins get created as children of our plugin manager, so we
+    //       must be called from the main thread (see
+    //       Core::solverInterfaces())...
+
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+    qApp->setProperty(DeferredPluginsActivatorSignature.toUtf8().constData(),
+                      quint64(0));
+
+    if (cliApplication == nullptr) {
+        return;
+    }
+
+    Plugins activatedPlugins = cliApplication->mPluginManager->activateDeferredPlugins();
+
+    if (activatedPlugins.isEmpty()) {
+        return;
+    }
+
+    cliApplication->initializePlugins(activatedPlugins);
+
+    // Let our Core plugin know about our newly activated plugins, so that it
+    // can update its list of interfaces
+
+    Plugin *corePlugin = cliApplication->mPluginManager->corePlugin();
+
+    if (corePlugin != nullptr) {
+        qobject_cast<PluginInterface *>(corePlugin->instance())->pluginsInitialized(cliApplication->mPluginManager->loadedPlugins());
+    }
+}
+
+//==============================================================================
+
 void CliApplication::includePlugins(const QStringList &pPluginNames,
                                     bool pInclude) const
 {
@@ -206,8 +278,6 @@ bool CliApplication::command(const QString &pCommand,
     // Determine whether the command is to be executed by all the CLI plugins or
     // only a given CLI plugin
 
-    static const QString CommandSeparator = "::";
-
     QString commandName = pCommand;
     QString commandPlugin = commandName;
     int commandSeparatorPosition = commandName.indexOf(CommandSeparator);
@@ -634,9 +704,15 @@ bool CliApplication::run(int &pRes)
 
                 help();
             } else {
-                loadPlugins();
+                // Only load the plugin to which the command is to be sent, if
+                // any, and its dependencies
 
                 QString command = arguments.first();
+                int commandSeparatorPosition = command.indexOf(CommandSeparator);
+
+                loadPlugins((commandSeparatorPosition > 0)?
+                                command.left(commandSeparatorPosition):
+                                QString());
 
                 arguments.removeFirst();
 
@@ -62,7 +62,10 @@ private:
     Plugins mLoadedPluginPlugins;
     Plugins mLoadedSolverPlugins;
 
-    void loadPlugins();
+    void loadPlugins(const QString &pPluginName = QString());
+    void initializePlugins(const Plugins &pPlugins);
+
+    static void activateDeferredPlugins();
     void includePlugins(const QStringList &pPluginNames,
                         bool pInclude = true) const;
 
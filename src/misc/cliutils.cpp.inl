@@ -213,9 +213,14 @@ QStringList canonicalFileNames(const QStringList &pFileNames)
 
 //==============================================================================
 
+static const int MaximumNumberOfRedirections = 10;
+
+//==============================================================================
+
 bool SynchronousFileDownloader::download(const QString &pUrl,
                                          QByteArray &pContents,
-                                         QString *pErrorMessage) const
+                                         QString *pErrorMessage,
+                                         int pRedirectionsCount) const
 {
     // Try to read a remote file as text, but only if we are connected to the
     // Internet
@@ -251,14 +256,24 @@ bool SynchronousFileDownloader::download(const QString &pUrl,
 
         if (res) {
             // Before accepting the contents as is, make sure that we are not
-            // dealing with a redirection
+            // dealing with a redirection, which we follow unless there have
+            // already been too many of them (e.g. a redirection loop)
 
             QUrl redirectedUrl = networkReply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl();
 
             if (!redirectedUrl.isEmpty()) {
                 networkReply->deleteLater();
 
-                return download(redirectedUrl.toString(), pContents, pErrorMessage);
+                if (pRedirectionsCount == MaximumNumberOfRedirections) {
+                    if (pErrorMessage != nullptr) {
+                        *pErrorMessage = QObject::tr("Too many redirections.");
+                    }
+
+                    return false;
+                }
+
+                return download(networkReply->url().resolved(redirectedUrl).toString(),
+                                pContents, pErrorMessage, pRedirectionsCount+1);
             }
 
             pContents = networkReply->readAll();
@@ -284,6 +299,85 @@ bool SynchronousFileDownloader::download(const QString &pUrl,
 
 //==============================================================================
 
+bool SynchronousFileDownloader::download(const QStringList &pUrls,
+                                         QMap<QString, QByteArray> &pContents) const
+{
+    // Try to read several remote files at once, but only if we are connected
+    // to the Internet
+
+    pContents.clear();
+
+    if (!hasInternetConnection()) {
+        return false;
+    }
+
+    // Create a network access manager so that we can retrieve the contents of
+    // the remote files, making sure that we get told if there are SSL errors
+
+    QNetworkAccessManager networkAccessManager;
+
+    connect(&networkAccessManager, &QNetworkAccessManager::sslErrors,
+            this, &SynchronousFileDownloader::networkAccessManagerSslErrors);
+
+    // Request all the remote files at once and wait for all of them to be
+    // downloaded, following redirections (but not too many of them), if needed
+
+    QEventLoop waitLoop;
+    QMap<QNetworkReply *, QString> networkReplies;
+    QMap<QNetworkReply *, int> networkRepliesRedirectionsCount;
+
+    for (const auto &url : pUrls) {
+        QNetworkReply *networkReply = networkAccessManager.get(QNetworkRequest(url));
+
+        connect(networkReply, &QNetworkReply::finished,
+                &waitLoop, &QEventLoop::quit);
+
+        networkReplies.insert(networkReply, url);
+        networkRepliesRedirectionsCount.insert(networkReply, 0);
+    }
+
+    bool res = true;
+
+    while (!networkReplies.isEmpty()) {
+        waitLoop.exec();
+
+        for (auto networkReply : networkReplies.keys()) {
+            if (!networkReply->isFinished()) {
+                continue;
+            }
+
+            QString url = networkReplies.take(networkReply);
+            int redirectionsCount = networkRepliesRedirectionsCount.take(networkReply);
+
+            if (networkReply->error() == QNetworkReply::NoError) {
+                QUrl redirectedUrl = networkReply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl();
+
+                if (redirectedUrl.isEmpty()) {
+                    pContents.insert(url, networkReply->readAll());
+                } else if (redirectionsCount == MaximumNumberOfRedirections) {
+                    res = false;
+                } else {
+                    QNetworkReply *redirectedNetworkReply = networkAccessManager.get(QNetworkRequest(networkReply->url().resolved(redirectedUrl)));
+
+                    connect(redirectedNetworkReply, &QNetworkReply::finished,
+                            &waitLoop, &QEventLoop::quit);
+
+                    networkReplies.insert(redirectedNetworkReply, url);
+                    networkRepliesRedirectionsCount.insert(redirectedNetworkReply, redirectionsCount+1);
+                }
+            } else {
+                res = false;
+            }
+
+            networkReply->deleteLater();
+        }
+    }
+
+    return res;
+}
+
+//==============================================================================
+
 void SynchronousFileDownloader::networkAccessManagerSslErrors(QNetworkReply *pNetworkReply,
                                                               const QList<QSslError> &pSslErrors)
 {
@@ -534,7 +628,11 @@ bool readFile(const QString &pFileNameOrUrl, QByteArray &pFileContents,
         return false;
     }
 
-    static SynchronousFileDownloader synchronousFileDownloader;
+    // Note: our file downloader is local since we may be called from different
+    //       threads at once, and a QObject (and its connections) should only
+    //       be used from the thread in which it was created...
+
+    SynchronousFileDownloader synchronousFileDownloader;
 
     return synchronousFileDownloader.download(fileNameOrUrl, pFileContents, pErrorMessage);
 }
@@ -556,6 +654,61 @@ bool readFile(const QString &pFileNameOrUrl, QString &pFileContents,
 
 //==============================================================================
 
+bool readFiles(const QStringList &pFileNamesOrUrls,
+               QMap<QString, QByteArray> &pFilesContents)
+{
+    // Read the contents of the given files, downloading all the remote ones at
+    // once
+    // Note: the contents of a file is keyed by its file name or URL, as
+    //       returned by checkFileNameOrUrl()...
+
+    pFilesContents.clear();
+
+    bool res = true;
+    QStringList urls;
+
+    for (const auto &fileNameOrUrl : pFileNamesOrUrls) {
+        bool isLocalFile;
+        QString realFileNameOrUrl;
+
+        checkFileNameOrUrl(fileNameOrUrl, isLocalFile, realFileNameOrUrl);
+
+        if (isLocalFile) {
+            QFile file(realFileNameOrUrl);
+
+            if (file.open(QIODevice::ReadOnly)) {
+                pFilesContents.insert(realFileNameOrUrl, file.readAll());
+
+                file.close();
+            } else {
+                res = false;
+            }
+        } else {
+            urls << realFileNameOrUrl;
+        }
+    }
+
+    if (!urls.isEmpty()) {
+        // Download all our remote files at once
+        // Note: see readFile() for why our file downloader is local...
+
+        SynchronousFileDownloader synchronousFileDownloader;
+        QMap<QString, QByteArray> urlsContents;
+
+        res = synchronousFileDownloader.download(urls, urlsContents) && res;
+
+        for (auto urlContents = urlsContents.constBegin(),
+                  urlContentsEnd = urlsContents.constEnd();
+             urlContents != urlContentsEnd; ++urlContents) {
+            pFilesContents.insert(urlContents.key(), urlContents.value());
+        }
+    }
+
+    return res;
+}
+
+//==============================================================================
+
 bool writeFile(const QString &pFileName, const QByteArray &pFileContents)
 {
     // Write the given file contents to a temporary file and rename it to the
@@ -30,6 +30,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QMap>
 #include <QSslError>
 #include <QString>
 
@@ -61,7 +62,9 @@ class SynchronousFileDownloader : public QObject
 
 public:
     bool download(const QString &pUrl, QByteArray &pContents,
-                  QString *pErrorMessage) const;
+                  QString *pErrorMessage, int pRedirectionsCount = 0) const;
+    bool download(const QStringList &pUrls,
+                  QMap<QString, QByteArray> &pContents) const;
 
 private slots:
     void networkAccessManagerSslErrors(QNetworkReply *pNetworkReply,
@@ -63,6 +63,8 @@ bool CORE_EXPORT readFile(const QString &pFileNameOrUrl,
                           QString *pErrorMessage = nullptr);
 bool CORE_EXPORT readFile(const QString &pFileNameOrUrl, QString &pFileContents,
                           QString *pErrorMessage = nullptr);
+bool CORE_EXPORT readFiles(const QStringList &pFileNamesOrUrls,
+                           QMap<QString, QByteArray> &pFilesContents);
 
 bool CORE_EXPORT writeFile(const QString &pFileName,
                            const QByteArray &pFileContents);
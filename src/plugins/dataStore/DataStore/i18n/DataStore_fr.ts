@@ -22,6 +22,10 @@
         <source>The &apos;NoneType&apos; object is not subscriptable.</source>
         <translation>L&apos;objet &apos;NoneType&apos; n&apos;est pas enregistrable.</translation>
     </message>
+    <message>
+        <source>The requested data store (%1) could not be found.</source>
+        <translation>Le magasin de données demandé (%1) n&apos;a pas pu être trouvé.</translation>
+    </message>
 </context>
 <context>
     <name>QObject</name>
@@ -31,10 +31,16 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include "interfaces.h"
 #include "pythonqtsupport.h"
 
 //==============================================================================
 
+#include <QEventLoop>
+#include <QHash>
+
+//==============================================================================
+
 #include <array>
 
 //==============================================================================
@@ -55,6 +61,115 @@ static bool initNumPy()
 
 //==============================================================================
 
+static void releaseDataStoreArray(PyObject *pCapsule)
+{
+    // Release the data store array held by the given capsule
+
+    static_cast<DataStoreArray *>(PyCapsule_GetPointer(pCapsule, nullptr))->release();
+}
+
+//==============================================================================
+
+static PyObject * numPyArrayView(DataStoreArray *pDataStoreArray, quint64 pSize)
+{
+    // Create and return a NumPy array that aliases the given data store array
+    // Note: unlike NumPyPythonWrapper, we don't need a QObject to keep our data
+    //       store array alive, a capsule is all that is needed (and it is much
+    //       cheaper to create, which matters when dealing with thousands of
+    //       variables)...
+
+    std::array<npy_intp, 1> dims = { npy_intp(pSize) };
+
+#include "pythonbegin.h"
+    PyObject *res = PyArray_SimpleNewFromData(1, dims.data(), NPY_DOUBLE, static_cast<void *>(pDataStoreArray->data())); // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+
+    if (res == nullptr) {
+        return nullptr;
+    }
+
+    // Hold our data store array and make sure that it gets released when our
+    // NumPy array gets deleted
+    // Note: PyArray_SetBaseObject() steals a reference to our capsule, even if
+    //       it fails, in which case our capsule releases our data store
+    //       array...
+
+    pDataStoreArray->hold();
+
+    PyObject *capsule = PyCapsule_New(pDataStoreArray, nullptr, releaseDataStoreArray);
+
+    if (capsule == nullptr) {
+        pDataStoreArray->release();
+
+        Py_DECREF(res);
+
+        return nullptr;
+    }
+
+    if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject *>(res), capsule) != 0) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+        Py_DECREF(res);
+
+        return nullptr;
+    }
+#include "pythonend.h"
+
+    return res;
+}
+
+//==============================================================================
+
+static PyObject * numPyArrayViewOrNone(DataStoreArray *pDataStoreArray,
+                                       quint64 pSize)
+{
+    // Create and return a NumPy array that aliases the given data store array,
+    // if any, or None, if there is no data store array (e.g. for a run that
+    // has no data)
+
+    if (pDataStoreArray == nullptr) {
+#include "pythonbegin.h"
+        Py_INCREF(Py_None);
+#include "pythonend.h"
+
+        return Py_None;
+    }
+
+    return numPyArrayView(pDataStoreArray, pSize);
+}
+
+//==============================================================================
+
+static DataStoreVariables selectedDataStoreVariables(const DataStoreVariables &pDataStoreVariables,
+                                                     const QStringList &pUris)
+{
+    // Return the data store variables which URI is in the given list of URIs,
+    // or all of them if no URIs are given
+
+    if (pUris.isEmpty()) {
+        return pDataStoreVariables;
+    }
+
+    QHash<QString, DataStoreVariable *> dataStoreVariables;
+
+    for (auto dataStoreVariable : pDataStoreVariables) {
+        dataStoreVariables.insert(dataStoreVariable->uri(), dataStoreVariable);
+    }
+
+    DataStoreVariables res;
+
+    for (const auto &uri : pUris) {
+        DataStoreVariable *dataStoreVariable = dataStoreVariables.value(uri);
+
+        if (dataStoreVariable == nullptr) {
+            throw std::runtime_error(QObject::tr("The requested variable (%1) could not be found.").arg(uri).toStdString());
+        }
+
+        res << dataStoreVariable;
+    }
+
+    return res;
+}
+
+//==============================================================================
+
 static DataStoreValue * getDataStoreValue(PyObject *pValuesDict, PyObject *pKey)
 {
     // Get and return a DataStoreValue item from a values dictionary
@@ -369,9 +484,8 @@ PyObject * DataStorePythonWrapper::dataStoreValuesDict(const DataStoreValues *pD
 
     if (pDataStoreValues != nullptr) {
         for (int i = 0, iMax = pDataStoreValues->size(); i < iMax; ++i) {
-            auto value = pDataStoreValues->at(i);
-
-            PythonQtSupport::addObject(res, value->uri(), value);
+            PythonQtSupport::addObject(res, pDataStoreValues->uri(i),
+                                       pDataStoreValues->valueObject(i));
         }
     }
 
@@ -395,6 +509,93 @@ PyObject * DataStorePythonWrapper::dataStoreVariablesDict(const DataStoreVariabl
 
 //==============================================================================
 
+PyObject * DataStorePythonWrapper::dataStoreVariablesArraysDict(const DataStoreVariables &pDataStoreVariables,
+                                                                const QStringList &pUris,
+                                                                int pRun)
+{
+    // Create and return a Python dictionary of NumPy arrays for the given (or
+    // all the) data store variables and run, with each NumPy array aliasing
+    // the data of its corresponding data store variable
+
+    PyObject *res = PyDict_New();
+
+    if (res == nullptr) {
+        return nullptr;
+    }
+
+    for (auto dataStoreVariable : selectedDataStoreVariables(pDataStoreVariables, pUris)) {
+        PyObject *value = numPyArrayViewOrNone(dataStoreVariable->array(pRun),
+                                               dataStoreVariable->size(pRun));
+
+        if (   (value == nullptr)
+            || (PyDict_SetItemString(res, dataStoreVariable->uri().toUtf8().constData(), value) != 0)) {
+#include "pythonbegin.h"
+            Py_XDECREF(value);
+            Py_DECREF(res);
+#include "pythonend.h"
+
+            return nullptr;
+        }
+
+#include "pythonbegin.h"
+        Py_DECREF(value);
+#include "pythonend.h"
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+PyObject * DataStorePythonWrapper::dataStoreVariablesRunsArraysDict(const DataStoreVariables &pDataStoreVariables,
+                                                                    const QStringList &pUris)
+{
+    // Create and return a Python dictionary of lists of NumPy arrays, one per
+    // run, for the given (or all the) data store variables, with each NumPy
+    // array aliasing the data of its corresponding data store variable run
+
+    PyObject *res = PyDict_New();
+
+    if (res == nullptr) {
+        return nullptr;
+    }
+
+    for (auto dataStoreVariable : selectedDataStoreVariables(pDataStoreVariables, pUris)) {
+        int runsCount = dataStoreVariable->runsCount();
+        PyObject *runs = PyList_New(runsCount);
+        bool ok = runs != nullptr;
+
+        for (int i = 0; ok && (i < runsCount); ++i) {
+            PyObject *run = numPyArrayViewOrNone(dataStoreVariable->array(i),
+                                                 dataStoreVariable->size(i));
+
+            if (run != nullptr) {
+                PyList_SET_ITEM(runs, i, run); // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+            } else {
+                ok = false;
+            }
+        }
+
+        if (   !ok
+            || (PyDict_SetItemString(res, dataStoreVariable->uri().toUtf8().constData(), runs) != 0)) {
+#include "pythonbegin.h"
+            Py_XDECREF(runs);
+            Py_DECREF(res);
+#include "pythonend.h"
+
+            return nullptr;
+        }
+
+#include "pythonbegin.h"
+        Py_DECREF(runs);
+#include "pythonend.h"
+    }
+
+    return res;
+}
+
+//==============================================================================
+
 PyObject * DataStorePythonWrapper::variables(DataStore *pDataStore)
 {
     // Return the variables in the given data store as a Python dictionary
@@ -450,6 +651,83 @@ PyObject * DataStorePythonWrapper::values(DataStoreVariable *pDataStoreVariable,
 
 //==============================================================================
 
+PyObject * DataStorePythonWrapper::arrays(DataStore *pDataStore,
+                                          const QStringList &pUris,
+                                          int pRun) const
+{
+    // Return, as a Python dictionary, NumPy arrays for the VOI and (given)
+    // variables in the given data store and for the given run, all of them
+    // aliasing our data store (i.e. no data gets copied)
+
+    return dataStoreVariablesArraysDict(pDataStore->voiAndVariables(), pUris, pRun);
+}
+
+//==============================================================================
+
+PyObject * DataStorePythonWrapper::runs_arrays(DataStore *pDataStore,
+                                               const QStringList &pUris) const
+{
+    // Return, as a Python dictionary, lists of NumPy arrays (one per run) for
+    // the VOI and (given) variables in the given data store, all of them
+    // aliasing our data store (i.e. no data gets copied)
+
+    return dataStoreVariablesRunsArraysDict(pDataStore->voiAndVariables(), pUris);
+}
+
+//==============================================================================
+
+void DataStorePythonWrapper::export_data(DataStore *pDataStore,
+                                         const QString &pFileName,
+                                         const QString &pDataStoreName) const
+{
+    // Export the VOI and variables in the given data store to the given file,
+    // using the given type of data store, and wait for the export to be done
+
+    DataStoreInterface *dataStoreInterface = nullptr;
+
+    for (auto crtDataStoreInterface : Core::dataStoreInterfaces()) {
+        if (crtDataStoreInterface->dataStoreName() == pDataStoreName) {
+            dataStoreInterface = crtDataStoreInterface;
+
+            break;
+        }
+    }
+
+    if (dataStoreInterface == nullptr) {
+        throw std::runtime_error(tr("The requested data store (%1) could not be found.").arg(pDataStoreName).toStdString());
+    }
+
+    DataStoreExporter *dataStoreExporter = dataStoreInterface->dataStoreExporterInstance();
+    DataStoreExportData dataStoreExportData(pFileName, pDataStore, pDataStore->voiAndVariables());
+    QEventLoop waitLoop;
+    QString errorMessage;
+
+    connect(dataStoreExporter, &DataStoreExporter::done,
+            &waitLoop, [&](DataStoreExportData *pDataStoreData,
+                           const QString &pErrorMessage) {
+        if (pDataStoreData == &dataStoreExportData) {
+            errorMessage = pErrorMessage;
+
+            waitLoop.quit();
+        }
+    });
+
+    // Export our data and wait for it to be done
+    // Note: our exporter's done() signal is emitted through a queued
+    //       connection, so it can only be handled once our wait loop is
+    //       running...
+
+    dataStoreExporter->exportData(&dataStoreExportData);
+
+    waitLoop.exec();
+
+    if (!errorMessage.isEmpty()) {
+        throw std::runtime_error(errorMessage.toStdString());
+    }
+}
+
+//==============================================================================
+
 NumPyPythonWrapper::NumPyPythonWrapper(DataStoreArray *pDataStoreArray,
                                        quint64 pSize) :
     mArray(pDataStoreArray)
@@ -32,6 +32,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 //==============================================================================
 
 #include <QObject>
+#include <QStringList>
 
 //==============================================================================
 
@@ -56,6 +57,11 @@ public:
     static DATASTORE_EXPORT PyObject * dataStoreValuesDict(const DataStoreValues *pDataStoreValues,
                                                            SimulationSupport::SimulationDataUpdatedFunction *pSimulationDataUpdatedFunction);
     static DATASTORE_EXPORT PyObject * dataStoreVariablesDict(const DataStoreVariables &pDataStoreVariables);
+    static DATASTORE_EXPORT PyObject * dataStoreVariablesArraysDict(const DataStoreVariables &pDataStoreVariables,
+                                                                    const QStringList &pUris,
+                                                                    int pRun);
+    static DATASTORE_EXPORT PyObject * dataStoreVariablesRunsArraysDict(const DataStoreVariables &pDataStoreVariables,
+                                                                        const QStringList &pUris);
 
 public slots:
     PyObject * variables(OpenCOR::DataStore::DataStore *pDataStore);
@@ -65,6 +71,16 @@ public slots:
                  quint64 pPosition, int pRun = -1) const;
     PyObject * values(OpenCOR::DataStore::DataStoreVariable *pDataStoreVariable,
                       int pRun = -1) const;
+
+    PyObject * arrays(OpenCOR::DataStore::DataStore *pDataStore,
+                      const QStringList &pUris = QStringList(),
+                      int pRun = -1) const;
+    PyObject * runs_arrays(OpenCOR::DataStore::DataStore *pDataStore,
+                           const QStringList &pUris = QStringList()) const;
+
+    void export_data(OpenCOR::DataStore::DataStore *pDataStore,
+                     const QString &pFileName,
+                     const QString &pDataStoreName = "CSV") const;
 };
 
 //==============================================================================
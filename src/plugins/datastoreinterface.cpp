@@ -43,7 +43,7 @@ extern "C" Q_DECL_EXPORT int dataStoreInterfaceVersion()
 {
     // Version of the data store interface
 
-    return 5;
+    return 6;
 }
 
 //==============================================================================
@@ -125,7 +125,8 @@ void DataStoreArray::release()
 
 //==============================================================================
 
-DataStoreValue::DataStoreValue(double *pValue) :
+DataStoreValue::DataStoreValue(double *pValue, const QString &pUri) :
+    mUri(pUri),
     mValue(pValue)
 {
 }
@@ -141,15 +142,6 @@ QString DataStoreValue::uri() const
 
 //==============================================================================
 
-void DataStoreValue::setUri(const QString &pUri)
-{
-    // Set our URI
-
-    mUri = pUri;
-}
-
-//==============================================================================
-
 double DataStoreValue::value() const
 {
     // Return our value
@@ -174,30 +166,94 @@ void DataStoreValue::setValue(double pValue)
 
 //==============================================================================
 
-DataStoreValues::DataStoreValues(DataStoreArray *pDataStoreArray)
+DataStoreValues::DataStoreValues(DataStoreArray *pDataStoreArray,
+                                 const QStringList &pUris) :
+    mArray(pDataStoreArray),
+    mUris(pUris)
 {
-    // Create a list of DataStoreValue objects
+}
 
-    double *data = pDataStoreArray->data();
+//==============================================================================
 
-    for (quint64 i = 0, iMax = pDataStoreArray->size(); i < iMax; ++i) {
-        *this << new DataStoreValue(data);
+DataStoreValues::~DataStoreValues()
+{
+    // Delete our DataStoreValue objects, if any
 
-        ++data;
+    for (auto valueObject : mValueObjects) {
+        delete valueObject;
     }
 }
 
 //==============================================================================
 
-DataStoreValues::~DataStoreValues()
+int DataStoreValues::size() const
+{
+    // Return our size
+
+    return int(mArray->size());
+}
+
+//==============================================================================
+
+QStringList DataStoreValues::uris() const
+{
+    // Return our URIs
+
+    return mUris;
+}
+
+//==============================================================================
+
+QString DataStoreValues::uri(int pIndex) const
+{
+    // Return the URI of the value at the given index, if any
+
+    return mUris.value(pIndex);
+}
+
+//==============================================================================
+
+double DataStoreValues::value(int pIndex) const
+{
+    // Return the value at the given index
+
+    return mArray->data(quint64(pIndex));
+}
+
+//==============================================================================
+
+void DataStoreValues::setValue(int pIndex, double pValue)
 {
-    // Delete our DataStoreValue objects
+    // Set the value at the given index
+
+    if ((pIndex >= 0) && (quint64(pIndex) < mArray->size())) {
+        mArray->data()[pIndex] = pValue;
+    }
+}
+
+//==============================================================================
+
+DataStoreValue * DataStoreValues::valueObject(int pIndex) const
+{
+    // Return a DataStoreValue object for the value at the given index, creating
+    // it if needed
+
+    if ((pIndex < 0) || (quint64(pIndex) >= mArray->size())) {
+        return nullptr;
+    }
+
+    if (mValueObjects.isEmpty()) {
+        mValueObjects.fill(nullptr, size());
+    }
+
+    DataStoreValue *res = mValueObjects[pIndex];
 
-    for (DataStoreValue *dataStoreValue : *this) {
-        delete dataStoreValue;
+    if (res == nullptr) {
+        res = mValueObjects[pIndex] = new DataStoreValue(mArray->data()+pIndex,
+                                                         mUris.value(pIndex));
     }
 
-    clear();
+    return res;
 }
 
 //==============================================================================
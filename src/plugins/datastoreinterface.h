@@ -26,6 +26,8 @@ along with this program. If not, see <https://gnu.org/licenses>.
 //==============================================================================
 
 #include <QObject>
+#include <QStringList>
+#include <QVector>
 
 //==============================================================================
 
@@ -63,9 +65,8 @@ class DataStoreValue : public QObject
     Q_OBJECT
 
 public:
-    explicit DataStoreValue(double *pValue = nullptr);
-
-    void setUri(const QString &pUri);
+    explicit DataStoreValue(double *pValue = nullptr,
+                            const QString &pUri = QString());
 
 public slots:
     QString uri() const;
@@ -80,12 +81,35 @@ private:
 };
 
 //==============================================================================
+// Note: DataStoreValues is a lightweight, indexed view of a DataStoreArray. Its
+//       index-to-URI table is a QStringList, meaning that it gets implicitly
+//       shared with whoever else uses it (e.g. the variables of a data store).
+//       A DataStoreValue object is only created (and then cached) for a given
+//       value if it is needed (e.g. by our scripting layer)...
 
-class DataStoreValues : public QList<DataStoreValue *>
+class DataStoreValues
 {
 public:
-    explicit DataStoreValues(DataStoreArray *pDataStoreArray);
+    explicit DataStoreValues(DataStoreArray *pDataStoreArray,
+                             const QStringList &pUris = {});
     ~DataStoreValues();
+
+    int size() const;
+
+    QStringList uris() const;
+    QString uri(int pIndex) const;
+
+    double value(int pIndex) const;
+    void setValue(int pIndex, double pValue);
+
+    DataStoreValue * valueObject(int pIndex) const;
+
+private:
+    DataStoreArray *mArray;
+
+    QStringList mUris;
+
+    mutable QVector<DataStoreValue *> mValueObjects;
 };
 
 //==============================================================================
@@ -130,6 +130,63 @@ QFont CellmlTextViewLexer::font(int pStyle) const
 
 //==============================================================================
 
+void CellmlTextViewLexer::setEditor(QsciScintilla *pEditor)
+{
+    // Let our parent know about our new editor
+
+    QsciLexerCustom::setEditor(pEditor);
+
+    // Keep track of the modifications made to our editor's text, so that we
+    // don't have to retrieve the whole of it each time we need to style some
+    // of it
+
+    disconnect(mModifiedConnection);
+
+    if (pEditor != nullptr) {
+        mFullText = pEditor->text().toUtf8();
+
+        mModifiedConnection = connect(pEditor, &QsciScintilla::SCN_MODIFIED,
+                                      this, [=](int pPosition, int pModificationType,
+                                                const char *pText, int pLength,
+                                                int, int, int, int, int, int) {
+            textModified(pPosition, pModificationType, pText, pLength);
+        });
+    } else {
+        mFullText = QByteArray();
+    }
+}
+
+//==============================================================================
+
+void CellmlTextViewLexer::textModified(int pPosition, int pModificationType,
+                                       const char *pText, int pLength)
+{
+    // Update our copy of our editor's text
+    // Note: Scintilla positions are byte positions in our UTF-8 text, hence we
+    //       can use them as is...
+
+    if ((pModificationType & QsciScintilla::SC_MOD_INSERTTEXT) != 0) {
+        mFullText.insert(pPosition, pText, pLength);
+    } else if ((pModificationType & QsciScintilla::SC_MOD_DELETETEXT) != 0) {
+        mFullText.remove(pPosition, pLength);
+    } else {
+        return;
+    }
+
+    // Forget about the previous strings that we found from a position that is
+    // now affected by the modification
+
+    for (auto iter = mPreviousStrings.begin(); iter != mPreviousStrings.end();) {
+        if (iter.value().first >= pPosition) {
+            iter = mPreviousStrings.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+//==============================================================================
+
 static const int StyleChunk = 32768;
 
 //==============================================================================
@@ -145,8 +202,15 @@ void CellmlTextViewLexer::styleText(int pStart, int pEnd)
 #endif
 
     // Keep track of some information
+    // Note: our copy of our editor's text should always be up to date (see
+    //       textModified()), but better be safe than sorry...
+
+    if (mFullText.length() != editor()->SendScintilla(QsciScintilla::SCI_GETLENGTH)) {
+        mFullText = editor()->text().toUtf8();
+
+        mPreviousStrings.clear();
+    }
 
-    mFullText = editor()->text().toUtf8();
     mEolString = qobject_cast<QScintillaWidget::QScintillaWidget *>(editor())->eolString();
 
     // Style the text in small chunks (to reduce memory usage, which can quickly
@@ -161,18 +225,13 @@ void CellmlTextViewLexer::styleText(int pStart, int pEnd)
 
         end = qMin(start+StyleChunk, pEnd);
 
-        applyStyle(start, end, Style::Default);
-
-        // Retrieve the chunk of text to style and style it
+        mChunkStart = start;
 
-        auto data = new char[end-start+1] {};
-
-        editor()->SendScintilla(QsciScintilla::SCI_GETTEXTRANGE,
-                                start, end, data);
+        applyStyle(start, end, Style::Default);
 
-        styleText(start, end, data, false);
+        // Style our chunk of text
 
-        delete[] data;
+        styleText(start, end, mFullText.mid(start, end-start), false);
 
 #ifdef QT_DEBUG
         // Make sure that the end position of the last bit of chunk of text that
@@ -821,15 +880,59 @@ bool CellmlTextViewLexer::validString(int pFrom, int pTo, Style pStyle) const
 int CellmlTextViewLexer::findString(const QByteArray &pString, int pFrom,
                                     Style pStyle, bool pForward)
 {
-    // Find forward/backward the given string starting from the given position
+    // Find backward the given string starting from the given position, but only
+    // down to the position from which we last found it
+    // Note: the text before our current chunk of text has already been styled,
+    //       so the result of a backward search within it remains valid until
+    //       our text gets modified (see textModified()). This means that we
+    //       don't need to go through the whole of our text each time we need
+    //       to know whether a /* XXX */ comment or a parameter block started
+    //       before a given position...
 
     int stringLength = pString.length();
-    int res = pForward?pFrom:pFrom+1;
+
+    if (!pForward) {
+        int previousFrom = -1;
+        int previousRes = -1;
+        auto previousString = mPreviousStrings.constFind(pString);
+
+        if (   (previousString != mPreviousStrings.constEnd())
+            && (previousString.value().first <= pFrom)) {
+            previousFrom = previousString.value().first;
+            previousRes = previousString.value().second;
+        }
+
+        const char *fullText = mFullText.constData();
+        const char *string = pString.constData();
+        int res = qMin(pFrom, mFullText.length()-stringLength);
+
+        while (   (res > previousFrom)
+               && (   (qstrncmp(fullText+res, string, uint(stringLength)) != 0)
+                   || !validString(res, res+stringLength, pStyle))) {
+            --res;
+        }
+
+        if (res <= previousFrom) {
+            res = previousRes;
+        }
+
+        int styledFrom = qMin(pFrom, mChunkStart-1);
+
+        if ((styledFrom >= 0) && (res <= styledFrom)) {
+            mPreviousStrings.insert(pString, qMakePair(styledFrom, res));
+        }
+
+        return res;
+    }
+
+    // Find forward the given string starting from the given position
+
+    int res = pFrom;
 
     do {
-        pFrom = pForward?res+stringLength:res-1;
+        pFrom = res+stringLength;
 
-        res = pForward?mFullText.indexOf(pString, pFrom):mFullText.lastIndexOf(pString, pFrom);
+        res = mFullText.indexOf(pString, pFrom);
     } while ((res != -1) && !validString(res, res+stringLength, pStyle));
 
     return res;
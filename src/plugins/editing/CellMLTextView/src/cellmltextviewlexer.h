@@ -25,6 +25,8 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QHash>
+#include <QPair>
 #include <QRegularExpression>
 
 //==============================================================================
@@ -69,12 +71,22 @@ public:
     QColor color(int pStyle) const override;
     QFont font(int pStyle) const override;
 
+    void setEditor(QsciScintilla *pEditor) override;
+
     void styleText(int pStart, int pEnd) override;
 
 private:
     QByteArray mFullText;
     QByteArray mEolString;
 
+    QMetaObject::Connection mModifiedConnection;
+
+    int mChunkStart = 0;
+    QHash<QByteArray, QPair<int, int>> mPreviousStrings;
+
+    void textModified(int pPosition, int pModificationType, const char *pText,
+                      int pLength);
+
     void applyStyle(int pStart, int pEnd, Style pStyle);
     void styleText(int pStart, int pEnd, const QByteArray &pText,
                    bool pParameterBlock);
@@ -766,18 +766,11 @@ bool CellmlTextViewParser::identifierOrSiUnitToken(QDomNode &pDomNode)
 {
     // Expect an identifier or an SI unit
 
-    static CellmlTextViewScanner::Tokens tokens;
-    static bool needInitializeTokens = true;
-
-    if (needInitializeTokens) {
-        tokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstUnit,
-                               CellmlTextViewScanner::Token::LastUnit) << CellmlTextViewScanner::Token::IdentifierOrCmetaId;
-
-        needInitializeTokens = false;
-    }
+    static const CellmlTextViewScanner::Tokens Tokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstUnit,
+                                                                      CellmlTextViewScanner::Token::LastUnit) << CellmlTextViewScanner::Token::IdentifierOrCmetaId;
 
     return tokenType(pDomNode, tr("An identifier or an SI unit (e.g. 'second')"),
-                     tokens);
+                     Tokens);
 }
 
 //==============================================================================
@@ -1570,18 +1563,11 @@ bool CellmlTextViewParser::parseUnitDefinition(QDomNode &pDomNode)
 
                     // Expect a number or a prefix
 
-                    static CellmlTextViewScanner::Tokens tokens;
-                    static bool needInitializeTokens = true;
-
-                    if (needInitializeTokens) {
-                        tokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstPrefix,
-                                               CellmlTextViewScanner::Token::LastPrefix) << CellmlTextViewScanner::Token::Number;
-
-                        needInitializeTokens = false;
-                    }
+                    static const CellmlTextViewScanner::Tokens Tokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstPrefix,
+                                                                                      CellmlTextViewScanner::Token::LastPrefix) << CellmlTextViewScanner::Token::Number;
 
                     if (!tokenType(unitElement, tr("A number or a prefix (e.g. 'milli')"),
-                                   tokens)) {
+                                   Tokens)) {
                         return false;
                     }
                 }
@@ -3163,27 +3149,16 @@ QDomElement CellmlTextViewParser::parseNormalMathematicalExpression9(QDomNode &p
 
     QDomElement res;
 
-    static CellmlTextViewScanner::Tokens mahematicalConstantTokens;
-    static CellmlTextViewScanner::Tokens oneArgumentMathematicalFunctionTokens;
-    static CellmlTextViewScanner::Tokens oneOrTwoArgumentMathematicalFunctionTokens;
-    static CellmlTextViewScanner::Tokens twoArgumentMathematicalFunctionTokens;
-    static CellmlTextViewScanner::Tokens twoOrMoreArgumentMathematicalFunctionTokens;
-    static bool needInitializeTokens = true;
-
-    if (needInitializeTokens) {
-        mahematicalConstantTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstMathematicalConstant,
-                                                  CellmlTextViewScanner::Token::LastMathematicalConstant);
-        oneArgumentMathematicalFunctionTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstOneArgumentMathematicalFunction,
-                                                              CellmlTextViewScanner::Token::LastOneArgumentMathematicalFunction);
-        oneOrTwoArgumentMathematicalFunctionTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstOneOrTwoArgumentMathematicalFunction,
-                                                                   CellmlTextViewScanner::Token::LastOneOrTwoArgumentMathematicalFunction);
-        twoArgumentMathematicalFunctionTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstTwoArgumentMathematicalFunction,
-                                                              CellmlTextViewScanner::Token::LastTwoArgumentMathematicalFunction);
-        twoOrMoreArgumentMathematicalFunctionTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstTwoOrMoreArgumentMathematicalFunction,
-                                                                    CellmlTextViewScanner::Token::LastTwoOrMoreArgumentMathematicalFunction);
-
-        needInitializeTokens = false;
-    }
+    static const CellmlTextViewScanner::Tokens MathematicalConstantTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstMathematicalConstant,
+                                                                                          CellmlTextViewScanner::Token::LastMathematicalConstant);
+    static const CellmlTextViewScanner::Tokens OneArgumentMathematicalFunctionTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstOneArgumentMathematicalFunction,
+                                                                                                     CellmlTextViewScanner::Token::LastOneArgumentMathematicalFunction);
+    static const CellmlTextViewScanner::Tokens OneOrTwoArgumentMathematicalFunctionTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstOneOrTwoArgumentMathematicalFunction,
+                                                                                                          CellmlTextViewScanner::Token::LastOneOrTwoArgumentMathematicalFunction);
+    static const CellmlTextViewScanner::Tokens TwoArgumentMathematicalFunctionTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstTwoArgumentMathematicalFunction,
+                                                                                                     CellmlTextViewScanner::Token::LastTwoArgumentMathematicalFunction);
+    static const CellmlTextViewScanner::Tokens TwoOrMoreArgumentMathematicalFunctionTokens = rangeOfTokens(CellmlTextViewScanner::Token::FirstTwoOrMoreArgumentMathematicalFunction,
+                                                                                                           CellmlTextViewScanner::Token::LastTwoOrMoreArgumentMathematicalFunction);
 
     if (mScanner.token() == CellmlTextViewScanner::Token::IdentifierOrCmetaId) {
         // Create an identifier element
@@ -3197,23 +3172,23 @@ QDomElement CellmlTextViewParser::parseNormalMathematicalExpression9(QDomNode &p
         // Try to parse a number
 
         res = parseNumber(pDomNode);
-    } else if (mahematicalConstantTokens.contains(mScanner.token())) {
+    } else if (MathematicalConstantTokens.contains(mScanner.token())) {
         // Create a mathematical constant element
 
         res = newMathematicalConstantElement(mScanner.token());
-    } else if (oneArgumentMathematicalFunctionTokens.contains(mScanner.token())) {
+    } else if (OneArgumentMathematicalFunctionTokens.contains(mScanner.token())) {
         // Try to parse a one-argument mathematical function
 
         res = parseMathematicalFunction(pDomNode, true, false, false);
-    } else if (oneOrTwoArgumentMathematicalFunctionTokens.contains(mScanner.token())) {
+    } else if (OneOrTwoArgumentMathematicalFunctionTokens.contains(mScanner.token())) {
         // Try to parse a one- or two-argument mathematical function
 
         res = parseMathematicalFunction(pDomNode, true, true, false);
-    } else if (twoArgumentMathematicalFunctionTokens.contains(mScanner.token())) {
+    } else if (TwoArgumentMathematicalFunctionTokens.contains(mScanner.token())) {
         // Try to parse a two-argument mathematical function
 
         res = parseMathematicalFunction(pDomNode, false, true, false);
-    } else if (twoOrMoreArgumentMathematicalFunctionTokens.contains(mScanner.token())) {
+    } else if (TwoOrMoreArgumentMathematicalFunctionTokens.contains(mScanner.token())) {
         // Try to parse a two-or-more argument mathematical function
 
         res = parseMathematicalFunction(pDomNode, false, true, true);
@@ -60,6 +60,81 @@ namespace CellMLTextView {
 
 //==============================================================================
 
+CellmlTextViewWidgetParsingWorker::CellmlTextViewWidgetParsingWorker(const QString &pCellmlText,
+                                                                     CellMLSupport::CellmlFile::Version pCellmlVersion,
+                                                                     QObject *pParent) :
+    QObject(pParent),
+    mCellmlText(pCellmlText),
+    mCellmlVersion(pCellmlVersion)
+{
+    // We are managed by our parent, not by the thread pool that runs us
+
+    setAutoDelete(false);
+}
+
+//==============================================================================
+
+void CellmlTextViewWidgetParsingWorker::run()
+{
+    // Parse our snapshot of the CellML text and let people know that we are
+    // done
+    // Note: we only ever access our snapshot and our own parser, so nothing
+    //       needs to be locked...
+
+    mResult = mParser.execute(mCellmlText, mCellmlVersion);
+
+    emit done();
+}
+
+//==============================================================================
+
+QString CellmlTextViewWidgetParsingWorker::cellmlText() const
+{
+    // Return the CellML text that we parse
+
+    return mCellmlText;
+}
+
+//==============================================================================
+
+CellMLSupport::CellmlFile::Version CellmlTextViewWidgetParsingWorker::cellmlVersion() const
+{
+    // Return the CellML version that we parse against
+
+    return mCellmlVersion;
+}
+
+//==============================================================================
+
+bool CellmlTextViewWidgetParsingWorker::isFor(const QString &pCellmlText,
+                                              CellMLSupport::CellmlFile::Version pCellmlVersion) const
+{
+    // Return whether we parse the given CellML text against the given CellML
+    // version
+
+    return (mCellmlVersion == pCellmlVersion) && (mCellmlText == pCellmlText);
+}
+
+//==============================================================================
+
+bool CellmlTextViewWidgetParsingWorker::result() const
+{
+    // Return whether our parsing was successful
+
+    return mResult;
+}
+
+//==============================================================================
+
+CellmlTextViewParser * CellmlTextViewWidgetParsingWorker::parser()
+{
+    // Return our parser
+
+    return &mParser;
+}
+
+//==============================================================================
+
 CellmlTextViewWidgetData::CellmlTextViewWidgetData(CellmlTextViewWidgetEditingWidget *pEditingWidget,
                                                    const QString &pSha1,
                                                    bool pValid,
@@ -80,8 +155,11 @@ CellmlTextViewWidgetData::CellmlTextViewWidgetData(CellmlTextViewWidgetEditingWi
 CellmlTextViewWidgetData::~CellmlTextViewWidgetData()
 {
     // Delete some internal objects
+    // Note: our running parsing worker, if any, cannot be deleted while it is
+    //       running, so it gets deleted by CellmlTextViewWidget once done...
 
     delete mEditingWidget;
+    delete mParsingWorker;
 }
 
 //==============================================================================
@@ -203,6 +281,67 @@ void CellmlTextViewWidgetData::setConvertedFileContents(const QString &pConverte
 
 //==============================================================================
 
+CellmlTextViewWidgetParsingWorker * CellmlTextViewWidgetData::parsingWorker() const
+{
+    // Return our (last completed) parsing worker
+
+    return mParsingWorker;
+}
+
+//==============================================================================
+
+void CellmlTextViewWidgetData::setParsingWorker(CellmlTextViewWidgetParsingWorker *pParsingWorker)
+{
+    // Set our (last completed) parsing worker, deleting our previous one, if
+    // any
+
+    if (pParsingWorker != mParsingWorker) {
+        delete mParsingWorker;
+
+        mParsingWorker = pParsingWorker;
+    }
+}
+
+//==============================================================================
+
+bool CellmlTextViewWidgetData::updateParsingWorker(CellmlTextViewWidgetParsingWorker *pParsingWorker,
+                                                   const QString &pCellmlText)
+{
+    // Set our (last completed) parsing worker to the given one, unless it is
+    // stale, i.e. unless our current one is for the given CellML text (i.e. the
+    // current contents of our editor) while the given one is not
+
+    if (   (mParsingWorker != nullptr)
+        && mParsingWorker->isFor(pCellmlText, mCellmlVersion)
+        && !pParsingWorker->isFor(pCellmlText, mCellmlVersion)) {
+        return false;
+    }
+
+    setParsingWorker(pParsingWorker);
+
+    return true;
+}
+
+//==============================================================================
+
+CellmlTextViewWidgetParsingWorker * CellmlTextViewWidgetData::runningParsingWorker() const
+{
+    // Return our running parsing worker
+
+    return mRunningParsingWorker;
+}
+
+//==============================================================================
+
+void CellmlTextViewWidgetData::setRunningParsingWorker(CellmlTextViewWidgetParsingWorker *pRunningParsingWorker)
+{
+    // Set our running parsing worker
+
+    mRunningParsingWorker = pRunningParsingWorker;
+}
+
+//==============================================================================
+
 CellmlTextViewWidgetEditingWidget::CellmlTextViewWidgetEditingWidget(const QString &pContents,
                                                                      bool pReadOnly,
                                                                      QsciLexer *pLexer,
@@ -417,6 +556,20 @@ CellmlTextViewWidget::CellmlTextViewWidget(QWidget *pParent) :
 
     connect(&mMathmlConverter, &Core::MathmlConverter::done,
             this, &CellmlTextViewWidget::mathmlConversionDone);
+
+    // Parse the contents of our current editor in the background, once the
+    // user has stopped typing for a bit, so that saving, reformatting and
+    // validating it can reuse the result of that parsing
+    // Note: we only need one thread since we only ever parse the contents of
+    //       one editor at a time...
+
+    mParsingThreadPool.setMaxThreadCount(1);
+
+    mParsingTimer.setSingleShot(true);
+    mParsingTimer.setInterval(500);
+
+    connect(&mParsingTimer, &QTimer::timeout,
+            this, &CellmlTextViewWidget::startBackgroundParsing);
 }
 
 //==============================================================================
@@ -518,6 +671,12 @@ void CellmlTextViewWidget::initialize(const QString &pFileName, bool pUpdate)
                     this, &CellmlTextViewWidget::updateViewer);
             connect(editingWidget->editorWidget(), &EditorWidget::EditorWidget::cursorPositionChanged,
                     this, &CellmlTextViewWidget::updateViewer);
+
+            // (Re)start our background parsing timer whenever the text has
+            // changed
+
+            connect(editingWidget->editorWidget(), &EditorWidget::EditorWidget::textChanged,
+                    &mParsingTimer, QOverload<>::of(&QTimer::start));
         } else {
             // The conversion wasn't successful, so make the editor read-only
             // (since its contents is that of the file itself) and add a couple
@@ -798,34 +957,44 @@ bool CellmlTextViewWidget::saveFile(const QString &pOldFileName,
         // that was in the original CellML file
 
         if (parse(pOldFileName)) {
+            // Retrieve the CellML version and (a copy of) the DOM document that
+            // our parser came up with
+            // Note: our parser may be that of a background parsing, which may
+            //       get reused or deleted while the user is being asked a
+            //       question below (since it runs its own event loop), hence we
+            //       retrieve what we need from our parser before anything
+            //       else...
+
+            CellMLSupport::CellmlFile::Version cellmlVersion = mFileParser->cellmlVersion();
+            QDomDocument domDocument = mFileParser->domDocument().cloneNode().toDocument();
+
             // Check whether we need a higher version of CellML to save the file
             // and, if so, ask the user whether it's OK to use that higher
             // version
 
             if (   (data->cellmlVersion() != CellMLSupport::CellmlFile::Version::Unknown)
-                && (mParser.cellmlVersion() > data->cellmlVersion())
+                && (cellmlVersion > data->cellmlVersion())
                 && (Core::questionMessageBox(tr("Save File"),
                                              tr("<strong>%1</strong> requires features that are not present in %2 and should therefore be saved as a %3 file. Do you want to proceed?").arg(QDir::toNativeSeparators(pNewFileName),
                                                                                                                                                                                             CellMLSupport::CellmlFile::versionAsString(data->cellmlVersion()),
-                                                                                                                                                                                            CellMLSupport::CellmlFile::versionAsString(mParser.cellmlVersion()))) == QMessageBox::No)) {
+                                                                                                                                                                                            CellMLSupport::CellmlFile::versionAsString(cellmlVersion))) == QMessageBox::No)) {
                 pNeedFeedback = false;
 
                 return false;
             }
 
-            data->setCellmlVersion(mParser.cellmlVersion());
+            data->setCellmlVersion(cellmlVersion);
 
             // Add the documentation, if any, to our model element
 
+            QDomElement domElement = domDocument.documentElement();
+
             if (!data->documentationNode().isNull()) {
-                mParser.modelElement().appendChild(data->documentationNode().cloneNode());
+                domElement.appendChild(data->documentationNode().cloneNode());
             }
 
             // Add the metadata to our DOM document
 
-            QDomDocument domDocument = mParser.domDocument();
-            QDomElement domElement = domDocument.documentElement();
-
             for (QDomElement childElement = data->rdfNodes().firstChildElement();
                  !childElement.isNull(); childElement = childElement.nextSiblingElement()) {
                 domElement.appendChild(childElement.cloneNode());
@@ -897,7 +1066,7 @@ void CellmlTextViewWidget::reformat(const QString &pFileName)
 
         editor->cursorPosition(line, column);
 
-        mConverter.execute(Core::serialiseDomDocument(mParser.domDocument()));
+        mConverter.execute(Core::serialiseDomDocument(mFileParser->domDocument()));
 
         editor->setContents(mConverter.output(), false);
         editor->setCursorPosition(line, column);
@@ -940,13 +1109,28 @@ bool CellmlTextViewWidget::parse(const QString &pFileName, QString &pExtra,
 
         editingWidget->editorListWidget()->clear();
 
-        bool res = mParser.execute(editingWidget->editorWidget()->contents(),
-                                   data->cellmlVersion());
+        // Reuse the result of our last background parsing, if it was for the
+        // current contents of our editor, or parse our editor's contents
+
+        QString contents = editingWidget->editorWidget()->contents();
+        CellmlTextViewWidgetParsingWorker *parsingWorker = data->parsingWorker();
+        bool res;
+
+        if (   (parsingWorker != nullptr)
+            && parsingWorker->isFor(contents, data->cellmlVersion())) {
+            mFileParser = parsingWorker->parser();
+
+            res = parsingWorker->result();
+        } else {
+            mFileParser = &mParser;
+
+            res = mParser.execute(contents, data->cellmlVersion());
+        }
 
         // Add the messages that were generated by the parser, if any, and
         // select the first one of them
 
-        for (const auto &message : mParser.messages()) {
+        for (const auto &message : mFileParser->messages()) {
             if (   !pOnlyErrors
                 || (message.type() == CellmlTextViewParserMessage::Type::Error)) {
                 editingWidget->editorListWidget()->addItem((message.type() == CellmlTextViewParserMessage::Type::Error)?
@@ -995,6 +1179,21 @@ bool CellmlTextViewWidget::parse(const QString &pFileName, bool pOnlyErrors)
 
 //==============================================================================
 
+CellmlTextViewWidgetData * CellmlTextViewWidget::currentData() const
+{
+    // Return the data associated with our current editing widget, if any
+
+    for (auto data : mData) {
+        if (data->editingWidget() == mEditingWidget) {
+            return data;
+        }
+    }
+
+    return nullptr;
+}
+
+//==============================================================================
+
 bool CellmlTextViewWidget::isComment(int pPosition) const
 {
     // Return whether we have a single or multiline comment at the given
@@ -1282,6 +1481,72 @@ void CellmlTextViewWidget::selectFirstItemInEditorList()
 
 //==============================================================================
 
+void CellmlTextViewWidget::startBackgroundParsing()
+{
+    // Make sure that we have a valid current editor
+
+    CellmlTextViewWidgetData *data = currentData();
+
+    if ((data == nullptr) || !data->isValid()) {
+        return;
+    }
+
+    // Try again later if our current editor is already being parsed
+
+    if (data->runningParsingWorker() != nullptr) {
+        mParsingTimer.start();
+
+        return;
+    }
+
+    // Parse a snapshot of the contents of our current editor in the
+    // background, unless it has already been parsed
+
+    QString contents = data->editingWidget()->editorWidget()->contents();
+    CellmlTextViewWidgetParsingWorker *parsingWorker = data->parsingWorker();
+
+    if (   (parsingWorker != nullptr)
+        && parsingWorker->isFor(contents, data->cellmlVersion())) {
+        return;
+    }
+
+    parsingWorker = new CellmlTextViewWidgetParsingWorker(contents, data->cellmlVersion(), this);
+
+    connect(parsingWorker, &CellmlTextViewWidgetParsingWorker::done,
+            this, &CellmlTextViewWidget::backgroundParsingDone);
+
+    data->setRunningParsingWorker(parsingWorker);
+
+    mParsingThreadPool.start(parsingWorker);
+}
+
+//==============================================================================
+
+void CellmlTextViewWidget::backgroundParsingDone()
+{
+    // A background parsing is done, so keep track of its result, should its
+    // file still be around and should it not be stale (see
+    // CellmlTextViewWidgetData::updateParsingWorker()), or get rid of it
+
+    auto parsingWorker = qobject_cast<CellmlTextViewWidgetParsingWorker *>(sender());
+
+    for (auto data : mData) {
+        if (data->runningParsingWorker() == parsingWorker) {
+            data->setRunningParsingWorker(nullptr);
+
+            if (data->updateParsingWorker(parsingWorker, data->editingWidget()->editorWidget()->contents())) {
+                return;
+            }
+
+            break;
+        }
+    }
+
+    parsingWorker->deleteLater();
+}
+
+//==============================================================================
+
 void CellmlTextViewWidget::mathmlConversionDone(const QString &pContentMathml,
                                                 const QString &pPresentationMathml)
 {
@@ -36,6 +36,9 @@ along with this program. If not, see <https://gnu.org/licenses>.
 //==============================================================================
 
 #include <QMap>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QTimer>
 
 //==============================================================================
 
@@ -64,6 +67,40 @@ class CellmlTextViewWidgetEditingWidget;
 
 //==============================================================================
 
+class CellmlTextViewWidgetParsingWorker : public QObject, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    explicit CellmlTextViewWidgetParsingWorker(const QString &pCellmlText,
+                                               CellMLSupport::CellmlFile::Version pCellmlVersion,
+                                               QObject *pParent);
+
+    void run() override;
+
+    QString cellmlText() const;
+    CellMLSupport::CellmlFile::Version cellmlVersion() const;
+
+    bool isFor(const QString &pCellmlText,
+               CellMLSupport::CellmlFile::Version pCellmlVersion) const;
+
+    bool result() const;
+    CellmlTextViewParser * parser();
+
+private:
+    QString mCellmlText;
+    CellMLSupport::CellmlFile::Version mCellmlVersion;
+
+    CellmlTextViewParser mParser;
+
+    bool mResult = false;
+
+signals:
+    void done();
+};
+
+//==============================================================================
+
 class CellmlTextViewWidgetData
 {
 public:
@@ -95,6 +132,14 @@ public:
     QString convertedFileContents() const;
     void setConvertedFileContents(const QString &pConvertedFileContents);
 
+    CellmlTextViewWidgetParsingWorker * parsingWorker() const;
+    void setParsingWorker(CellmlTextViewWidgetParsingWorker *pParsingWorker);
+    bool updateParsingWorker(CellmlTextViewWidgetParsingWorker *pParsingWorker,
+                             const QString &pCellmlText);
+
+    CellmlTextViewWidgetParsingWorker * runningParsingWorker() const;
+    void setRunningParsingWorker(CellmlTextViewWidgetParsingWorker *pRunningParsingWorker);
+
 private:
     CellmlTextViewWidgetEditingWidget *mEditingWidget;
     QString mSha1;
@@ -104,6 +149,9 @@ private:
     QDomDocument mRdfNodes;
     QString mFileContents;
     QString mConvertedFileContents;
+
+    CellmlTextViewWidgetParsingWorker *mParsingWorker = nullptr;
+    CellmlTextViewWidgetParsingWorker *mRunningParsingWorker = nullptr;
 };
 
 //==============================================================================
@@ -172,6 +220,10 @@ private:
 
     CellMLTextViewConverter mConverter;
     CellmlTextViewParser mParser;
+    CellmlTextViewParser *mFileParser = &mParser;
+
+    QThreadPool mParsingThreadPool;
+    QTimer mParsingTimer;
 
     QList<EditorWidget::EditorListWidget *> mEditorLists;
 
@@ -185,6 +237,8 @@ private:
     bool parse(const QString &pFileName, QString &pExtra);
     bool parse(const QString &pFileName, bool pOnlyErrors = false);
 
+    CellmlTextViewWidgetData * currentData() const;
+
     bool isComment(int pPosition) const;
 
     QString partialStatement(int pPosition, int &pFromPosition,
@@ -197,6 +251,9 @@ private slots:
 
     void selectFirstItemInEditorList();
 
+    void startBackgroundParsing();
+    void backgroundParsingDone();
+
     void mathmlConversionDone(const QString &pContentMathml,
                               const QString &pPresentationMathml);
 };
@@ -0,0 +1,144 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+
+//==============================================================================
+// CellML Text view background parsing tests
+//==============================================================================
+
+#include "../../../../tests/src/testsutils.h"
+
+//==============================================================================
+
+#include "backgroundparsingtests.h"
+#include "cellmlfile.h"
+#include "cellmltextviewparser.h"
+#include "cellmltextviewwidget.h"
+#include "corecliutils.h"
+
+//==============================================================================
+
+#include <QtTest/QtTest>
+
+//==============================================================================
+
+#include <QThreadPool>
+
+//==============================================================================
+
+static const auto Cellml_1_0 = OpenCOR::CellMLSupport::CellmlFile::Version::Cellml_1_0;
+static const auto Cellml_1_1 = OpenCOR::CellMLSupport::CellmlFile::Version::Cellml_1_1;
+
+//==============================================================================
+
+void BackgroundParsingTests::parsingWorkerTests()
+{
+    // Parse some CellML text in the background and check that we get the same
+    // result as when parsing it in the foreground
+
+    QString cellmlText = OpenCOR::fileContents(OpenCOR::fileName("src/plugins/editing/CellMLTextView/tests/data/parsing/my_model.in")).join('\n');
+    OpenCOR::CellMLTextView::CellmlTextViewWidgetParsingWorker parsingWorker(cellmlText, Cellml_1_0, nullptr);
+    QThreadPool threadPool;
+
+    threadPool.start(&parsingWorker);
+
+    QVERIFY(threadPool.waitForDone());
+
+    OpenCOR::CellMLTextView::CellmlTextViewParser parser;
+
+    QVERIFY(parser.execute(cellmlText, Cellml_1_0));
+    QVERIFY(parsingWorker.result());
+    QCOMPARE(OpenCOR::Core::serialiseDomDocument(parsingWorker.parser()->domDocument()),
+             OpenCOR::Core::serialiseDomDocument(parser.domDocument()));
+
+    // Check that our parsing worker only considers itself to be for the CellML
+    // text and version it was given
+
+    QVERIFY(parsingWorker.isFor(cellmlText, Cellml_1_0));
+    QVERIFY(!parsingWorker.isFor(cellmlText, Cellml_1_1));
+    QVERIFY(!parsingWorker.isFor(cellmlText+"\n", Cellml_1_0));
+
+    // Parse some invalid CellML text in the background and check that we get
+    // the same error as when parsing it in the foreground
+
+    OpenCOR::CellMLTextView::CellmlTextViewWidgetParsingWorker invalidParsingWorker("def model my_model as", Cellml_1_0, nullptr);
+
+    threadPool.start(&invalidParsingWorker);
+
+    QVERIFY(threadPool.waitForDone());
+
+    QVERIFY(!parser.execute("def model my_model as", Cellml_1_0));
+    QVERIFY(!invalidParsingWorker.result());
+    QCOMPARE(invalidParsingWorker.parser()->messages().first().message(),
+             parser.messages().first().message());
+}
+
+//==============================================================================
+
+void BackgroundParsingTests::parsingWorkerCacheTests()
+{
+    // Keep track of the result of a first background parsing
+
+    static const QString CellmlText1 = "def model my_model1 as\n"
+                                       "enddef;";
+    static const QString CellmlText2 = "def model my_model2 as\n"
+                                       "enddef;";
+    static const QString CellmlText3 = "def model my_model3 as\n"
+                                       "enddef;";
+
+    OpenCOR::CellMLTextView::CellmlTextViewWidgetData data(nullptr, {}, true,
+                                                           Cellml_1_0, {}, {});
+    auto parsingWorker1 = new OpenCOR::CellMLTextView::CellmlTextViewWidgetParsingWorker(CellmlText1, Cellml_1_0, nullptr);
+
+    QVERIFY(data.updateParsingWorker(parsingWorker1, CellmlText1));
+    QCOMPARE(data.parsingWorker(), parsingWorker1);
+
+    // A stale background parsing (i.e. one that was started for some CellML
+    // text that has since been reverted to the CellML text of our first
+    // background parsing) must not replace our first background parsing
+
+    auto parsingWorker2 = new OpenCOR::CellMLTextView::CellmlTextViewWidgetParsingWorker(CellmlText2, Cellml_1_0, nullptr);
+
+    QVERIFY(!data.updateParsingWorker(parsingWorker2, CellmlText1));
+    QCOMPARE(data.parsingWorker(), parsingWorker1);
+
+    delete parsingWorker2;
+
+    // A background parsing that is for the current CellML text or that
+    // replaces a background parsing that is not for the current CellML text
+    // anymore must replace our current background parsing
+
+    auto parsingWorker3 = new OpenCOR::CellMLTextView::CellmlTextViewWidgetParsingWorker(CellmlText3, Cellml_1_0, nullptr);
+
+    QVERIFY(data.updateParsingWorker(parsingWorker3, CellmlText3));
+    QCOMPARE(data.parsingWorker(), parsingWorker3);
+
+    auto parsingWorker4 = new OpenCOR::CellMLTextView::CellmlTextViewWidgetParsingWorker(CellmlText1, Cellml_1_0, nullptr);
+
+    QVERIFY(data.updateParsingWorker(parsingWorker4, CellmlText2));
+    QCOMPARE(data.parsingWorker(), parsingWorker4);
+}
+
+//==============================================================================
+
+QTEST_APPLESS_MAIN(BackgroundParsingTests)
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -30,6 +30,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 #include "compilerengine.h"
 #include "compilermath.h"
 #include "corecliutils.h"
+#include "tracer.h"
 
 //==============================================================================
 
@@ -100,6 +101,10 @@ inline std::string functionName(const char *pFunctionName)
 
 bool CompilerEngine::compileCode(const QString &pCode)
 {
+    // Trace ourselves
+
+    Core::TraceEvent traceEvent("CompilerEngine::compileCode");
+
     // Reset ourselves
 
     delete mExecutionEngine;
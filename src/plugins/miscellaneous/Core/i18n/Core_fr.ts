@@ -526,6 +526,10 @@
         <source>No Internet connection available.</source>
         <translation>Aucune connexion Internet disponible.</translation>
     </message>
+    <message>
+        <source>Too many redirections.</source>
+        <translation>Trop de redirections.</translation>
+    </message>
     <message>
         <source>Copyright</source>
         <translation>Tous droits réservés</translation>
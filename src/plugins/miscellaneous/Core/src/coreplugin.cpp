@@ -32,6 +32,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 #include "organisationwidget.h"
 #include "plugin.h"
 #include "solverinterface.h"
+#include "tracer.h"
 
 //==============================================================================
 
@@ -372,6 +373,14 @@ bool CorePlugin::pluginInterfacesOk(const QString &pFileName,
 
 void CorePlugin::initializePlugin()
 {
+    // Start tracing our simulation pipeline, if requested
+    // Note: this is done by setting the OPENCOR_TRACE environment variable to
+    //       the name of the file to which the trace is to be saved...
+
+    if (!Tracer::fileName().isEmpty()) {
+        Tracer::enable();
+    }
+
     // What we are doing below requires to be in GUI mode, so leave if we are
     // not in that mode
 
@@ -545,7 +554,11 @@ void CorePlugin::initializePlugin()
 
 void CorePlugin::finalizePlugin()
 {
-    // We don't handle this interface...
+    // Save our trace, if we were tracing our simulation pipeline
+
+    if (Tracer::isEnabled()) {
+        Tracer::save(Tracer::fileName());
+    }
 }
 
 //==============================================================================
@@ -590,9 +603,15 @@ void CorePlugin::pluginsInitialized(const Plugins &pLoadedPlugins)
     }
 
     // Keep track of our various interfaces
+    // Note: we may get called more than once in CLI mode, i.e. if some
+    //       deferred plugins got activated (see
+    //       PluginManager::activateDeferredPlugins()), hence we always update
+    //       our interfaces...
+
+    static InterfacesData data;
 
-    static InterfacesData data(fileTypeInterfaces, dataStoreFileTypeInterfaces,
-                               solverInterfaces, dataStoreInterfaces);
+    data = InterfacesData(fileTypeInterfaces, dataStoreFileTypeInterfaces,
+                          solverInterfaces, dataStoreInterfaces);
 
     globalInstance(InterfacesDataSignature, &data);
 
@@ -23,6 +23,13 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 #include "corecliutils.h"
 #include "interfaces.h"
+#include "pluginmanager.h"
+
+//==============================================================================
+
+#include <QCoreApplication>
+#include <QMutex>
+#include <QThread>
 
 //==============================================================================
 
@@ -100,7 +107,33 @@ FileTypeInterfaces dataStoreFileTypeInterfaces()
 
 SolverInterfaces solverInterfaces()
 {
-    // Return our solver interfaces
+    // Make sure that our solvers have been activated, if they were deferred
+    // (see PluginManager::PluginManager()), and return our solver interfaces
+    // Note #1: we may be called from different threads (e.g. by simulation
+    //          workers), hence we make sure that only one of them can activate
+    //          our solvers and that the others wait for it to be done...
+    // Note #2: activating our solvers means creating plugin objects, something
+    //          that must be done from the main thread, hence we ask the main
+    //          thread to do it if we are not on it. This requires the main
+    //          thread to process its events, which is why a simulation
+    //          activates our solvers upon its creation (see
+    //          Simulation::Simulation()), i.e. before any of its workers
+    //          needs them...
+
+    static QMutex deferredPluginsActivatorMutex;
+
+    deferredPluginsActivatorMutex.lock();
+        auto deferredPluginsActivator = reinterpret_cast<DeferredPluginsActivator>(globalInstance(DeferredPluginsActivatorSignature));
+
+        if (deferredPluginsActivator != nullptr) {
+            if (QThread::currentThread() == qApp->thread()) {
+                deferredPluginsActivator();
+            } else {
+                QMetaObject::invokeMethod(qApp, deferredPluginsActivator,
+                                          Qt::BlockingQueuedConnection);
+            }
+        }
+    deferredPluginsActivatorMutex.unlock();
 
     return static_cast<InterfacesData *>(globalInstance(InterfacesDataSignature))->solverInterfaces();
 }
@@ -44,6 +44,7 @@ static const auto InterfacesDataSignature = QStringLiteral("OpenCOR::Core::Inter
 class InterfacesData
 {
 public:
+    InterfacesData() = default;
     explicit InterfacesData(const FileTypeInterfaces &pFileTypeInterfaces,
                             const FileTypeInterfaces &pDataStoreFileTypeInterfaces,
                             const SolverInterfaces &pSolverInterfaces,
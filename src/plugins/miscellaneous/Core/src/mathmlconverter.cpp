@@ -27,11 +27,32 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QCache>
+
+//==============================================================================
+
 namespace OpenCOR {
 namespace Core {
 
 //==============================================================================
 
+static QCache<QString, QString> & presentationMathmlCache()
+{
+    // Return our cache of Presentation MathML, which is shared by all our
+    // MathML converters
+    // Note #1: QCache discards its least recently used items first...
+    // Note #2: the cost of an item is the number of characters in both its
+    //          Content MathML and its Presentation MathML (see
+    //          xslTransformationDone()), so our cache uses up to about 16 MB
+    //          no matter how big our equations are...
+
+    static QCache<QString, QString> cache(8*1024*1024);
+
+    return cache;
+}
+
+//==============================================================================
+
 MathmlConverter::MathmlConverter()
 {
     // Create our XSL transformer and create a connection to retrieve the result
@@ -56,6 +77,16 @@ MathmlConverter::~MathmlConverter()
 
 void MathmlConverter::convert(const QString &pContentMathml)
 {
+    // Check whether we have already converted the given Content MathML
+
+    QString *presentationMathml = presentationMathmlCache().object(pContentMathml);
+
+    if (presentationMathml != nullptr) {
+        emit done(pContentMathml, *presentationMathml);
+
+        return;
+    }
+
     // Convert the given Content MathML to Presentation MathML through an XSL
     // transformation
 
@@ -70,9 +101,16 @@ void MathmlConverter::xslTransformationDone(const QString &pInput,
                                             const QString &pOutput)
 {
     // Let people know that our MathML conversion is done (after having cleaned
-    // up its output)
+    // up its output and cached it)
+
+    QString presentationMathml = cleanPresentationMathml(pOutput);
+
+    if (!presentationMathml.isEmpty()) {
+        presentationMathmlCache().insert(pInput, new QString(presentationMathml),
+                                         pInput.size()+presentationMathml.size());
+    }
 
-    emit done(pInput, cleanPresentationMathml(pOutput));
+    emit done(pInput, presentationMathml);
 }
 
 //==============================================================================
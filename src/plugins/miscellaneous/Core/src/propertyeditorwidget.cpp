@@ -2349,15 +2349,16 @@ Property * PropertyEditorWidget::property(const QModelIndex &pIndex) const
         return nullptr;
     }
 
-    // Return our information about the property at the given index
+    // Return the owner of the item at the given index, which is necessarily
+    // one of our property items if the index belongs to our model
 
-    for (auto property : mAllProperties) {
-        if (property->hasIndex(pIndex)) {
-            return property;
-        }
+    if (pIndex.model() != mModel) {
+        return nullptr;
     }
 
-    return nullptr;
+    auto propertyItem = static_cast<PropertyItem *>(mModel->itemFromIndex(pIndex));
+
+    return (propertyItem != nullptr)?propertyItem->owner():nullptr;
 }
 
 //==============================================================================
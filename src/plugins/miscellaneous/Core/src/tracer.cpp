@@ -0,0 +1,259 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+//==============================================================================
+// Tracer
+//==============================================================================
+
+#include "corecliutils.h"
+#include "tracer.h"
+
+//==============================================================================
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+
+//==============================================================================
+
+#include <atomic>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace Core {
+
+//==============================================================================
+
+enum {
+    TracerChunkSize = 4096,
+    TracerMaximumChunksCount = 1024
+};
+
+//==============================================================================
+
+struct TracerEvent
+{
+    const char *name;
+    qint64 start;
+    qint64 duration;
+};
+
+//==============================================================================
+// Note: a buffer is only ever written to by the thread that owns it, but it may
+//       be read from another thread while being written to, hence we publish
+//       our chunks and number of events atomically. Also, a buffer is never
+//       deleted since its events must remain available after its thread has
+//       finished...
+
+struct TracerBuffer
+{
+    int threadId;
+    QString threadName;
+
+    std::atomic<TracerEvent *> chunks[TracerMaximumChunksCount] = {};
+    std::atomic<int> eventsCount = { 0 };
+};
+
+//==============================================================================
+
+static const char *TracerEnvironmentVariable = "OPENCOR_TRACE";
+
+static std::atomic<bool> tracerEnabled = { false };
+
+static QElapsedTimer tracerTimer;
+
+static QMutex tracerBuffersMutex;
+static QList<TracerBuffer *> tracerBuffers;
+
+static thread_local TracerBuffer *tracerBuffer = nullptr;
+
+//==============================================================================
+
+QString Tracer::fileName()
+{
+    // Return the name of the file to which our trace is to be saved, if any
+
+    return qEnvironmentVariable(TracerEnvironmentVariable);
+}
+
+//==============================================================================
+
+bool Tracer::isEnabled()
+{
+    // Return whether we are enabled
+
+    return tracerEnabled.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+
+void Tracer::enable()
+{
+    // Enable ourselves, if we are not already enabled
+
+    if (!isEnabled()) {
+        tracerTimer.start();
+
+        tracerEnabled.store(true);
+    }
+}
+
+//==============================================================================
+
+qint64 Tracer::now()
+{
+    // Return the time (in nanoseconds) since we were enabled
+
+    return tracerTimer.nsecsElapsed();
+}
+
+//==============================================================================
+
+void Tracer::addEvent(const char *pName, qint64 pStart, qint64 pEnd)
+{
+    // Retrieve (or create) the buffer for the current thread
+    // Note: creating a buffer is the only time we need to lock something, and
+    //       it only happens once per thread...
+
+    if (tracerBuffer == nullptr) {
+        auto buffer = new TracerBuffer();
+
+        tracerBuffersMutex.lock();
+            buffer->threadId = tracerBuffers.count()+1;
+            buffer->threadName = (QThread::currentThread() == qApp->thread())?
+                                     QString("Main thread"):
+                                     QThread::currentThread()->objectName();
+
+            if (buffer->threadName.isEmpty()) {
+                buffer->threadName = QString("Thread %1").arg(buffer->threadId);
+            }
+
+            tracerBuffers << buffer;
+        tracerBuffersMutex.unlock();
+
+        tracerBuffer = buffer;
+    }
+
+    // Add the event to our buffer, unless it is full
+
+    int eventsCount = tracerBuffer->eventsCount.load(std::memory_order_relaxed);
+    int chunkIndex = eventsCount/TracerChunkSize;
+
+    if (chunkIndex == TracerMaximumChunksCount) {
+        return;
+    }
+
+    TracerEvent *chunk = tracerBuffer->chunks[chunkIndex].load(std::memory_order_relaxed);
+
+    if (chunk == nullptr) {
+        chunk = new TracerEvent[TracerChunkSize];
+
+        tracerBuffer->chunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+
+    chunk[eventsCount%TracerChunkSize] = { pName, pStart, pEnd-pStart };
+
+    tracerBuffer->eventsCount.store(eventsCount+1, std::memory_order_release);
+}
+
+//==============================================================================
+
+bool Tracer::save(const QString &pFileName)
+{
+    // Save our events as a Chrome trace, which can be loaded in Chrome (through
+    // chrome://tracing) or in Perfetto (https://ui.perfetto.dev)
+    // Note #1: Chrome traces use microseconds...
+    // Note #2: we build our trace as a JSON document, so that the name of our
+    //          threads (which can be anything) gets properly escaped...
+
+    static const QString Name     = "name";
+    static const QString Phase    = "ph";
+    static const QString Pid      = "pid";
+    static const QString Tid      = "tid";
+    static const QString Category = "cat";
+    static const QString Start    = "ts";
+    static const QString Duration = "dur";
+    static const QString Args     = "args";
+
+    QJsonArray traceEvents;
+    qint64 processId = QCoreApplication::applicationPid();
+
+    tracerBuffersMutex.lock();
+        QList<TracerBuffer *> buffers = tracerBuffers;
+    tracerBuffersMutex.unlock();
+
+    for (auto buffer : buffers) {
+        traceEvents.append(QJsonObject({ { Name, "thread_name" },
+                                         { Phase, "M" },
+                                         { Pid, processId },
+                                         { Tid, buffer->threadId },
+                                         { Args, QJsonObject({ { Name, buffer->threadName } }) } }));
+
+        int eventsCount = buffer->eventsCount.load(std::memory_order_acquire);
+
+        for (int i = 0; i < eventsCount; ++i) {
+            const TracerEvent &event = buffer->chunks[i/TracerChunkSize].load(std::memory_order_acquire)[i%TracerChunkSize];
+
+            traceEvents.append(QJsonObject({ { Name, event.name },
+                                             { Category, "OpenCOR" },
+                                             { Phase, "X" },
+                                             { Pid, processId },
+                                             { Tid, buffer->threadId },
+                                             { Start, 0.001*event.start },
+                                             { Duration, 0.001*event.duration } }));
+        }
+    }
+
+    return writeFile(pFileName,
+                     QJsonDocument(QJsonObject({ { "traceEvents", traceEvents } })).toJson(QJsonDocument::Compact));
+}
+
+//==============================================================================
+
+TraceEvent::TraceEvent(const char *pName) :
+    mName(pName),
+    mStart(Tracer::isEnabled()?Tracer::now():-1)
+{
+}
+
+//==============================================================================
+
+TraceEvent::~TraceEvent()
+{
+    // Record ourselves, if we were started while tracing was enabled
+
+    if (mStart != -1) {
+        Tracer::addEvent(mName, mStart, Tracer::now());
+    }
+}
+
+//==============================================================================
+
+} // namespace Core
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
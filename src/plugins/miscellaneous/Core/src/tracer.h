@@ -0,0 +1,83 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+//==============================================================================
+// Tracer
+//==============================================================================
+
+#pragma once
+
+//==============================================================================
+
+#include "coreglobal.h"
+
+//==============================================================================
+
+#include <QString>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace Core {
+
+//==============================================================================
+// Note: events are recorded in a buffer that is specific to the thread in
+//       which they occur, so recording an event doesn't require any locking.
+//       The name of an event is expected to be a string literal since it is
+//       only resolved when saving our trace...
+
+class CORE_EXPORT Tracer
+{
+public:
+    static QString fileName();
+
+    static bool isEnabled();
+    static void enable();
+
+    static qint64 now();
+
+    static void addEvent(const char *pName, qint64 pStart, qint64 pEnd);
+
+    static bool save(const QString &pFileName);
+};
+
+//==============================================================================
+
+class CORE_EXPORT TraceEvent
+{
+public:
+    explicit TraceEvent(const char *pName);
+    ~TraceEvent();
+
+    TraceEvent(const TraceEvent &) = delete;
+    TraceEvent & operator=(const TraceEvent &) = delete;
+
+private:
+    const char *mName;
+    qint64 mStart;
+};
+
+//==============================================================================
+
+} // namespace Core
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -26,7 +26,10 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
-#include <QThread>
+#include <QCoreApplication>
+#include <QHash>
+#include <QThreadPool>
+#include <QThreadStorage>
 #include <QXmlQuery>
 
 //==============================================================================
@@ -36,35 +39,95 @@ namespace Core {
 
 //==============================================================================
 
+class XslTransformerQueries
+{
+public:
+    ~XslTransformerQueries();
+
+    QXmlQuery * query(const QString &pXsl);
+
+private:
+    DummyMessageHandler mDummyMessageHandler;
+
+    QHash<QString, QXmlQuery *> mQueries;
+};
+
+//==============================================================================
+
+XslTransformerQueries::~XslTransformerQueries()
+{
+    // Delete our XML query objects
+
+    for (auto query : mQueries) {
+        delete query;
+    }
+}
+
+//==============================================================================
+
+QXmlQuery * XslTransformerQueries::query(const QString &pXsl)
+{
+    // Return the XML query object for the given XSL, creating it if needed
+
+    QXmlQuery *res = mQueries.value(pXsl);
+
+    if (res == nullptr) {
+        res = new QXmlQuery(QXmlQuery::XSLT20);
+
+        res->setMessageHandler(&mDummyMessageHandler);
+
+        mQueries.insert(pXsl, res);
+    }
+
+    return res;
+}
+
+//==============================================================================
+
 XslTransformerWorker::XslTransformerWorker(const QString &pInput,
                                            const QString &pXsl) :
     mInput(pInput),
     mXsl(pXsl)
 {
+    // We get deleted once our done() signal has been handled
+
+    setAutoDelete(false);
 }
 
 //==============================================================================
 
 void XslTransformerWorker::run()
 {
-    // Create our XML query object
-
-    QXmlQuery xmlQuery(QXmlQuery::XSLT20);
-    DummyMessageHandler dummyMessageHandler;
+    // Retrieve the XML query object for our XSL
+    // Note: QXmlQuery is not thread-safe, so each thread of our thread pool has
+    //       its own XML query objects, which it keeps (together with their
+    //       compiled XSL) for as long as it lives...
 
-    xmlQuery.setMessageHandler(&dummyMessageHandler);
+    static QThreadStorage<XslTransformerQueries *> queries;
 
-    // Customise our XML query object
+    if (!queries.hasLocalData()) {
+        queries.setLocalData(new XslTransformerQueries());
+    }
 
-    xmlQuery.setFocus(mInput);
-    xmlQuery.setQuery(mXsl);
+    QXmlQuery *xmlQuery = queries.localData()->query(mXsl);
 
-    // Do the XSL transformation
+    // Customise our XML query object and do the XSL transformation
+    // Note #1: we only set our XSL once since setting it again would result in
+    //          it being recompiled...
+    // Note #2: our XML query object keeps its previous focus if our input
+    //          cannot be parsed, in which case we must not evaluate it since we
+    //          would otherwise get the output for a previous input...
 
     QString output;
 
-    if (!xmlQuery.evaluateTo(&output)) {
-        output = QString();
+    if (xmlQuery->setFocus(mInput)) {
+        if (!xmlQuery->isValid()) {
+            xmlQuery->setQuery(mXsl);
+        }
+
+        if (!xmlQuery->evaluateTo(&output)) {
+            output = QString();
+        }
     }
 
     // Let people know that our XSL transformation is done
@@ -76,29 +139,27 @@ void XslTransformerWorker::run()
 
 void XslTransformer::transform(const QString &pInput, const QString &pXsl)
 {
-    // Create and move our worker to a thread
+    // Run our worker using a thread pool that keeps its threads alive, so that
+    // its threads' XML query objects can be reused
+    // Note: our worker's done() signal gets handled in our thread, which is
+    //       where our worker lives and therefore where it gets deleted...
 
-    auto thread = new QThread();
-    auto worker = new XslTransformerWorker(pInput, pXsl);
+    static QThreadPool *threadPool = nullptr;
 
-    worker->moveToThread(thread);
+    if (threadPool == nullptr) {
+        threadPool = new QThreadPool(qApp);
 
-    connect(thread, &QThread::started,
-            worker, &XslTransformerWorker::run);
+        threadPool->setExpiryTimeout(-1);
+    }
+
+    auto worker = new XslTransformerWorker(pInput, pXsl);
 
     connect(worker, &XslTransformerWorker::done,
             this, &XslTransformer::done);
-    connect(worker, &XslTransformerWorker::done,
-            thread, &QThread::quit);
     connect(worker, &XslTransformerWorker::done,
             worker, &XslTransformerWorker::deleteLater);
 
-    connect(thread, &QThread::finished,
-            thread, &QThread::deleteLater);
-
-    // Start our worker by starting the thread in which it is
-
-    thread->start();
+    threadPool->start(worker);
 }
 
 //==============================================================================
@@ -29,11 +29,9 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
-#include <QList>
-#include <QMutex>
 #include <QObject>
+#include <QRunnable>
 #include <QString>
-#include <QWaitCondition>
 
 //==============================================================================
 
@@ -42,14 +40,14 @@ namespace Core {
 
 //==============================================================================
 
-class XslTransformerWorker : public QObject
+class XslTransformerWorker : public QObject, public QRunnable
 {
     Q_OBJECT
 
 public:
     explicit XslTransformerWorker(const QString &pInput, const QString &pXsl);
 
-    void run();
+    void run() override;
 
 private:
     QString mInput;
@@ -27,6 +27,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 #include "corecliutils.h"
 #include "mathmltests.h"
+#include "xsltransformer.h"
 
 //==============================================================================
 
@@ -284,6 +285,67 @@ void MathmlTests::trigonometricTests()
 
 //==============================================================================
 
+void MathmlTests::xslTransformerTests()
+{
+    // Make sure that our XSL transformer gives the correct output when used
+    // for successive transformations with different inputs and XSLs, i.e. that
+    // reusing the XML query objects of its threads doesn't result in a stale
+    // input or XSL being used
+    // Note: our transformations are done one after the other, so that they are
+    //       likely to be done by the same thread and therefore by the same XML
+    //       query objects...
+
+    static const QString RootElementXsl = "<xsl:stylesheet version=\"2.0\" xmlns:xsl=\"http://www.w3.org/1999/XSL/Transform\">"
+                                          "    <xsl:output method=\"text\"/>"
+                                          "    <xsl:template match=\"/\">"
+                                          "        <xsl:value-of select=\"local-name(*)\"/>"
+                                          "    </xsl:template>"
+                                          "</xsl:stylesheet>";
+
+    QString dirName = OpenCOR::dirName("src/plugins/miscellaneous/Core/tests/data")+"/";
+    const QStringList fileNames = { "plus/001.in", "abs/001.in", "plus/002.in",
+                                    "abs/001.in", "plus/001.in" };
+    OpenCOR::Core::XslTransformer xslTransformer;
+    QSignalSpy xslTransformerSpy(&xslTransformer, &OpenCOR::Core::XslTransformer::done);
+
+    for (const auto &fileName : fileNames) {
+        QString input = OpenCOR::rawFileContents(dirName+fileName);
+
+        // Convert our Content MathML to Presentation MathML
+
+        xslTransformer.transform(input, mQuery);
+
+        QVERIFY(xslTransformerSpy.wait());
+        QCOMPARE(xslTransformerSpy.count(), 1);
+        QCOMPARE(xslTransformerSpy.first().first().toString(), input);
+        QCOMPARE(OpenCOR::Core::formatXml(OpenCOR::Core::cleanPresentationMathml(xslTransformerSpy.first().last().toString())),
+                 OpenCOR::rawFileContents(QString(dirName+fileName).replace(".in", ".out")));
+
+        xslTransformerSpy.clear();
+
+        // Retrieve the name of the root element of our Content MathML
+
+        xslTransformer.transform(input, RootElementXsl);
+
+        QVERIFY(xslTransformerSpy.wait());
+        QCOMPARE(xslTransformerSpy.count(), 1);
+        QCOMPARE(xslTransformerSpy.first().last().toString().trimmed(), QString("math"));
+
+        xslTransformerSpy.clear();
+    }
+
+    // Make sure that an invalid input doesn't result in the output for a
+    // previous input
+
+    xslTransformer.transform("invalid input", mQuery);
+
+    QVERIFY(xslTransformerSpy.wait());
+    QCOMPARE(xslTransformerSpy.count(), 1);
+    QVERIFY(xslTransformerSpy.first().last().toString().isEmpty());
+}
+
+//==============================================================================
+
 QTEST_GUILESS_MAIN(MathmlTests)
 
 //==============================================================================
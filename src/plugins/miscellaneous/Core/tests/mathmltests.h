@@ -71,6 +71,8 @@ private slots:
     void lcmTests();
 
     void trigonometricTests();
+
+    void xslTransformerTests();
 };
 
 //==============================================================================
@@ -0,0 +1,134 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+//==============================================================================
+// Core tracer tests
+//==============================================================================
+
+#include "corecliutils.h"
+#include "tracer.h"
+#include "tracertests.h"
+
+//==============================================================================
+
+#include <QtTest/QtTest>
+
+//==============================================================================
+
+void TracerTests::tests()
+{
+    // Enable tracing and emit some events from our main thread and from
+    // several other threads, which names need to be escaped in JSON
+
+    static const int EventsCount = 10;
+    static const QStringList ThreadNames = { R"(Worker "1")",
+                                             R"(Worker \2\)",
+                                             "Worker\t3" };
+
+    OpenCOR::Core::Tracer::enable();
+
+    QVERIFY(OpenCOR::Core::Tracer::isEnabled());
+
+    for (int i = 0; i < EventsCount; ++i) {
+        OpenCOR::Core::TraceEvent traceEvent("TracerTests::mainThread");
+    }
+
+    QList<QThread *> threads;
+
+    for (const auto &threadName : ThreadNames) {
+        QThread *thread = QThread::create([]() {
+            for (int i = 0; i < EventsCount; ++i) {
+                OpenCOR::Core::TraceEvent traceEvent("TracerTests::otherThread");
+            }
+        });
+
+        thread->setObjectName(threadName);
+        thread->start();
+
+        threads << thread;
+    }
+
+    for (auto thread : threads) {
+        QVERIFY(thread->wait());
+    }
+
+    qDeleteAll(threads);
+
+    // Save our trace and make sure that it is a valid Chrome trace, i.e. a
+    // JSON document with a list of events
+
+    QTemporaryDir temporaryDir;
+    QString traceFileName = temporaryDir.path()+"/trace.json";
+
+    QVERIFY(OpenCOR::Core::Tracer::save(traceFileName));
+
+    QByteArray traceContents;
+
+    QVERIFY(OpenCOR::Core::readFile(traceFileName, traceContents));
+
+    QJsonParseError jsonParseError;
+    QJsonDocument jsonDocument = QJsonDocument::fromJson(traceContents, &jsonParseError);
+
+    QCOMPARE(jsonParseError.error, QJsonParseError::NoError);
+    QVERIFY(jsonDocument.isObject());
+    QVERIFY(jsonDocument.object().value("traceEvents").isArray());
+
+    // Make sure that each of our threads has a name and the events that it
+    // emitted
+
+    QMap<int, QString> threadNames;
+    QMap<int, int> threadEventsCount;
+
+    for (const auto &traceEvent : jsonDocument.object().value("traceEvents").toArray()) {
+        QJsonObject traceEventObject = traceEvent.toObject();
+        int threadId = traceEventObject.value("tid").toInt();
+        QString phase = traceEventObject.value("ph").toString();
+
+        QCOMPARE(traceEventObject.value("pid").toVariant().toLongLong(),
+                 QCoreApplication::applicationPid());
+
+        if (phase == "M") {
+            QCOMPARE(traceEventObject.value("name").toString(), QString("thread_name"));
+
+            threadNames.insert(threadId, traceEventObject.value("args").toObject().value("name").toString());
+        } else {
+            QCOMPARE(phase, QString("X"));
+            QVERIFY(traceEventObject.value("ts").toDouble() >= 0.0);
+            QVERIFY(traceEventObject.value("dur").toDouble() >= 0.0);
+
+            ++threadEventsCount[threadId];
+        }
+    }
+
+    QCOMPARE(threadNames.count(), ThreadNames.count()+1);
+    QCOMPARE(threadNames.values().toSet(),
+             (QStringList(ThreadNames) << "Main thread").toSet());
+
+    for (auto threadId : threadNames.keys()) {
+        QCOMPARE(threadEventsCount.value(threadId), EventsCount);
+    }
+}
+
+//==============================================================================
+
+QTEST_GUILESS_MAIN(TracerTests)
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -40,7 +40,7 @@ namespace OpenCOR {
 
 //==============================================================================
 
-PluginManager::PluginManager(bool pGuiMode) :
+PluginManager::PluginManager(bool pGuiMode, const QString &pCliPluginName) :
     mGuiMode(pGuiMode)
 {
     // Retrieve OpenCOR's plugins directory
@@ -110,9 +110,16 @@ PluginManager::PluginManager(bool pGuiMode) :
 
     // Determine which plugins, if any, are needed by others and which, if any,
     // are selectable
+    // Note: in CLI mode, if we have been given the name of the plugin to which
+    //       a command is to be sent, then we only want that plugin (and its
+    //       dependencies). Solvers, which are only ever accessed through
+    //       Core::solverInterfaces(), get deferred and will be activated the
+    //       first time they are needed (see activateDeferredPlugins())...
 
     QStringList neededPlugins;
     QStringList wantedPlugins;
+    QStringList deferredNeededPlugins;
+    QStringList deferredWantedPlugins;
 
     for (const auto &fileName : sortedFileNames) {
         QString pluginName = Plugin::name(fileName);
@@ -121,17 +128,28 @@ PluginManager::PluginManager(bool pGuiMode) :
         if (pluginInfo != nullptr) {
             // Keep track of the plugin itself, should it be selectable and
             // requested by the user (if we are in GUI mode), or have CLI
-            // support or is a solver (if we are in CLI mode)
+            // support or is a solver (if we are in CLI mode), or be the plugin
+            // (with CLI support) to which a command is to be sent (if we are in
+            // CLI mode and have been given the name of a plugin)
+
+            bool solverPlugin = pluginInfo->category() == PluginInfo::Category::Solver;
 
             if (   ( pGuiMode && pluginInfo->isSelectable() && Plugin::load(pluginName))
-                || (!pGuiMode && (pluginInfo->hasCliSupport() || (pluginInfo->category() == PluginInfo::Category::Solver)))) {
+                || (!pGuiMode && pCliPluginName.isEmpty() && (pluginInfo->hasCliSupport() || solverPlugin))
+                || (!pGuiMode && (pluginName == pCliPluginName) && pluginInfo->hasCliSupport())) {
                 // Keep track of the plugin's dependencies
 
-                neededPlugins << pluginsInfo.value(pluginName)->fullDependencies();
+                neededPlugins << pluginInfo->fullDependencies();
 
                 // Also keep track of the plugin itself
 
                 wantedPlugins << pluginName;
+            } else if (!pGuiMode && solverPlugin) {
+                // Keep track of the solver and of its dependencies, so that we
+                // can activate them later, if needed
+
+                deferredNeededPlugins << pluginInfo->fullDependencies();
+                deferredWantedPlugins << pluginName;
             }
         }
     }
@@ -154,6 +172,24 @@ PluginManager::PluginManager(bool pGuiMode) :
         pluginFileNames << Plugin::fileName(mPluginsDir, plugin);
     }
 
+    // Keep track of the plugins that we are deferring, i.e. those that are not
+    // already needed or wanted
+
+    mDeferredPlugins = deferredNeededPlugins+deferredWantedPlugins;
+
+    mDeferredPlugins.removeDuplicates();
+
+    for (const auto &plugin : plugins) {
+        mDeferredPlugins.removeAll(plugin);
+    }
+
+    mDeferredNeededPlugins = deferredNeededPlugins;
+
+    for (const auto &deferredPlugin : mDeferredPlugins) {
+        mDeferredPluginsInfo.insert(deferredPlugin, pluginsInfo.value(deferredPlugin));
+        mDeferredPluginsError.insert(deferredPlugin, pluginsError.value(deferredPlugin));
+    }
+
     // If we are in GUI mode, then we want to know about all the plugins,
     // including the ones that are not to be loaded (so that we can refer to
     // them, in the plugins window, as either not wanted or not needed)
@@ -198,6 +234,10 @@ PluginManager::~PluginManager()
     for (auto plugin : mPlugins) {
         delete plugin;
     }
+
+    for (auto deferredPluginInfo : mDeferredPluginsInfo) {
+        delete deferredPluginInfo;
+    }
 }
 
 //==============================================================================
@@ -279,6 +319,51 @@ Plugin * PluginManager::corePlugin() const
 
 //==============================================================================
 
+bool PluginManager::hasDeferredPlugins() const
+{
+    // Return whether we have some deferred plugins
+
+    return !mDeferredPlugins.isEmpty();
+}
+
+//==============================================================================
+
+Plugins PluginManager::activateDeferredPlugins()
+{
+    // Activate our deferred plugins, if any, in the order in which they were
+    // sorted, i.e. making sure that a plugin's dependencies get activated
+    // before the plugin itself
+    // Note: a plugin gets ownership of its information, so we stop tracking it
+    //       as soon as we have created the plugin...
+
+    Plugins res;
+
+    for (const auto &deferredPlugin : mDeferredPlugins) {
+        auto plugin = new Plugin(Plugin::fileName(mPluginsDir, deferredPlugin),
+                                 mDeferredPluginsInfo.take(deferredPlugin),
+                                 mDeferredPluginsError.value(deferredPlugin),
+                                 true,
+                                 mDeferredNeededPlugins.contains(deferredPlugin),
+                                 this);
+
+        mPlugins << plugin;
+
+        if (plugin->status() == Plugin::Status::Loaded) {
+            mLoadedPlugins << plugin;
+
+            res << plugin;
+        }
+    }
+
+    mDeferredPlugins.clear();
+    mDeferredNeededPlugins.clear();
+    mDeferredPluginsError.clear();
+
+    return res;
+}
+
+//==============================================================================
+
 } // namespace OpenCOR
 
 //==============================================================================
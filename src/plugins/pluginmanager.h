@@ -30,6 +30,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QMap>
 #include <QObject>
 
 //==============================================================================
@@ -42,12 +43,21 @@ namespace OpenCOR {
 
 //==============================================================================
 
+static const auto DeferredPluginsActivatorSignature = QStringLiteral("OpenCOR::PluginManager::deferredPluginsActivator()");
+
+//==============================================================================
+
+using DeferredPluginsActivator = void (*)();
+
+//==============================================================================
+
 class PluginManager : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit PluginManager(bool pGuiMode = true);
+    explicit PluginManager(bool pGuiMode = true,
+                           const QString &pCliPluginName = QString());
     ~PluginManager() override;
 
     bool guiMode() const;
@@ -61,6 +71,9 @@ public:
     Plugin * plugin(const QString &pName) const;
     Plugin * corePlugin() const;
 
+    bool hasDeferredPlugins() const;
+    Plugins activateDeferredPlugins();
+
 private:
     bool mGuiMode;
 
@@ -70,6 +83,11 @@ private:
     Plugins mLoadedPlugins;
 
     Plugin *mCorePlugin = nullptr;
+
+    QStringList mDeferredPlugins;
+    QStringList mDeferredNeededPlugins;
+    QMap<QString, PluginInfo *> mDeferredPluginsInfo;
+    QMap<QString, QString> mDeferredPluginsError;
 };
 
 //==============================================================================
@@ -285,6 +285,10 @@
         <source>Graph</source>
         <translation>Graphe</translation>
     </message>
+    <message>
+        <source>Simulation</source>
+        <translation>Simulation</translation>
+    </message>
     <message>
         <source>Background colour</source>
         <translation>Couleur d&apos;arrière-plan</translation>
@@ -325,6 +329,10 @@
         <source>Fill colour</source>
         <translation>Couleur de remplissage</translation>
     </message>
+    <message>
+        <source>Instrumented</source>
+        <translation>Instrumentée</translation>
+    </message>
 </context>
 <context>
     <name>OpenCOR::SimulationExperimentView::SimulationExperimentViewSimulationWidget</name>
@@ -636,6 +644,42 @@
         <source>%1 using %2</source>
         <translation>%1 avec %2</translation>
     </message>
+    <message>
+        <source>%1 steps (%2 rejected)</source>
+        <translation>%1 pas (%2 rejetés)</translation>
+    </message>
+    <message>
+        <source>%1 steps</source>
+        <translation>%1 pas</translation>
+    </message>
+    <message>
+        <source>%1 RHS evaluations</source>
+        <translation>%1 évaluations du second membre</translation>
+    </message>
+    <message>
+        <source>%1 Jacobian evaluations</source>
+        <translation>%1 évaluations de la jacobienne</translation>
+    </message>
+    <message>
+        <source>%1 linear solver setups</source>
+        <translation>%1 préparations du solveur linéaire</translation>
+    </message>
+    <message>
+        <source>%1 NLA solves (%2 per step)</source>
+        <translation>%1 résolutions NLA (%2 par pas)</translation>
+    </message>
+    <message>
+        <source>%1 in the ODE solver</source>
+        <translation>%1 dans le solveur ODE</translation>
+    </message>
+    <message>
+        <source>%1 adding points</source>
+        <translation>%1 à ajouter des points</translation>
+    </message>
+    <message>
+        <source>Solver statistics:</source>
+        <translation>Statistiques des solveurs :</translation>
+    </message>
     <message>
         <source>Error:</source>
         <translation>Erreur :</translation>
@@ -30,6 +30,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 #include <QContextMenuEvent>
 #include <QMenu>
+#include <QScrollBar>
 
 //==============================================================================
 
@@ -49,6 +50,14 @@ SimulationExperimentViewInformationParametersWidget::SimulationExperimentViewInf
 
     connect(this, &Core::PropertyEditorWidget::propertyChanged,
             this, &SimulationExperimentViewInformationParametersWidget::propertyChanged);
+
+    // Update the parameters that become visible, since we only ever keep our
+    // visible parameters up to date (see updateParameters())
+
+    connect(verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &SimulationExperimentViewInformationParametersWidget::updateVisibleParameters);
+    connect(this, &SimulationExperimentViewInformationParametersWidget::expanded,
+            this, &SimulationExperimentViewInformationParametersWidget::updateVisibleParameters);
 }
 
 //==============================================================================
@@ -108,6 +117,19 @@ void SimulationExperimentViewInformationParametersWidget::contextMenuEvent(QCont
 
 //==============================================================================
 
+void SimulationExperimentViewInformationParametersWidget::resizeEvent(QResizeEvent *pEvent)
+{
+    // Default handling of the event
+
+    PropertyEditorWidget::resizeEvent(pEvent);
+
+    // Update the parameters that may have become visible
+
+    updateVisibleParameters();
+}
+
+//==============================================================================
+
 void SimulationExperimentViewInformationParametersWidget::initialize(SimulationSupport::Simulation *pSimulation,
                                                                      bool pReloading)
 {
@@ -170,6 +192,8 @@ void SimulationExperimentViewInformationParametersWidget::finalize()
 
     mParameters.clear();
     mParameterActions.clear();
+
+    mUpToDateProperties.clear();
 }
 
 //==============================================================================
@@ -246,32 +270,81 @@ void SimulationExperimentViewInformationParametersWidget::importData(DataStore::
 
 //==============================================================================
 
-void SimulationExperimentViewInformationParametersWidget::updateParameters(double pCurrentPoint)
+Core::Properties SimulationExperimentViewInformationParametersWidget::visibleProperties() const
 {
-    // Update our data
+    // Return the properties which row is (at least partially) visible
 
-    for (auto property : allProperties()) {
-        CellMLSupport::CellmlFileRuntimeParameter *parameter = mParameters.value(property);
+    Core::Properties res;
+    int viewportHeight = viewport()->height();
 
-        if (parameter != nullptr) {
-            CellMLSupport::CellmlFileRuntimeParameter::Type parameterType = parameter->type();
+    for (QModelIndex index = indexAt(QPoint(0, 0));
+         index.isValid() && (visualRect(index).top() < viewportHeight);
+         index = indexBelow(index)) {
+        res << property(index);
+    }
 
-            if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Voi) {
-                property->setDoubleValue(pCurrentPoint, false);
-            } else if (   (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Constant)
-                       || (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::ComputedConstant)) {
-                property->setDoubleValue(mSimulation->data()->constants()[parameter->index()], false);
-            } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Rate) {
-                property->setDoubleValue(mSimulation->data()->rates()[parameter->index()], false);
-            } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::State) {
-                property->setDoubleValue(mSimulation->data()->states()[parameter->index()], false);
-            } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Algebraic) {
-                property->setDoubleValue(mSimulation->data()->algebraic()[parameter->index()], false);
-            } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Data) {
-                property->setDoubleValue(parameter->data()[parameter->index()], false);
-            }
+    return res;
+}
+
+//==============================================================================
+
+void SimulationExperimentViewInformationParametersWidget::updateParameter(Core::Property *pProperty)
+{
+    // Update the given property using the value of its parameter
+
+    CellMLSupport::CellmlFileRuntimeParameter *parameter = mParameters.value(pProperty);
+
+    if (parameter != nullptr) {
+        CellMLSupport::CellmlFileRuntimeParameter::Type parameterType = parameter->type();
+
+        if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Voi) {
+            pProperty->setDoubleValue(mCurrentPoint, false);
+        } else if (   (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Constant)
+                   || (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::ComputedConstant)) {
+            pProperty->setDoubleValue(mSimulation->data()->constants()[parameter->index()], false);
+        } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Rate) {
+            pProperty->setDoubleValue(mSimulation->data()->rates()[parameter->index()], false);
+        } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::State) {
+            pProperty->setDoubleValue(mSimulation->data()->states()[parameter->index()], false);
+        } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Algebraic) {
+            pProperty->setDoubleValue(mSimulation->data()->algebraic()[parameter->index()], false);
+        } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Data) {
+            pProperty->setDoubleValue(parameter->data()[parameter->index()], false);
+        }
+    }
+
+    mUpToDateProperties << pProperty;
+}
+
+//==============================================================================
+
+void SimulationExperimentViewInformationParametersWidget::updateVisibleParameters()
+{
+    // Update our visible parameters that are not up to date
+
+    for (auto property : visibleProperties()) {
+        if (!mUpToDateProperties.contains(property)) {
+            updateParameter(property);
         }
     }
+}
+
+//==============================================================================
+
+void SimulationExperimentViewInformationParametersWidget::updateParameters(double pCurrentPoint)
+{
+    // Consider all our parameters as being out of date and update only the
+    // visible ones
+    // Note: with large models, updating all of our parameters would be very
+    //       costly (and pointless). So, we only update a parameter once it
+    //       becomes visible (see updateVisibleParameters()) or when all of them
+    //       are needed (see parameters())...
+
+    mCurrentPoint = pCurrentPoint;
+
+    mUpToDateProperties.clear();
+
+    updateVisibleParameters();
 
     // Check whether any of our properties has actually been modified
 
@@ -313,9 +386,17 @@ void SimulationExperimentViewInformationParametersWidget::propertyChanged(Core::
 
 //==============================================================================
 
-QMap<Core::Property *, CellMLSupport::CellmlFileRuntimeParameter *> SimulationExperimentViewInformationParametersWidget::parameters() const
+QMap<Core::Property *, CellMLSupport::CellmlFileRuntimeParameter *> SimulationExperimentViewInformationParametersWidget::parameters()
 {
-    // Return our parameters
+    // Make sure that all our parameters are up to date and return them
+
+    for (auto parameter = mParameters.constBegin(),
+              parameterEnd = mParameters.constEnd();
+         parameter != parameterEnd; ++parameter) {
+        if (!mUpToDateProperties.contains(parameter.key())) {
+            updateParameter(parameter.key());
+        }
+    }
 
     return mParameters;
 }
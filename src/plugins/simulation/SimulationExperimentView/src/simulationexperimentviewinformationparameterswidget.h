@@ -29,6 +29,10 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QSet>
+
+//==============================================================================
+
 namespace OpenCOR {
 
 //==============================================================================
@@ -71,10 +75,11 @@ public:
 
     void importData(DataStore::DataStoreImportData *pImportData);
 
-    QMap<Core::Property *, CellMLSupport::CellmlFileRuntimeParameter *> parameters() const;
+    QMap<Core::Property *, CellMLSupport::CellmlFileRuntimeParameter *> parameters();
 
 protected:
     void contextMenuEvent(QContextMenuEvent *pEvent) override;
+    void resizeEvent(QResizeEvent *pEvent) override;
 
 private:
     QMenu *mContextMenu;
@@ -92,11 +97,17 @@ private:
     Core::Property *mImportComponent = nullptr;
     QMenu *mImportMenu = nullptr;
 
+    double mCurrentPoint = 0.0;
+    QSet<Core::Property *> mUpToDateProperties;
+
     void populateModel(CellMLSupport::CellmlFileRuntime *pRuntime);
     void populateContextMenu(CellMLSupport::CellmlFileRuntime *pRuntime);
 
     void updateExtraInfos();
 
+    Core::Properties visibleProperties() const;
+    void updateParameter(Core::Property *pProperty);
+
     void retranslateContextMenu();
 
 signals:
@@ -107,6 +118,8 @@ public slots:
     void updateParameters(double pCurrentPoint);
 
 private slots:
+    void updateVisibleParameters();
+
     void propertyChanged(Core::Property *pProperty);
 
     void emitGraphRequired();
@@ -51,6 +51,7 @@ static const char *SettingsPropertiesWidth = "PropertiesWidth";
 static const char *SettingsCategoryDefault    = "Graph Panel";
 static const char *SettingsCategoryGraphPanel = SettingsCategoryDefault;
 static const char *SettingsCategoryGraph      = "Graph";
+static const char *SettingsCategorySimulation = "Simulation";
 
 //==============================================================================
 
@@ -70,10 +71,15 @@ SimulationExperimentViewPreferencesWidget::SimulationExperimentViewPreferencesWi
 
     int graphPanelIndex = mCategoryTabs->addTab(tr("Graph Panel"));
     int graphIndex = mCategoryTabs->addTab(tr("Graph"));
+    int simulationIndex = mCategoryTabs->addTab(tr("Simulation"));
 
     QString category = mSettings.value(SettingsCategory, SettingsCategoryDefault).toString();
 
-    mCategoryTabs->setCurrentIndex(int(category != SettingsCategoryGraphPanel));
+    mCategoryTabs->setCurrentIndex((category == SettingsCategoryGraph)?
+                                       graphIndex:
+                                       (category == SettingsCategorySimulation)?
+                                           simulationIndex:
+                                           graphPanelIndex);
 
     mGui->layout->addWidget(mCategoryTabs);
 
@@ -93,6 +99,8 @@ SimulationExperimentViewPreferencesWidget::SimulationExperimentViewPreferencesWi
     mGraphSymbolFilled = mSettings.value(SettingsPreferencesGraphSymbolFilled, SettingsPreferencesGraphSymbolFilledDefault).toBool();
     mGraphSymbolFillColor = mSettings.value(SettingsPreferencesGraphSymbolFillColor, SettingsPreferencesGraphSymbolFillColorDefault).value<QColor>();
 
+    mSimulationInstrumented = mSettings.value(SettingsPreferencesSimulationInstrumented, SettingsPreferencesSimulationInstrumentedDefault).toBool();
+
     // Create and customise our graph panel property editor
 
     mGraphPanelProperties = new Core::PropertyEditorWidget(false, false, this);
@@ -134,16 +142,33 @@ SimulationExperimentViewPreferencesWidget::SimulationExperimentViewPreferencesWi
     connect(mGraphProperties->header(), &QHeaderView::sectionResized,
             this, &SimulationExperimentViewPreferencesWidget::headerSectionResized);
 
+    // Create and customise our simulation property editor
+    // Note: instrumenting a simulation means timing our ODE solver and the
+    //       adding of points separately, which is only worth it when looking
+    //       into where the time goes, hence it is off by default...
+
+    mSimulationProperties = new Core::PropertyEditorWidget(false, false, this);
+
+    mSimulationProperties->addBooleanProperty(mSimulationInstrumented)->setName(tr("Instrumented"));
+
+    mSimulationProperties->setColumnWidth(0, propertiesWidth);
+
+    connect(mSimulationProperties->header(), &QHeaderView::sectionResized,
+            this, &SimulationExperimentViewPreferencesWidget::headerSectionResized);
+
     // Add our property editors (with a border) to our layout
 
     auto graphPanelBorderedWidget = new Core::BorderedWidget(mGraphPanelProperties, true, true, true, true);
     auto graphBorderedWidget = new Core::BorderedWidget(mGraphProperties, true, true, true, true);
+    auto simulationBorderedWidget = new Core::BorderedWidget(mSimulationProperties, true, true, true, true);
 
     mPropertyEditors.insert(graphPanelIndex, graphPanelBorderedWidget);
     mPropertyEditors.insert(graphIndex, graphBorderedWidget);
+    mPropertyEditors.insert(simulationIndex, simulationBorderedWidget);
 
     mGui->layout->addWidget(graphPanelBorderedWidget);
     mGui->layout->addWidget(graphBorderedWidget);
+    mGui->layout->addWidget(simulationBorderedWidget);
 
     // Show the right property editor by "updating" our GUI
 
@@ -160,9 +185,13 @@ SimulationExperimentViewPreferencesWidget::~SimulationExperimentViewPreferencesW
 {
     // Keep track of which category is selected
 
-    mSettings.setValue(SettingsCategory, (mCategoryTabs->currentIndex() == 0)?
+    int categoryIndex = mCategoryTabs->currentIndex();
+
+    mSettings.setValue(SettingsCategory, (categoryIndex == 0)?
                                              SettingsCategoryGraphPanel:
-                                             SettingsCategoryGraph);
+                                             (categoryIndex == 1)?
+                                                 SettingsCategoryGraph:
+                                                 SettingsCategorySimulation);
 
     // Keep track of the width of our property editors (using that of our graph
     // panel property editor since they all have the same width)
@@ -182,6 +211,7 @@ bool SimulationExperimentViewPreferencesWidget::preferencesChanged() const
 
     mGraphPanelProperties->finishEditing();
     mGraphProperties->finishEditing();
+    mSimulationProperties->finishEditing();
 
     // Return whether our preferences have changed
 
@@ -189,6 +219,7 @@ bool SimulationExperimentViewPreferencesWidget::preferencesChanged() const
     Core::Properties graphProperties = mGraphProperties->properties();
     Core::Properties graphLineProperties = graphProperties[0]->properties();
     Core::Properties graphSymbolProperties = graphProperties[1]->properties();
+    Core::Properties simulationProperties = mSimulationProperties->properties();
 
     return    // Graph panel preferences
               (graphPanelProperties[0]->colorValue() != mGraphPanelBackgroundColor)
@@ -201,7 +232,9 @@ bool SimulationExperimentViewPreferencesWidget::preferencesChanged() const
            ||  (graphSymbolProperties[0]->listValueIndex() != SEDMLSupport::indexSymbolStyle(mGraphSymbolStyle))
            ||  (graphSymbolProperties[1]->integerValue() != mGraphSymbolSize)
            ||  (graphSymbolProperties[2]->booleanValue() != mGraphSymbolFilled)
-           ||  (graphSymbolProperties[3]->colorValue() != mGraphSymbolFillColor);
+           ||  (graphSymbolProperties[3]->colorValue() != mGraphSymbolFillColor)
+              // Simulation preferences
+           ||  (simulationProperties[0]->booleanValue() != mSimulationInstrumented);
 }
 
 //==============================================================================
@@ -228,6 +261,10 @@ void SimulationExperimentViewPreferencesWidget::resetPreferences()
     graphSymbolProperties[1]->setIntegerValue(SettingsPreferencesGraphSymbolSizeDefault);
     graphSymbolProperties[2]->setBooleanValue(SettingsPreferencesGraphSymbolFilledDefault);
     graphSymbolProperties[3]->setColorValue(SettingsPreferencesGraphSymbolFillColorDefault);
+
+    Core::Properties simulationProperties = mSimulationProperties->properties();
+
+    simulationProperties[0]->setBooleanValue(SettingsPreferencesSimulationInstrumentedDefault);
 }
 
 //==============================================================================
@@ -254,6 +291,10 @@ void SimulationExperimentViewPreferencesWidget::savePreferences()
     mSettings.setValue(SettingsPreferencesGraphSymbolSize, graphSymbolProperties[1]->integerValue());
     mSettings.setValue(SettingsPreferencesGraphSymbolFilled, graphSymbolProperties[2]->booleanValue());
     mSettings.setValue(SettingsPreferencesGraphSymbolFillColor, graphSymbolProperties[3]->colorValue());
+
+    Core::Properties simulationProperties = mSimulationProperties->properties();
+
+    mSettings.setValue(SettingsPreferencesSimulationInstrumented, simulationProperties[0]->booleanValue());
 }
 
 //==============================================================================
@@ -281,14 +322,19 @@ void SimulationExperimentViewPreferencesWidget::headerSectionResized(int pIndex,
                this, &SimulationExperimentViewPreferencesWidget::headerSectionResized);
     disconnect(mGraphProperties->header(), &QHeaderView::sectionResized,
                this, &SimulationExperimentViewPreferencesWidget::headerSectionResized);
+    disconnect(mSimulationProperties->header(), &QHeaderView::sectionResized,
+               this, &SimulationExperimentViewPreferencesWidget::headerSectionResized);
 
     mGraphPanelProperties->setColumnWidth(pIndex, pNewSize);
     mGraphProperties->setColumnWidth(pIndex, pNewSize);
+    mSimulationProperties->setColumnWidth(pIndex, pNewSize);
 
     connect(mGraphPanelProperties->header(), &QHeaderView::sectionResized,
             this, &SimulationExperimentViewPreferencesWidget::headerSectionResized);
     connect(mGraphProperties->header(), &QHeaderView::sectionResized,
             this, &SimulationExperimentViewPreferencesWidget::headerSectionResized);
+    connect(mSimulationProperties->header(), &QHeaderView::sectionResized,
+            this, &SimulationExperimentViewPreferencesWidget::headerSectionResized);
 }
 
 //==============================================================================
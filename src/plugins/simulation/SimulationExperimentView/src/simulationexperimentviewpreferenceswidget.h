@@ -92,6 +92,14 @@ static const QColor SettingsPreferencesGraphSymbolFillColorDefault       = Graph
 
 //==============================================================================
 
+static const auto SettingsPreferencesSimulationInstrumented = QStringLiteral("SimulationInstrumented");
+
+//==============================================================================
+
+static const bool SettingsPreferencesSimulationInstrumentedDefault = false;
+
+//==============================================================================
+
 class SimulationExperimentViewPreferencesWidget : public Preferences::PreferencesWidget
 {
     Q_OBJECT
@@ -112,6 +120,7 @@ private:
 
     Core::PropertyEditorWidget *mGraphPanelProperties;
     Core::PropertyEditorWidget *mGraphProperties;
+    Core::PropertyEditorWidget *mSimulationProperties;
 
     QMap<int, Core::BorderedWidget *> mPropertyEditors;
 
@@ -126,6 +135,8 @@ private:
     bool mGraphSymbolFilled;
     QColor mGraphSymbolFillColor;
 
+    bool mSimulationInstrumented;
+
 private slots:
     void updateGui();
 
@@ -49,6 +49,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 #include "toolbarwidgetdropdownlistwidgetaction.h"
 #include "toolbarwidgetlabelwidgetaction.h"
 #include "toolbarwidgetwheelwidgetaction.h"
+#include "tracer.h"
 #include "usermessagewidget.h"
 
 //==============================================================================
@@ -59,6 +60,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 #include <QDragEnterEvent>
 #include <QLabel>
 #include <QLayout>
+#include <QLocale>
 #include <QMainWindow>
 #include <QMenu>
 #include <QMimeData>
@@ -126,6 +128,9 @@ SimulationExperimentViewSimulationWidget::SimulationExperimentViewSimulationWidg
     connect(mSimulation, &SimulationSupport::Simulation::paused,
             this, &SimulationExperimentViewSimulationWidget::simulationPaused);
 
+    connect(mSimulation, &SimulationSupport::Simulation::progress,
+            this, &SimulationExperimentViewSimulationWidget::simulationProgress);
+
     connect(mSimulation, &SimulationSupport::Simulation::done,
             this, &SimulationExperimentViewSimulationWidget::simulationDone);
 
@@ -1420,10 +1425,29 @@ void SimulationExperimentViewSimulationWidget::runPauseResumeSimulation()
         if (mSimulation->isPaused()) {
             mSimulation->resume();
         } else {
-            // Try to allocate all the memory we need by adding a run to our
-            // simulation and, if successful, run our simulation
-
-            if (mSimulation->addRun()) {
+            // Instrument our simulation, if requested
+
+            mSimulation->setInstrumented(PreferencesInterface::preference(PluginName,
+                                                                          SettingsPreferencesSimulationInstrumented,
+                                                                          SettingsPreferencesSimulationInstrumentedDefault).toBool());
+
+            // Run all the iterations of our repeated task, if we have one, each
+            // in its own run, or try to allocate all the memory we need by
+            // adding a run to our simulation and, if successful, run our
+            // simulation
+            // Note: we keep track of the first run of our repeated task, so
+            //       that we can check the results of all of its runs as it
+            //       progresses (see simulationProgress()). If our repeated task
+            //       cannot be run, then we will have been told why (see
+            //       simulationError())...
+
+            if (mSimulation->hasRepeatedTask()) {
+                mRepeatedTaskFirstRun = mSimulation->runsCount();
+
+                if (!mSimulation->runRepeatedTask()) {
+                    mRepeatedTaskFirstRun = -1;
+                }
+            } else if (mSimulation->addRun()) {
                 mSimulation->run();
             } else {
                 Core::warningMessageBox(tr("Run Simulation"),
@@ -3075,10 +3099,14 @@ void SimulationExperimentViewSimulationWidget::simulationRunning(bool pIsResumin
 
     // Our simulation is running, so update our simulation mode and check for
     // results
+    // Note: the results of a repeated task are checked as it progresses (see
+    //       simulationProgress())...
 
     updateSimulationMode();
 
-    mViewWidget->checkSimulationResults(mSimulation->fileName());
+    if (mRepeatedTaskFirstRun == -1) {
+        mViewWidget->checkSimulationResults(mSimulation->fileName());
+    }
 }
 
 //==============================================================================
@@ -3092,7 +3120,29 @@ void SimulationExperimentViewSimulationWidget::simulationPaused()
 
     mContentsWidget->informationWidget()->parametersWidget()->updateParameters(mSimulation->currentPoint());
 
-    mViewWidget->checkSimulationResults(mSimulation->fileName());
+    if (mRepeatedTaskFirstRun == -1) {
+        mViewWidget->checkSimulationResults(mSimulation->fileName());
+    } else {
+        mViewWidget->checkSimulationRunsResults(mSimulation->fileName(),
+                                                mRepeatedTaskFirstRun);
+    }
+}
+
+//==============================================================================
+
+void SimulationExperimentViewSimulationWidget::simulationProgress(double pProgress)
+{
+    // Our repeated task has progressed, so check the results of all of its runs
+    // (since its iterations are run in parallel) and update our progress bar
+
+    if (mRepeatedTaskFirstRun == -1) {
+        return;
+    }
+
+    mViewWidget->checkSimulationRunsResults(mSimulation->fileName(),
+                                            mRepeatedTaskFirstRun);
+
+    mProgressBarWidget->setValue(pProgress);
 }
 
 //==============================================================================
@@ -3110,6 +3160,50 @@ void SimulationExperimentViewSimulationWidget::simulationDone(qint64 pElapsedTim
 
         output(QString(QString()+OutputTab+"<strong>"+tr("Simulation time:")+"</strong> <span "+OutputInfo+">"+tr("%1 using %2").arg(Core::formatTime(pElapsedTime),
                                                                                                                                     solversInformation)+"</span>."+OutputBrLn));
+
+        // Output our solver statistics, if any
+
+        QVariantMap statistics = mSimulation->statistics();
+        QStringList statisticsInformation;
+        QLocale locale;
+
+        if (statistics.contains(Solver::StepsStatistic)) {
+            if (statistics.contains(Solver::RejectedStepsStatistic)) {
+                statisticsInformation << tr("%1 steps (%2 rejected)").arg(locale.toString(statistics.value(Solver::StepsStatistic).toULongLong()),
+                                                                           locale.toString(statistics.value(Solver::RejectedStepsStatistic).toULongLong()));
+            } else {
+                statisticsInformation << tr("%1 steps").arg(locale.toString(statistics.value(Solver::StepsStatistic).toULongLong()));
+            }
+        }
+
+        if (statistics.contains(Solver::RhsEvaluationsStatistic)) {
+            statisticsInformation << tr("%1 RHS evaluations").arg(locale.toString(statistics.value(Solver::RhsEvaluationsStatistic).toULongLong()));
+        }
+
+        if (statistics.contains(Solver::JacobianEvaluationsStatistic)) {
+            statisticsInformation << tr("%1 Jacobian evaluations").arg(locale.toString(statistics.value(Solver::JacobianEvaluationsStatistic).toULongLong()));
+        }
+
+        if (statistics.contains(Solver::LinearSolverSetupsStatistic)) {
+            statisticsInformation << tr("%1 linear solver setups").arg(locale.toString(statistics.value(Solver::LinearSolverSetupsStatistic).toULongLong()));
+        }
+
+        if (statistics.contains(Solver::NlaSolvesStatistic)) {
+            statisticsInformation << tr("%1 NLA solves (%2 per step)").arg(locale.toString(statistics.value(Solver::NlaSolvesStatistic).toULongLong()),
+                                                                            locale.toString(statistics.value(SimulationSupport::NlaSolvesPerStepStatistic).toDouble(), 'g', 3));
+        }
+
+        if (statistics.contains(SimulationSupport::SolverTimeStatistic)) {
+            statisticsInformation << tr("%1 in the ODE solver").arg(Core::formatTime(qint64(statistics.value(SimulationSupport::SolverTimeStatistic).toDouble())));
+        }
+
+        if (statistics.contains(SimulationSupport::AddPointTimeStatistic)) {
+            statisticsInformation << tr("%1 adding points").arg(Core::formatTime(qint64(statistics.value(SimulationSupport::AddPointTimeStatistic).toDouble())));
+        }
+
+        if (!statisticsInformation.isEmpty()) {
+            output(QString(QString()+OutputTab+"<strong>"+tr("Solver statistics:")+"</strong> <span "+OutputInfo+">"+statisticsInformation.join(", ")+"</span>."+OutputBrLn));
+        }
     }
 
     // Update our parameters and simulation mode
@@ -3118,6 +3212,18 @@ void SimulationExperimentViewSimulationWidget::simulationDone(qint64 pElapsedTim
 
     mContentsWidget->informationWidget()->parametersWidget()->updateParameters(mSimulation->currentPoint());
 
+    // Check the results of our repeated task, if we were running one, one last
+    // time and reset our progress bar or file tab icon
+
+    if (mRepeatedTaskFirstRun != -1) {
+        mViewWidget->checkSimulationRunsResults(mSimulation->fileName(),
+                                                mRepeatedTaskFirstRun);
+
+        mRepeatedTaskFirstRun = -1;
+
+        resetSimulationProgress();
+    }
+
     // Stop tracking our simulation progress and reset our file tab icon
 
     mProgress = -1;
@@ -3728,6 +3834,10 @@ void SimulationExperimentViewSimulationWidget::updateSimulationResults(Simulatio
                                                                        int pSimulationRun,
                                                                        Task pTask)
 {
+    // Trace ourselves
+
+    Core::TraceEvent traceEvent("SimulationExperimentViewSimulationWidget::updateSimulationResults");
+
     // Update our simulation results
 
     SimulationSupport::Simulation *simulation = pSimulationWidget->simulation();
@@ -205,6 +205,7 @@ private:
     Core::ProgressBarWidget *mProgressBarWidget;
 
     int mProgress = -1;
+    int mRepeatedTaskFirstRun = -1;
     bool mLockedDevelopmentMode = false;
 
     ToolBarWidget::ToolBarWidget *mToolBarWidget;
@@ -412,6 +413,7 @@ private slots:
 
     void simulationRunning(bool pIsResuming);
     void simulationPaused();
+    void simulationProgress(double pProgress);
 
     void simulationDone(qint64 pElapsedTime);
 
@@ -589,6 +589,38 @@ void SimulationExperimentViewWidget::checkSimulationResults(const QString &pFile
 
 //==============================================================================
 
+void SimulationExperimentViewWidget::checkSimulationRunsResults(const QString &pFileName,
+                                                                int pFirstRun)
+{
+    // Make sure that we can still check results (see checkSimulationResults())
+
+    SimulationExperimentViewSimulationWidget *simulationWidget = mSimulationWidgets.value(pFileName);
+
+    if (simulationWidget == nullptr) {
+        return;
+    }
+
+    // Update all of our simulation widgets' results for all the runs of the
+    // given file's simulation, starting from the given one
+    // Note: this is for the iterations of a repeated task, which are run in
+    //       parallel, so all of their runs may have new results...
+
+    SimulationSupport::Simulation *simulation = simulationWidget->simulation();
+
+    for (int i = pFirstRun, iMax = simulation->runsCount(); i < iMax; ++i) {
+        quint64 simulationResultsSize = simulation->results()->size(i);
+
+        for (auto currentSimulationWidget : mSimulationWidgets) {
+            currentSimulationWidget->updateSimulationResults(simulationWidget,
+                                                             simulationResultsSize,
+                                                             i,
+                                                             SimulationExperimentViewSimulationWidget::Task::None);
+        }
+    }
+}
+
+//==============================================================================
+
 void SimulationExperimentViewWidget::simulationWidgetSplitterMoved(const QIntList &pSizes)
 {
     // The splitter of our simulation widget has moved, so keep track of its new
@@ -100,6 +100,7 @@ public:
 
     void checkSimulationResults(const QString &pFileName,
                                 SimulationExperimentViewSimulationWidget::Task pTask = SimulationExperimentViewSimulationWidget::Task::None);
+    void checkSimulationRunsResults(const QString &pFileName, int pFirstRun);
 
 private:
     SimulationExperimentViewPlugin *mPlugin;
@@ -3,6 +3,10 @@
 <TS version="2.1" language="fr_FR" sourcelanguage="en_GB">
 <context>
     <name>OpenCOR::CVODESolver::CvodeSolver</name>
+    <message>
+        <source>the number of algebraic variables must be known to compute sensitivities</source>
+        <translation>le nombre de variables algébriques doit être connu pour calculer des sensibilités</translation>
+    </message>
     <message>
         <source>the &quot;Maximum step&quot; property value could not be retrieved</source>
         <translation>la valeur de la propriété &quot;Pas maximum&quot; n&apos;a pas pu être retrouvée</translation>
@@ -55,5 +59,9 @@
         <source>the &quot;Interpolate solution&quot; property value could not be retrieved</source>
         <translation>la valeur de la propriété &quot;Interpoler solution&quot; n&apos;a pas pu être retrouvée</translation>
     </message>
+    <message>
+        <source>the &quot;Number of threads&quot; property value could not be retrieved</source>
+        <translation>la valeur de la propriété &quot;Nombre de threads&quot; n&apos;a pas pu être retrouvée</translation>
+    </message>
 </context>
 </TS>
@@ -30,17 +30,28 @@ along with this program. If not, see <https://gnu.org/licenses>.
     #include "cvodes/cvodes_bandpre.h"
     #include "cvodes/cvodes_diag.h"
     #include "cvodes/cvodes_direct.h"
+    #include "cvodes/cvodes_ls.h"
     #include "cvodes/cvodes_spils.h"
     #include "sunlinsol/sunlinsol_band.h"
     #include "sunlinsol/sunlinsol_dense.h"
     #include "sunlinsol/sunlinsol_spbcgs.h"
     #include "sunlinsol/sunlinsol_spgmr.h"
     #include "sunlinsol/sunlinsol_sptfqmr.h"
+    #include "sunmatrix/sunmatrix_band.h"
+    #include "sunmatrix/sunmatrix_dense.h"
     #include "sunnonlinsol/sunnonlinsol_fixedpoint.h"
 #include "sundialsend.h"
 
 //==============================================================================
 
+#include <QtMath>
+
+//==============================================================================
+
+#include <limits>
+
+//==============================================================================
+
 namespace OpenCOR {
 namespace CVODESolver {
 
@@ -62,6 +73,85 @@ int rhsFunction(double pVoi, N_Vector pStates, N_Vector pRates, void *pUserData)
 
 //==============================================================================
 
+int sensitivitiesRhsFunction(int pSensitivitiesCount, double pVoi,
+                             N_Vector pStates, N_Vector pRates,
+                             int pSensitivityIndex, N_Vector pSensitivities,
+                             N_Vector pSensitivitiesRates, void *pUserData,
+                             N_Vector pWork1, N_Vector pWork2)
+{
+    Q_UNUSED(pSensitivitiesCount)
+    Q_UNUSED(pWork2)
+
+    // Compute the RHS function of the sensitivities with respect to the given
+    // constant, using a forward difference quotient, i.e.
+    //   dS/dt ~= (f(t, Y+delta*S, C+delta)-f(t, Y, C))/delta
+    // Note: the given constant may be used to compute some computed constants
+    //       (and algebraic variables), so we use our own copy of our constants
+    //       and algebraic variables, in which the given constant is perturbed
+    //       and our computed constants recomputed accordingly (see
+    //       CvodeSolver::updatePerturbedConstants())...
+
+    auto userData = static_cast<CvodeSolverUserData *>(pUserData);
+    double delta = userData->sensitivityDelta(pSensitivityIndex);
+    sunindextype statesCount = N_VGetLength_Serial(pStates);
+    double *states = N_VGetArrayPointer_Serial(pStates);
+    double *rates = N_VGetArrayPointer_Serial(pRates);
+    double *sensitivities = N_VGetArrayPointer_Serial(pSensitivities);
+    double *sensitivitiesRates = N_VGetArrayPointer_Serial(pSensitivitiesRates);
+    double *perturbedStates = N_VGetArrayPointer_Serial(pWork1);
+
+    for (sunindextype i = 0; i < statesCount; ++i) {
+        perturbedStates[i] = states[i]+delta*sensitivities[i];
+    }
+
+    userData->computeRates()(pVoi, userData->perturbedConstants(pSensitivityIndex),
+                             sensitivitiesRates, perturbedStates,
+                             userData->perturbedAlgebraic(pSensitivityIndex));
+
+    for (sunindextype i = 0; i < statesCount; ++i) {
+        sensitivitiesRates[i] = (sensitivitiesRates[i]-rates[i])/delta;
+    }
+
+    return 0;
+}
+
+//==============================================================================
+
+int rootsFunction(double pVoi, N_Vector pStates, double *pRoots,
+                  void *pUserData)
+{
+    // Compute our roots
+    // Note: computing our roots requires computing our rates, which we do in a
+    //       separate array so as not to interfere with CVODES...
+
+    auto userData = static_cast<CvodeSolverUserData *>(pUserData);
+
+    userData->computeRoots()(pVoi, userData->constants(), userData->rootsRates(),
+                             N_VGetArrayPointer_Serial(pStates),
+                             userData->algebraic(), pRoots);
+
+    return 0;
+}
+
+//==============================================================================
+
+int jacobianFunction(double pVoi, N_Vector pStates, N_Vector pRates,
+                     SUNMatrix pJacobian, void *pUserData, N_Vector pWork1,
+                     N_Vector pWork2, N_Vector pWork3)
+{
+    Q_UNUSED(pWork1)
+    Q_UNUSED(pWork2)
+    Q_UNUSED(pWork3)
+
+    // Compute our Jacobian
+
+    static_cast<CvodeSolverUserData *>(pUserData)->jacobian()->compute(pVoi, pStates, pRates, pJacobian);
+
+    return 0;
+}
+
+//==============================================================================
+
 void errorHandler(int pErrorCode, const char *pModule, const char *pFunction,
                   char *pErrorMessage, void *pUserData)
 {
@@ -77,6 +167,231 @@ void errorHandler(int pErrorCode, const char *pModule, const char *pFunction,
 
 //==============================================================================
 
+CvodeSolverJacobianWorker::CvodeSolverJacobianWorker(CvodeSolverJacobian *pJacobian,
+                                                     int pIndex,
+                                                     int pRatesStatesCount,
+                                                     int pAlgebraicCount) :
+    mJacobian(pJacobian),
+    mIndex(pIndex),
+    mStates(new double[pRatesStatesCount]),
+    mRates(new double[pRatesStatesCount]),
+    mAlgebraic(new double[pAlgebraicCount])
+{
+    // We are used for each of our Jacobian's evaluations, so we don't want to
+    // be deleted by our thread pool
+
+    setAutoDelete(false);
+}
+
+//==============================================================================
+
+CvodeSolverJacobianWorker::~CvodeSolverJacobianWorker()
+{
+    // Delete some internal objects
+
+    delete[] mStates;
+    delete[] mRates;
+    delete[] mAlgebraic;
+}
+
+//==============================================================================
+
+void CvodeSolverJacobianWorker::run()
+{
+    // Compute our share of our Jacobian's columns
+
+    mJacobian->computeColumns(mIndex, mStates, mRates, mAlgebraic);
+}
+
+//==============================================================================
+
+CvodeSolverJacobian::CvodeSolverJacobian(void *pSolver, SUNMatrix pMatrix,
+                                         int pRatesStatesCount,
+                                         int pAlgebraicCount, int pThreadsCount,
+                                         double *pConstants, double *pAlgebraic,
+                                         Solver::OdeSolver::ComputeRatesFunction pComputeRates) :
+    mSolver(pSolver),
+    mRatesStatesCount(pRatesStatesCount),
+    mAlgebraicCount(pAlgebraicCount),
+    mConstants(pConstants),
+    mAlgebraic(pAlgebraic),
+    mComputeRates(pComputeRates),
+    mGroupsCount(pRatesStatesCount),
+    mErrorWeightsVector(N_VNew_Serial(pRatesStatesCount)),
+    mErrorWeights(N_VGetArrayPointer_Serial(mErrorWeightsVector))
+{
+    // Group our columns, i.e. one column per group in the dense case and
+    // columns that are more than our bandwidth apart in the banded case (see
+    // cvLsBandDQJac() in CVODES)
+
+    if (SUNMatGetID(pMatrix) == SUNMATRIX_BAND) {
+        mBanded = true;
+
+        mUpperHalfBandwidth = int(SUNBandMatrix_UpperBandwidth(pMatrix));
+        mLowerHalfBandwidth = int(SUNBandMatrix_LowerBandwidth(pMatrix));
+
+        mGroupsCount = qMin(mUpperHalfBandwidth+mLowerHalfBandwidth+1,
+                            pRatesStatesCount);
+    }
+
+    // Create our workers, but no more than we have groups of columns
+    // Note: our first worker is run in the calling thread, hence our thread
+    //       pool only needs enough threads for our other workers...
+
+    int workersCount = qMin(pThreadsCount, mGroupsCount);
+
+    for (int i = 0; i < workersCount; ++i) {
+        mWorkers << new CvodeSolverJacobianWorker(this, i, pRatesStatesCount,
+                                                  pAlgebraicCount);
+    }
+
+    mThreadPool.setMaxThreadCount(qMax(workersCount-1, 1));
+}
+
+//==============================================================================
+
+CvodeSolverJacobian::~CvodeSolverJacobian()
+{
+    // Delete some internal objects
+
+    mThreadPool.waitForDone();
+
+    qDeleteAll(mWorkers);
+
+    N_VDestroy_Serial(mErrorWeightsVector);
+}
+
+//==============================================================================
+
+void CvodeSolverJacobian::compute(double pVoi, N_Vector pStates,
+                                  N_Vector pRates, SUNMatrix pJacobian)
+{
+    // Determine the minimum increment of our states, like CVODES does (see
+    // cvLsDenseDQJac() and cvLsBandDQJac() in CVODES), except for the step
+    // size that we use
+    // Note: CVODES uses the step size that it is currently attempting, which
+    //       its API doesn't give us access to, so we use the step size that it
+    //       is to attempt next instead (i.e. CVodeGetCurrentStep()). Both are
+    //       the same unless CVODES is retrying a step with a smaller step
+    //       size, in which case our minimum increment is larger than that of
+    //       CVODES, something that only matters for the states which magnitude
+    //       is small compared to it...
+
+    static const double Epsilon = std::numeric_limits<double>::epsilon();
+    static const double MinimumIncrementFactor = 1000.0;
+
+    double step = 0.0;
+
+    CVodeGetErrWeights(mSolver, mErrorWeightsVector);
+    CVodeGetCurrentStep(mSolver, &step);
+
+    double ratesNorm = N_VWrmsNorm(pRates, mErrorWeightsVector);
+
+    mMinimumIncrement = (ratesNorm != 0.0)?
+                            MinimumIncrementFactor*qAbs(step)*Epsilon*mRatesStatesCount*ratesNorm:
+                            1.0;
+
+    // Keep track of what our workers need and run them, our first worker
+    // being run in the current thread
+
+    mVoi = pVoi;
+    mStates = N_VGetArrayPointer_Serial(pStates);
+    mRates = N_VGetArrayPointer_Serial(pRates);
+    mJacobian = pJacobian;
+
+    for (int i = 1, iMax = mWorkers.count(); i < iMax; ++i) {
+        mThreadPool.start(mWorkers[i]);
+    }
+
+    mWorkers.first()->run();
+
+    mThreadPool.waitForDone();
+
+    // Keep track of the number of times our rates were evaluated, i.e. once
+    // per group of columns
+
+    mRhsEvaluationsCount += quint64(mGroupsCount);
+}
+
+//==============================================================================
+
+void CvodeSolverJacobian::computeColumns(int pIndex, double *pStates,
+                                         double *pRates,
+                                         double *pAlgebraic) const
+{
+    // Start from our current states and algebraic variables
+    // Note: some algebraic variables may be computed when computing our
+    //       computed constants rather than when computing our rates, hence we
+    //       need to start from our current algebraic variables...
+
+    static const double SqrtEpsilon = qSqrt(std::numeric_limits<double>::epsilon());
+
+    memcpy(pStates, mStates, size_t(mRatesStatesCount)*Solver::SizeOfDouble);
+    memcpy(pAlgebraic, mAlgebraic, size_t(mAlgebraicCount)*Solver::SizeOfDouble);
+
+    // Compute the columns of every n-th group, starting with the given one,
+    // using forward difference quotients
+
+    for (int group = pIndex, workersCount = mWorkers.count();
+         group < mGroupsCount; group += workersCount) {
+        // Perturb the states of our group
+
+        for (int j = group; j < mRatesStatesCount; j += mGroupsCount) {
+            pStates[j] += qMax(SqrtEpsilon*qAbs(mStates[j]),
+                               mMinimumIncrement/mErrorWeights[j]);
+        }
+
+        // Compute our perturbed rates
+
+        mComputeRates(mVoi, mConstants, pRates, pStates, pAlgebraic);
+
+        // Compute the columns of our group and restore our states
+
+        for (int j = group; j < mRatesStatesCount; j += mGroupsCount) {
+            double oneOverIncrement = 1.0/qMax(SqrtEpsilon*qAbs(mStates[j]),
+                                               mMinimumIncrement/mErrorWeights[j]);
+
+            pStates[j] = mStates[j];
+
+            if (mBanded) {
+                double *column = SUNBandMatrix_Column(mJacobian, j);
+
+                for (int i = qMax(0, j-mUpperHalfBandwidth),
+                         iMax = qMin(j+mLowerHalfBandwidth, mRatesStatesCount-1);
+                     i <= iMax; ++i) {
+                    column[i-j] = oneOverIncrement*(pRates[i]-mRates[i]);
+                }
+            } else {
+                double *column = SUNDenseMatrix_Column(mJacobian, j);
+
+                for (int i = 0; i < mRatesStatesCount; ++i) {
+                    column[i] = oneOverIncrement*(pRates[i]-mRates[i]);
+                }
+            }
+        }
+    }
+}
+
+//==============================================================================
+
+quint64 CvodeSolverJacobian::rhsEvaluationsCount() const
+{
+    // Return our number of RHS evaluations
+
+    return mRhsEvaluationsCount;
+}
+
+//==============================================================================
+
+void CvodeSolverJacobian::resetRhsEvaluationsCount()
+{
+    // Reset our number of RHS evaluations
+
+    mRhsEvaluationsCount = 0;
+}
+
+//==============================================================================
+
 CvodeSolverUserData::CvodeSolverUserData(double *pConstants, double *pAlgebraic,
                                          Solver::OdeSolver::ComputeRatesFunction pComputeRates) :
     mConstants(pConstants),
@@ -114,6 +429,102 @@ Solver::OdeSolver::ComputeRatesFunction CvodeSolverUserData::computeRates() cons
 
 //==============================================================================
 
+void CvodeSolverUserData::setSensitivities(const double *pSensitivityDeltas,
+                                           double *pPerturbedConstants,
+                                           int pConstantsCount,
+                                           double *pPerturbedAlgebraic,
+                                           int pAlgebraicCount)
+{
+    // Keep track of what we need to compute the RHS function of our
+    // sensitivities
+
+    mSensitivityDeltas = pSensitivityDeltas;
+    mPerturbedConstants = pPerturbedConstants;
+    mConstantsCount = pConstantsCount;
+    mPerturbedAlgebraic = pPerturbedAlgebraic;
+    mAlgebraicCount = pAlgebraicCount;
+}
+
+//==============================================================================
+
+double CvodeSolverUserData::sensitivityDelta(int pIndex) const
+{
+    // Return the delta by which the given sensitivity constant is perturbed
+
+    return mSensitivityDeltas[pIndex];
+}
+
+//==============================================================================
+
+double * CvodeSolverUserData::perturbedConstants(int pIndex) const
+{
+    // Return our constants in which the given sensitivity constant is
+    // perturbed
+
+    return mPerturbedConstants+pIndex*mConstantsCount;
+}
+
+//==============================================================================
+
+double * CvodeSolverUserData::perturbedAlgebraic(int pIndex) const
+{
+    // Return our algebraic variables that correspond to the given perturbed
+    // constants
+
+    return mPerturbedAlgebraic+pIndex*mAlgebraicCount;
+}
+
+//==============================================================================
+
+void CvodeSolverUserData::setRoots(double *pRootsRates,
+                                   Solver::OdeSolver::ComputeRootsFunction pComputeRoots)
+{
+    // Keep track of what we need to compute our roots
+
+    mRootsRates = pRootsRates;
+
+    mComputeRoots = pComputeRoots;
+}
+
+//==============================================================================
+
+double * CvodeSolverUserData::rootsRates() const
+{
+    // Return our roots rates, i.e. the (dummy) rates that we use when computing
+    // our roots
+
+    return mRootsRates;
+}
+
+//==============================================================================
+
+Solver::OdeSolver::ComputeRootsFunction CvodeSolverUserData::computeRoots() const
+{
+    // Return our compute roots function
+
+    return mComputeRoots;
+}
+
+//==============================================================================
+
+void CvodeSolverUserData::setJacobian(CvodeSolverJacobian *pJacobian)
+{
+    // Keep track of our Jacobian
+
+    mJacobian = pJacobian;
+}
+
+//==============================================================================
+
+CvodeSolverJacobian * CvodeSolverUserData::jacobian() const
+{
+    // Return our Jacobian
+
+    return mJacobian;
+}
+
+//==============================================================================
+
 CvodeSolver::~CvodeSolver()
 {
     // Make sure that the solver has been initialised
@@ -129,9 +540,46 @@ CvodeSolver::~CvodeSolver()
     SUNNonlinSolFree(mNonLinearSolver);
     SUNMatDestroy(mMatrix);
 
+    if (mSensitivitiesVectors != nullptr) {
+        for (int i = 0, iMax = mSensitivityConstants.count(); i < iMax; ++i) {
+            N_VDestroy_Serial(mSensitivitiesVectors[i]);
+        }
+
+        SUNNonlinSolFree(mSensitivitiesNonLinearSolver);
+    }
+
     CVodeFree(&mSolver);
 
+    delete mJacobian;
     delete mUserData;
+
+    delete[] mSensitivitiesVectors;
+    delete[] mSensitivityScalingFactors;
+    delete[] mSensitivityDeltas;
+    delete[] mPerturbedConstants;
+    delete[] mPerturbedAlgebraic;
+    delete[] mSensitivityRates;
+    delete[] mSensitivityStates;
+    delete[] mRootsRates;
+
+    if (mPreEventStatesVector != nullptr) {
+        N_VDestroy_Serial(mPreEventStatesVector);
+    }
+
+    delete[] mPreEventRates;
+    delete[] mPostEventRates;
+}
+
+//==============================================================================
+
+Solver::NlaSolver * CvodeSolver::nlaSolver(Solver::NlaSolver *pNlaSolver)
+{
+    // Keep track of whether our model has NLA systems, and use the given NLA
+    // solver as is
+
+    mNeedNlaSolver = pNlaSolver != nullptr;
+
+    return pNlaSolver;
 }
 
 //==============================================================================
@@ -141,6 +589,16 @@ void CvodeSolver::initialize(double pVoi, int pRatesStatesCount,
                              double *pStates, double *pAlgebraic,
                              ComputeRatesFunction pComputeRates)
 {
+    // Make sure that we know how many algebraic variables there are, if we are
+    // to compute some sensitivities, since the RHS function of our
+    // sensitivities uses its own copies of them
+
+    if (!mSensitivityConstants.isEmpty() && (mAlgebraicCount < 0)) {
+        emit error(tr("the number of algebraic variables must be known to compute sensitivities"));
+
+        return;
+    }
+
     // Retrieve our properties
 
     double maximumStep = MaximumStepDefaultValue;
@@ -153,6 +611,7 @@ void CvodeSolver::initialize(double pVoi, int pRatesStatesCount,
     int lowerHalfBandwidth = LowerHalfBandwidthDefaultValue;
     double relativeTolerance = RelativeToleranceDefaultValue;
     double absoluteTolerance = AbsoluteToleranceDefaultValue;
+    int threadsCount = ThreadsCountDefaultValue;
 
     if (mProperties.contains(MaximumStepId)) {
         maximumStep = mProperties.value(MaximumStepId).toDouble();
@@ -284,6 +743,14 @@ void CvodeSolver::initialize(double pVoi, int pRatesStatesCount,
         return;
     }
 
+    if (mProperties.contains(ThreadsCountId)) {
+        threadsCount = mProperties.value(ThreadsCountId).toInt();
+    } else {
+        emit error(tr(R"(the "Number of threads" property value could not be retrieved)"));
+
+        return;
+    }
+
     // Initialise our ODE solver
 
     OdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates, pStates,
@@ -364,6 +831,28 @@ void CvodeSolver::initialize(double pVoi, int pRatesStatesCount,
                 CVodeSetLinearSolver(mSolver, mLinearSolver, mMatrix);
             }
         }
+
+        // Compute our dense/banded Jacobian using several threads, if
+        // requested
+        // Note #1: our NLA solver, if any, is specific to the thread in which
+        //          we are run, so we can only compute our rates in other
+        //          threads if our model doesn't have NLA systems...
+        // Note #2: each thread needs its own copy of our algebraic variables,
+        //          so we can only compute our rates in other threads if we know
+        //          how many of them there are...
+
+        if (   (mMatrix != nullptr) && (threadsCount > 1) && !mNeedNlaSolver
+            && (mAlgebraicCount >= 0)) {
+            mJacobian = new CvodeSolverJacobian(mSolver, mMatrix,
+                                                pRatesStatesCount,
+                                                mAlgebraicCount, threadsCount,
+                                                pConstants, pAlgebraic,
+                                                pComputeRates);
+
+            mUserData->setJacobian(mJacobian);
+
+            CVodeSetJacFn(mSolver, jacobianFunction);
+        }
     } else {
         mNonLinearSolver = SUNNonlinSol_FixedPoint(mStatesVector, 0);
 
@@ -373,6 +862,78 @@ void CvodeSolver::initialize(double pVoi, int pRatesStatesCount,
     // Set our relative and absolute tolerances
 
     CVodeSStolerances(mSolver, relativeTolerance, absoluteTolerance);
+
+    // Compute the sensitivities of our states with respect to some constants,
+    // if needed
+    // Note #1: we compute the RHS function of our sensitivities ourselves
+    //          rather than let CVODES do it since the constants with respect to
+    //          which we want our sensitivities may be used to compute some
+    //          computed constants, something that CVODES cannot know about...
+    // Note #2: the sensitivities are wrapped rather than copied, meaning that
+    //          CVODES uses (and updates) them directly...
+    // Note #3: we scale the error control of our sensitivities using the
+    //          magnitude of their constant, unless it is zero...
+
+    if (!mSensitivityConstants.isEmpty()) {
+        int sensitivitiesCount = mSensitivityConstants.count();
+
+        mSensitivitiesVectors = new N_Vector[sensitivitiesCount];
+        mSensitivityScalingFactors = new double[sensitivitiesCount];
+        mSensitivityDeltas = new double[sensitivitiesCount]{};
+        mPerturbedConstants = new double[sensitivitiesCount*mConstantsCount]{};
+        mPerturbedAlgebraic = new double[sensitivitiesCount*mAlgebraicCount]{};
+        mSensitivityRates = new double[pRatesStatesCount]{};
+        mSensitivityStates = new double[pRatesStatesCount]{};
+
+        for (int i = 0; i < sensitivitiesCount; ++i) {
+            double constant = pConstants[mSensitivityConstants[i]];
+
+            mSensitivitiesVectors[i] = N_VMake_Serial(pRatesStatesCount, mSensitivities+i*pRatesStatesCount);
+            mSensitivityScalingFactors[i] = (constant != 0.0)?qAbs(constant):1.0;
+        }
+
+        mUserData->setSensitivities(mSensitivityDeltas,
+                                    mPerturbedConstants, mConstantsCount,
+                                    mPerturbedAlgebraic, mAlgebraicCount);
+
+        updatePerturbedConstants(pVoi);
+
+        CVodeSensInit1(mSolver, sensitivitiesCount, CV_STAGGERED,
+                       sensitivitiesRhsFunction, mSensitivitiesVectors);
+        CVodeSetSensParams(mSolver, nullptr, mSensitivityScalingFactors, nullptr);
+        CVodeSensEEtolerances(mSolver);
+        CVodeSetSensErrCon(mSolver, SUNTRUE);
+
+        // Use a fixed-point non-linear solver for our sensitivities if we use
+        // one for our states (CVODES would otherwise default to a Newton one,
+        // which requires a linear solver)
+
+        if (!newtonIteration) {
+            mSensitivitiesNonLinearSolver = SUNNonlinSol_FixedPointSens(sensitivitiesCount, mStatesVector, 0);
+
+            CVodeSetNonlinearSolverSensStg(mSolver, mSensitivitiesNonLinearSolver);
+        }
+    }
+
+    // Locate the roots of our model, if any
+
+    if (mRootsCount != 0) {
+        mRootsRates = new double[pRatesStatesCount];
+
+        mUserData->setRoots(mRootsRates, mComputeRoots);
+
+        CVodeRootInit(mSolver, mRootsCount, rootsFunction);
+
+        // Keep track of what we need to determine whether our rates are
+        // discontinuous at an event
+
+        mPreEventStatesVector = N_VNew_Serial(pRatesStatesCount);
+        mPreEventRates = new double[pRatesStatesCount];
+        mPostEventRates = new double[pRatesStatesCount];
+
+        mRelativeTolerance = relativeTolerance;
+        mAbsoluteTolerance = absoluteTolerance;
+    }
 }
 
 //==============================================================================
@@ -381,22 +942,123 @@ void CvodeSolver::reinitialize(double pVoi)
 {
     // Reinitialise our CVODES object
 
+    reinitializeCvodes(pVoi);
+}
+
+//==============================================================================
+
+void CvodeSolver::reinitializeCvodes(double pVoi) const
+{
+    // Keep track of our current statistics since reinitialising our CVODES
+    // object will reset its counters (and we reset those of our Jacobian)
+    // Note: we may be called from solve(), when handling an event, hence we are
+    //       const and only update mutable data and data that we don't own...
+
+    Statistics counters = currentStatistics();
+
+    for (auto counter = counters.constBegin(), counterEnd = counters.constEnd();
+         counter != counterEnd; ++counter) {
+        mPreviousStatistics[counter.key()] += counter.value();
+    }
+
+    // Reinitialise our CVODES object
+
     CVodeReInit(mSolver, pVoi, mStatesVector);
+
+    if (mJacobian != nullptr) {
+        mJacobian->resetRhsEvaluationsCount();
+    }
+
+    if (mSensitivitiesVectors != nullptr) {
+        CVodeSensReInit(mSolver, CV_STAGGERED, mSensitivitiesVectors);
+
+        // Our constants may have been modified (e.g. while our simulation was
+        // paused), so update our perturbed constants
+
+        updatePerturbedConstants(pVoi);
+    }
 }
 
 //==============================================================================
 
-void CvodeSolver::solve(double &pVoi, double pVoiEnd) const
+void CvodeSolver::updatePerturbedConstants(double pVoi) const
 {
-    // Solve the model
+    // Update our perturbed constants, i.e. a copy of our constants for each of
+    // our sensitivity constants, in which that constant is perturbed and our
+    // computed constants (and the algebraic variables they may compute) are
+    // recomputed accordingly
+    // Note: computing our computed constants may also compute the initial
+    //       value of some rates and states, hence we use scratch arrays for
+    //       them...
+
+    static const double SqrtEpsilon = qSqrt(std::numeric_limits<double>::epsilon());
+
+    for (int i = 0, iMax = mSensitivityConstants.count(); i < iMax; ++i) {
+        int constantIndex = mSensitivityConstants[i];
+        double constant = mConstants[constantIndex];
+        double *perturbedConstants = mPerturbedConstants+i*mConstantsCount;
+        double *perturbedAlgebraic = mPerturbedAlgebraic+i*mAlgebraicCount;
 
-    if (!mInterpolateSolution) {
-        CVodeSetStopTime(mSolver, pVoiEnd);
+        mSensitivityDeltas[i] = SqrtEpsilon*((constant != 0.0)?qAbs(constant):1.0);
+
+        memcpy(perturbedConstants, mConstants, size_t(mConstantsCount)*Solver::SizeOfDouble);
+        memcpy(perturbedAlgebraic, mAlgebraic, size_t(mAlgebraicCount)*Solver::SizeOfDouble);
+
+        perturbedConstants[constantIndex] = constant+mSensitivityDeltas[i];
+
+        mComputeComputedConstants(pVoi, perturbedConstants, mSensitivityRates,
+                                  mSensitivityStates, perturbedAlgebraic);
     }
+}
+
+//==============================================================================
+
+void CvodeSolver::solve(double &pVoi, double pVoiEnd) const
+{
+    // Solve the model, stopping at each event, if any, i.e. where one of our
+    // roots was located
+    // Note #1: an event may correspond to a discontinuity in our rates, in
+    //          which case we reinitialise CVODES to prevent it from using its
+    //          step size and order history across it. If our rates are
+    //          continuous at the event (e.g. a piecewise expression which
+    //          pieces have the same value at the event), then we carry on as
+    //          normal...
+    // Note #2: reinitialising CVODES unsets our stop time, hence we (re)set it
+    //          before each call to CVode()...
+    // Note #3: our sensitivities, if any, must be retrieved before
+    //          reinitialising CVODES since they are then used as initial
+    //          sensitivities...
+
+    forever {
+        if (!mInterpolateSolution) {
+            CVodeSetStopTime(mSolver, pVoiEnd);
+        }
+
+        int flag = CVode(mSolver, pVoiEnd, mStatesVector, &pVoi, CV_NORMAL);
+
+        if (mSensitivitiesVectors != nullptr) {
+            double voi;
+
+            CVodeGetSens(mSolver, &voi, mSensitivitiesVectors);
+        }
+
+        if (flag != CV_ROOT_RETURN) {
+            break;
+        }
+
+        mEvents << pVoi;
+
+        if (discontinuousRates(pVoi)) {
+            reinitializeCvodes(pVoi);
+        }
 
-    CVode(mSolver, pVoiEnd, mStatesVector, &pVoi, CV_NORMAL);
+        if (qFuzzyCompare(pVoi, pVoiEnd)) {
+            break;
+        }
+    }
 
     // Compute the rates one more time to get up to date values for the rates
+    // (and for the algebraic variables on which they depend)
     // Note: another way of doing this would be to copy the contents of the
     //       calculated rates in rhsFunction, but that's bound to be more time
     //       consuming since a call to CVode() is likely to generate at least a
@@ -405,10 +1067,155 @@ void CvodeSolver::solve(double &pVoi, double pVoiEnd) const
 
     mComputeRates(pVoiEnd, mConstants, mRates,
                   N_VGetArrayPointer_Serial(mStatesVector), mAlgebraic);
+
+    ++mRhsEvaluationsCount;
 }
 
 //==============================================================================
 
+bool CvodeSolver::supportsSensitivities() const
+{
+    // We support sensitivities
+
+    return true;
+}
+
+//==============================================================================
+
+CvodeSolver::Statistics CvodeSolver::statistics() const
+{
+    // Return our statistics, i.e. those we had before our last
+    // reinitialisation, if any, and our current ones
+
+    Statistics res = mPreviousStatistics;
+
+    Statistics counters = currentStatistics();
+
+    for (auto counter = counters.constBegin(), counterEnd = counters.constEnd();
+         counter != counterEnd; ++counter) {
+        res[counter.key()] += counter.value();
+    }
+
+    res[Solver::RhsEvaluationsStatistic] += mRhsEvaluationsCount;
+
+    if (mRootsCount != 0) {
+        res.insert(Solver::EventsStatistic, quint64(mEvents.count()));
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+CvodeSolver::Statistics CvodeSolver::currentStatistics() const
+{
+    // Retrieve CVODES' counters, which are reset each time we reinitialise our
+    // CVODES object, adding the RHS evaluations of our Jacobian, if any, to
+    // those of CVODES
+    // Note: we use the linear solver counters only if we actually have a
+    //       (non-diagonal) linear solver...
+
+    Statistics res;
+
+    if (mSolver == nullptr) {
+        return res;
+    }
+
+    long int steps = 0;
+    long int rhsEvaluations = 0;
+    long int errorTestFailures = 0;
+    long int nonlinearIterations = 0;
+
+    CVodeGetNumSteps(mSolver, &steps);
+    CVodeGetNumRhsEvals(mSolver, &rhsEvaluations);
+    CVodeGetNumErrTestFails(mSolver, &errorTestFailures);
+    CVodeGetNumNonlinSolvIters(mSolver, &nonlinearIterations);
+
+    res.insert(Solver::StepsStatistic, quint64(steps));
+    res.insert(Solver::RhsEvaluationsStatistic,
+               quint64(rhsEvaluations)
+              +((mJacobian != nullptr)?mJacobian->rhsEvaluationsCount():0));
+    res.insert(Solver::RejectedStepsStatistic, quint64(errorTestFailures));
+    res.insert(Solver::NonlinearIterationsStatistic, quint64(nonlinearIterations));
+
+    if (mLinearSolver != nullptr) {
+        long int jacobianEvaluations = 0;
+        long int linearSolverSetups = 0;
+        long int linearIterations = 0;
+
+        CVodeGetNumJacEvals(mSolver, &jacobianEvaluations);
+        CVodeGetNumLinSolvSetups(mSolver, &linearSolverSetups);
+        CVodeGetNumLinIters(mSolver, &linearIterations);
+
+        res.insert(Solver::JacobianEvaluationsStatistic, quint64(jacobianEvaluations));
+        res.insert(Solver::LinearSolverSetupsStatistic, quint64(linearSolverSetups));
+        res.insert(Solver::LinearIterationsStatistic, quint64(linearIterations));
+    }
+
+    if (mRootsCount != 0) {
+        long int rootEvaluations = 0;
+
+        CVodeGetNumGEvals(mSolver, &rootEvaluations);
+
+        res.insert(Solver::RootEvaluationsStatistic, quint64(rootEvaluations));
+    }
+
+    if (mSensitivitiesVectors != nullptr) {
+        long int sensitivityRhsEvaluations = 0;
+
+        CVodeGetSensNumRhsEvals(mSolver, &sensitivityRhsEvaluations);
+
+        res.insert(Solver::SensitivityRhsEvaluationsStatistic, quint64(sensitivityRhsEvaluations));
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+bool CvodeSolver::discontinuousRates(double pVoi) const
+{
+    // Determine whether our rates are discontinuous at the given event, i.e.
+    // whether they differ, beyond our tolerances, just before the event and at
+    // the event
+    // Note #1: CVODES returns our states just past the root it located, so we
+    //          use its interpolating polynomial to get our states just before
+    //          it. The interval we use is well beyond the precision with which
+    //          CVODES locates a root, yet small enough for continuous rates to
+    //          remain within our tolerances...
+    // Note #2: computing our rates also updates our algebraic variables, but
+    //          this doesn't matter since they get recomputed at the end of
+    //          solve()...
+
+    static const double Epsilon = std::numeric_limits<double>::epsilon();
+
+    double lastStep = 0.0;
+
+    CVodeGetLastStep(mSolver, &lastStep);
+
+    double preEventVoi = pVoi-1000.0*Epsilon*(qAbs(pVoi)+qAbs(lastStep));
+
+    if (CVodeGetDky(mSolver, preEventVoi, 0, mPreEventStatesVector) != CV_SUCCESS) {
+        return true;
+    }
+
+    mComputeRates(preEventVoi, mConstants, mPreEventRates,
+                  N_VGetArrayPointer_Serial(mPreEventStatesVector), mAlgebraic);
+    mComputeRates(pVoi, mConstants, mPostEventRates,
+                  N_VGetArrayPointer_Serial(mStatesVector), mAlgebraic);
+
+    mRhsEvaluationsCount += 2;
+
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        if (  qAbs(mPostEventRates[i]-mPreEventRates[i])
+            > mRelativeTolerance*qMax(qAbs(mPreEventRates[i]), qAbs(mPostEventRates[i]))+mAbsoluteTolerance) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 } // namespace CVODESolver
 } // namespace OpenCOR
 
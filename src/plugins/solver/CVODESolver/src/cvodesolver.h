@@ -29,6 +29,11 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QRunnable>
+#include <QThreadPool>
+
+//==============================================================================
+
 #include "sundialsbegin.h"
     #include "nvector/nvector_serial.h"
     #include "sundials/sundials_linearsolver.h"
@@ -54,6 +59,7 @@ static const auto LowerHalfBandwidthId   = QStringLiteral("LowerHalfBandwidth");
 static const auto RelativeToleranceId    = QStringLiteral("RelativeTolerance");
 static const auto AbsoluteToleranceId    = QStringLiteral("AbsoluteTolerance");
 static const auto InterpolateSolutionId  = QStringLiteral("InterpolateSolution");
+static const auto ThreadsCountId         = QStringLiteral("ThreadsCount");
 
 //==============================================================================
 
@@ -108,6 +114,97 @@ static const double AbsoluteToleranceDefaultValue = 1.0e-7;
 
 static const bool InterpolateSolutionDefaultValue = true;
 
+enum {
+    ThreadsCountDefaultValue = 1
+};
+
+//==============================================================================
+
+class CvodeSolverJacobian;
+
+class CvodeSolverJacobianWorker : public QRunnable
+{
+public:
+    explicit CvodeSolverJacobianWorker(CvodeSolverJacobian *pJacobian,
+                                       int pIndex, int pRatesStatesCount,
+                                       int pAlgebraicCount);
+    ~CvodeSolverJacobianWorker() override;
+
+    void run() override;
+
+private:
+    CvodeSolverJacobian *mJacobian;
+
+    int mIndex;
+
+    double *mStates;
+    double *mRates;
+    double *mAlgebraic;
+};
+
+//==============================================================================
+// Note: we compute a dense or banded Jacobian using the same difference
+//       quotients as CVODES, except that they are spread over several
+//       threads (and that our minimum increment may differ from that of
+//       CVODES while it retries a step, see CvodeSolverJacobian::compute()).
+//       In the dense case, each column requires its own evaluation of our
+//       rates while, in the banded case, columns that are more than our
+//       bandwidth apart don't overlap and can therefore share an evaluation of
+//       our rates. Either way, a thread takes care of every n-th group of
+//       columns, with n our number of threads...
+
+class CvodeSolverJacobian
+{
+public:
+    explicit CvodeSolverJacobian(void *pSolver, SUNMatrix pMatrix,
+                                 int pRatesStatesCount, int pAlgebraicCount,
+                                 int pThreadsCount,
+                                 double *pConstants, double *pAlgebraic,
+                                 Solver::OdeSolver::ComputeRatesFunction pComputeRates);
+    ~CvodeSolverJacobian();
+
+    void compute(double pVoi, N_Vector pStates, N_Vector pRates,
+                 SUNMatrix pJacobian);
+
+    void computeColumns(int pIndex, double *pStates, double *pRates,
+                        double *pAlgebraic) const;
+
+    quint64 rhsEvaluationsCount() const;
+    void resetRhsEvaluationsCount();
+
+private:
+    void *mSolver;
+
+    int mRatesStatesCount;
+    int mAlgebraicCount;
+
+    double *mConstants;
+    double *mAlgebraic;
+
+    Solver::OdeSolver::ComputeRatesFunction mComputeRates;
+
+    bool mBanded = false;
+
+    int mUpperHalfBandwidth = 0;
+    int mLowerHalfBandwidth = 0;
+    int mGroupsCount;
+
+    N_Vector mErrorWeightsVector;
+    double *mErrorWeights;
+
+    QThreadPool mThreadPool;
+    QVector<CvodeSolverJacobianWorker *> mWorkers;
+
+    double mVoi = 0.0;
+    double *mStates = nullptr;
+    double *mRates = nullptr;
+    double mMinimumIncrement = 0.0;
+
+    SUNMatrix mJacobian = nullptr;
+
+    quint64 mRhsEvaluationsCount = 0;
+};
+
 //==============================================================================
 
 class CvodeSolverUserData
@@ -121,11 +218,42 @@ public:
 
     Solver::OdeSolver::ComputeRatesFunction computeRates() const;
 
+    void setSensitivities(const double *pSensitivityDeltas,
+                          double *pPerturbedConstants, int pConstantsCount,
+                          double *pPerturbedAlgebraic, int pAlgebraicCount);
+
+    double sensitivityDelta(int pIndex) const;
+    double * perturbedConstants(int pIndex) const;
+    double * perturbedAlgebraic(int pIndex) const;
+
+    void setRoots(double *pRootsRates,
+                  Solver::OdeSolver::ComputeRootsFunction pComputeRoots);
+
+    double * rootsRates() const;
+
+    Solver::OdeSolver::ComputeRootsFunction computeRoots() const;
+
+    void setJacobian(CvodeSolverJacobian *pJacobian);
+
+    CvodeSolverJacobian * jacobian() const;
+
 private:
     double *mConstants;
     double *mAlgebraic;
 
     Solver::OdeSolver::ComputeRatesFunction mComputeRates;
+
+    const double *mSensitivityDeltas = nullptr;
+    double *mPerturbedConstants = nullptr;
+    int mConstantsCount = 0;
+    double *mPerturbedAlgebraic = nullptr;
+    int mAlgebraicCount = 0;
+
+    double *mRootsRates = nullptr;
+
+    Solver::OdeSolver::ComputeRootsFunction mComputeRoots = nullptr;
+
+    CvodeSolverJacobian *mJacobian = nullptr;
 };
 
 //==============================================================================
@@ -137,6 +265,8 @@ class CvodeSolver : public OpenCOR::Solver::OdeSolver
 public:
     ~CvodeSolver() override;
 
+    Solver::NlaSolver * nlaSolver(Solver::NlaSolver *pNlaSolver) override;
+
     void initialize(double pVoi, int pRatesStatesCount, double *pConstants,
                     double *pRates, double *pStates, double *pAlgebraic,
                     ComputeRatesFunction pComputeRates) override;
@@ -144,6 +274,10 @@ public:
 
     void solve(double &pVoi, double pVoiEnd) const override;
 
+    bool supportsSensitivities() const override;
+
+    Statistics statistics() const override;
+
 private:
     void *mSolver = nullptr;
 
@@ -153,9 +287,42 @@ private:
     SUNLinearSolver mLinearSolver = nullptr;
     SUNNonlinearSolver mNonLinearSolver = nullptr;
 
+    N_Vector *mSensitivitiesVectors = nullptr;
+    double *mSensitivityScalingFactors = nullptr;
+    double *mSensitivityDeltas = nullptr;
+    double *mPerturbedConstants = nullptr;
+    double *mPerturbedAlgebraic = nullptr;
+    double *mSensitivityRates = nullptr;
+    double *mSensitivityStates = nullptr;
+
+    SUNNonlinearSolver mSensitivitiesNonLinearSolver = nullptr;
+
+    double *mRootsRates = nullptr;
+
+    N_Vector mPreEventStatesVector = nullptr;
+    double *mPreEventRates = nullptr;
+    double *mPostEventRates = nullptr;
+
+    double mRelativeTolerance = RelativeToleranceDefaultValue;
+    double mAbsoluteTolerance = AbsoluteToleranceDefaultValue;
+
+    bool mNeedNlaSolver = false;
+
+    CvodeSolverJacobian *mJacobian = nullptr;
+
     CvodeSolverUserData *mUserData = nullptr;
 
     bool mInterpolateSolution = InterpolateSolutionDefaultValue;
+
+    mutable Statistics mPreviousStatistics;
+
+    Statistics currentStatistics() const;
+
+    void reinitializeCvodes(double pVoi) const;
+
+    void updatePerturbedConstants(double pVoi) const;
+
+    bool discontinuousRates(double pVoi) const;
 };
 
 //==============================================================================
@@ -84,6 +84,7 @@ QString CVODESolverPlugin::id(const QString &pKisaoId) const
     static const QString Kisao0000209 = "KISAO:0000209";
     static const QString Kisao0000211 = "KISAO:0000211";
     static const QString Kisao0000481 = "KISAO:0000481";
+    static const QString Kisao0000529 = "KISAO:0000529";
 
     if (pKisaoId == Kisao0000019) {
         return solverName();
@@ -133,6 +134,10 @@ QString CVODESolverPlugin::id(const QString &pKisaoId) const
         return InterpolateSolutionId;
     }
 
+    if (pKisaoId == Kisao0000529) {
+        return ThreadsCountId;
+    }
+
     return {};
 }
 
@@ -190,6 +195,10 @@ QString CVODESolverPlugin::kisaoId(const QString &pId) const
         return "KISAO:0000481";
     }
 
+    if (pId == ThreadsCountId) {
+        return "KISAO:0000529";
+    }
+
     return {};
 }
 
@@ -228,6 +237,7 @@ Solver::Properties CVODESolverPlugin::solverProperties() const
     Descriptions RelativeToleranceDescriptions;
     Descriptions AbsoluteToleranceDescriptions;
     Descriptions InterpolateSolutionDescriptions;
+    Descriptions ThreadsCountDescriptions;
 
     MaximumStepDescriptions.insert("en", QString::fromUtf8("Maximum step"));
     MaximumStepDescriptions.insert("fr", QString::fromUtf8("Pas maximum"));
@@ -262,6 +272,9 @@ Solver::Properties CVODESolverPlugin::solverProperties() const
     InterpolateSolutionDescriptions.insert("en", QString::fromUtf8("Interpolate solution"));
     InterpolateSolutionDescriptions.insert("fr", QString::fromUtf8("Interpoler solution"));
 
+    ThreadsCountDescriptions.insert("en", QString::fromUtf8("Number of threads"));
+    ThreadsCountDescriptions.insert("fr", QString::fromUtf8("Nombre de threads"));
+
     QStringList IntegrationMethodListValues = { AdamsMoultonMethod, BdfMethod };
 
     QStringList IterationTypeListValues = { FunctionalIteration,
@@ -287,7 +300,8 @@ Solver::Properties CVODESolverPlugin::solverProperties() const
              Solver::Property(Solver::Property::Type::IntegerGe0, LowerHalfBandwidthId, LowerHalfBandwidthDescriptions, {}, LowerHalfBandwidthDefaultValue, false),
              Solver::Property(Solver::Property::Type::DoubleGe0, RelativeToleranceId, RelativeToleranceDescriptions, {}, RelativeToleranceDefaultValue, false),
              Solver::Property(Solver::Property::Type::DoubleGt0, AbsoluteToleranceId, AbsoluteToleranceDescriptions, {}, AbsoluteToleranceDefaultValue, false),
-             Solver::Property(Solver::Property::Type::Boolean, InterpolateSolutionId, InterpolateSolutionDescriptions, {}, InterpolateSolutionDefaultValue, false) };
+             Solver::Property(Solver::Property::Type::Boolean, InterpolateSolutionId, InterpolateSolutionDescriptions, {}, InterpolateSolutionDefaultValue, false),
+             Solver::Property(Solver::Property::Type::IntegerGt0, ThreadsCountId, ThreadsCountDescriptions, {}, ThreadsCountDefaultValue, false) };
 }
 
 //==============================================================================
@@ -313,16 +327,19 @@ QMap<QString, bool> CVODESolverPlugin::solverPropertiesVisibility(const QMap<QSt
             res.insert(PreconditionerId, false);
             res.insert(UpperHalfBandwidthId, false);
             res.insert(LowerHalfBandwidthId, false);
+            res.insert(ThreadsCountId, linearSolver == DenseLinearSolver);
         } else if (linearSolver == BandedLinearSolver) {
             // Banded linear solver
 
             res.insert(PreconditionerId, false);
             res.insert(UpperHalfBandwidthId, true);
             res.insert(LowerHalfBandwidthId, true);
+            res.insert(ThreadsCountId, true);
         } else {
             // GMRES/Bi-CGStab/TFQMR linear solver
 
             res.insert(PreconditionerId, true);
+            res.insert(ThreadsCountId, false);
 
             if (pSolverPropertiesValues.value(PreconditionerId) == BandedPreconditioner) {
                 // Banded preconditioner
@@ -343,6 +360,7 @@ QMap<QString, bool> CVODESolverPlugin::solverPropertiesVisibility(const QMap<QSt
         res.insert(PreconditionerId, false);
         res.insert(UpperHalfBandwidthId, false);
         res.insert(LowerHalfBandwidthId, false);
+        res.insert(ThreadsCountId, false);
     }
 
     return res;
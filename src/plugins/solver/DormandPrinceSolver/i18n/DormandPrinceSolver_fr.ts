@@ -0,0 +1,35 @@
+<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="fr_FR" sourcelanguage="en_GB">
+<context>
+    <name>OpenCOR::DormandPrinceSolver::DormandPrinceSolver</name>
+    <message>
+        <source>the &quot;Relative tolerance&quot; property value could not be retrieved</source>
+        <translation>la valeur de la propriété &quot;Tolérance relative&quot; n&apos;a pas pu être retrouvée</translation>
+    </message>
+    <message>
+        <source>the &quot;Absolute tolerance&quot; property value could not be retrieved</source>
+        <translation>la valeur de la propriété &quot;Tolérance absolue&quot; n&apos;a pas pu être retrouvée</translation>
+    </message>
+    <message>
+        <source>the &quot;Maximum step&quot; property value could not be retrieved</source>
+        <translation>la valeur de la propriété &quot;Pas maximum&quot; n&apos;a pas pu être retrouvée</translation>
+    </message>
+    <message>
+        <source>the &quot;Maximum number of steps&quot; property value could not be retrieved</source>
+        <translation>la valeur de la propriété &quot;Nombre maximum de pas&quot; n&apos;a pas pu être retrouvée</translation>
+    </message>
+    <message>
+        <source>the &quot;Interpolate solution&quot; property value could not be retrieved</source>
+        <translation>la valeur de la propriété &quot;Interpoler solution&quot; n&apos;a pas pu être retrouvée</translation>
+    </message>
+    <message>
+        <source>the maximum number of steps (%1) was taken before reaching %2</source>
+        <translation>le nombre maximum de pas (%1) a été effectué avant d&apos;atteindre %2</translation>
+    </message>
+    <message>
+        <source>the step became too small at %1</source>
+        <translation>le pas est devenu trop petit à %1</translation>
+    </message>
+</context>
+</TS>
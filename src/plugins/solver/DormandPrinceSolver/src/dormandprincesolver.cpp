@@ -0,0 +1,549 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+//==============================================================================
+// Dormand-Prince solver
+//==============================================================================
+
+#include "dormandprincesolver.h"
+
+//==============================================================================
+
+#include <QtMath>
+
+//==============================================================================
+
+#include <limits>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace DormandPrinceSolver {
+
+//==============================================================================
+
+DormandPrinceSolver::~DormandPrinceSolver()
+{
+    // Delete some internal objects
+
+    deleteArrays();
+}
+
+//==============================================================================
+
+void DormandPrinceSolver::initialize(double pVoi, int pRatesStatesCount,
+                                     double *pConstants, double *pRates,
+                                     double *pStates, double *pAlgebraic,
+                                     ComputeRatesFunction pComputeRates)
+{
+    // Retrieve our properties
+
+    if (mProperties.contains(RelativeToleranceId)) {
+        mRelativeTolerance = mProperties.value(RelativeToleranceId).toDouble();
+    } else {
+        emit error(tr(R"(the "Relative tolerance" property value could not be retrieved)"));
+
+        return;
+    }
+
+    if (mProperties.contains(AbsoluteToleranceId)) {
+        mAbsoluteTolerance = mProperties.value(AbsoluteToleranceId).toDouble();
+    } else {
+        emit error(tr(R"(the "Absolute tolerance" property value could not be retrieved)"));
+
+        return;
+    }
+
+    if (mProperties.contains(MaximumStepId)) {
+        mMaximumStep = mProperties.value(MaximumStepId).toDouble();
+    } else {
+        emit error(tr(R"(the "Maximum step" property value could not be retrieved)"));
+
+        return;
+    }
+
+    if (mProperties.contains(MaximumNumberOfStepsId)) {
+        mMaximumNumberOfSteps = mProperties.value(MaximumNumberOfStepsId).toInt();
+    } else {
+        emit error(tr(R"(the "Maximum number of steps" property value could not be retrieved)"));
+
+        return;
+    }
+
+    if (mProperties.contains(InterpolateSolutionId)) {
+        mInterpolateSolution = mProperties.value(InterpolateSolutionId).toBool();
+    } else {
+        emit error(tr(R"(the "Interpolate solution" property value could not be retrieved)"));
+
+        return;
+    }
+
+    // Initialise the ODE solver itself
+
+    OdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates, pStates,
+                          pAlgebraic, pComputeRates);
+
+    // (Re)create our various arrays
+
+    deleteArrays();
+
+    mY = new double[pRatesStatesCount] {};
+    mYNew = new double[pRatesStatesCount] {};
+    mYStage = new double[pRatesStatesCount] {};
+
+    for (auto &k : mK) {
+        k = new double[pRatesStatesCount] {};
+    }
+
+    for (auto &denseCoefficients : mDenseCoefficients) {
+        denseCoefficients = new double[pRatesStatesCount] {};
+    }
+
+    // Start our integration from our current point
+
+    reinitialize(pVoi);
+}
+
+//==============================================================================
+
+void DormandPrinceSolver::reinitialize(double pVoi)
+{
+    // (Re)start our integration from the given point and our current states
+    // Note: the model may have been modified in a way that our step size and
+    //       our rates don't reflect anymore, so we will recompute them the next
+    //       time we are asked to solve our model...
+
+    mVoi = mPreviousVoi = pVoi;
+
+    memcpy(mY, mStates, size_t(mRatesStatesCount)*Solver::SizeOfDouble);
+
+    mStarted = false;
+    mPreviousErrorNorm = 1.0e-4;
+    mPreviousStepRejected = false;
+}
+
+//==============================================================================
+
+void DormandPrinceSolver::solve(double &pVoi, double pVoiEnd) const
+{
+    // The Dormand-Prince 5(4) method, as implemented in Hairer's DOPRI5, i.e.:
+    //  - a fifth-order solution with an embedded fourth-order one to estimate
+    //    our local error, which we use to adapt our step;
+    //  - a 'First Same As Last' (FSAL) method, i.e. k7 is evaluated at our new
+    //    solution and is therefore k1 for our next step, meaning that a step
+    //    requires only six evaluations of our rates; and
+    //  - a continuous extension of our solution, so that we don't need to stop
+    //    at pVoiEnd, but can interpolate our solution instead.
+    // Note: unlike our fixed-step solvers, we keep track of our own solution,
+    //       and therefore only update mStates and mRates for pVoiEnd...
+
+    static const double C2 = 1.0/5.0;
+    static const double C3 = 3.0/10.0;
+    static const double C4 = 4.0/5.0;
+    static const double C5 = 8.0/9.0;
+
+    static const double A21 = 1.0/5.0;
+    static const double A31 = 3.0/40.0;
+    static const double A32 = 9.0/40.0;
+    static const double A41 = 44.0/45.0;
+    static const double A42 = -56.0/15.0;
+    static const double A43 = 32.0/9.0;
+    static const double A51 = 19372.0/6561.0;
+    static const double A52 = -25360.0/2187.0;
+    static const double A53 = 64448.0/6561.0;
+    static const double A54 = -212.0/729.0;
+    static const double A61 = 9017.0/3168.0;
+    static const double A62 = -355.0/33.0;
+    static const double A63 = 46732.0/5247.0;
+    static const double A64 = 49.0/176.0;
+    static const double A65 = -5103.0/18656.0;
+    static const double A71 = 35.0/384.0;
+    static const double A73 = 500.0/1113.0;
+    static const double A74 = 125.0/192.0;
+    static const double A75 = -2187.0/6784.0;
+    static const double A76 = 11.0/84.0;
+
+    static const double E1 = 71.0/57600.0;
+    static const double E3 = -71.0/16695.0;
+    static const double E4 = 71.0/1920.0;
+    static const double E5 = -17253.0/339200.0;
+    static const double E6 = 22.0/525.0;
+    static const double E7 = -1.0/40.0;
+
+    // Step size control parameters, i.e. a safety factor, the bounds of the
+    // factor by which our step can change, and the exponents of our PI step
+    // size controller
+
+    static const double Safety = 0.9;
+    static const double MinimumFactor = 0.2;
+    static const double MaximumFactor = 10.0;
+    static const double Beta = 0.04;
+    static const double Exponent = 0.2-0.75*Beta;
+
+    // Start our integration, if needed, i.e. compute our rates and determine
+    // our initial step
+
+    if (!mStarted) {
+        mComputeRates(mVoi, mConstants, mK[0], mY, mAlgebraic);
+
+        ++mRhsEvaluationsCount;
+
+        mStep = initialStep();
+        mStarted = true;
+    }
+
+    // Step through time until we reach pVoiEnd or, if we can interpolate our
+    // solution, until we go past it
+
+    int stepsCount = 0;
+
+    while ((mVoi < pVoiEnd) && !qFuzzyCompare(mVoi, pVoiEnd)) {
+        // Make sure that we haven't taken too many steps
+        // Note: we are in a const method, hence we need to cast away our
+        //       constness to report an error...
+
+        if (stepsCount == mMaximumNumberOfSteps) {
+            const_cast<DormandPrinceSolver *>(this)->emitError(tr("the maximum number of steps (%1) was taken before reaching %2").arg(mMaximumNumberOfSteps).arg(pVoiEnd));
+
+            return;
+        }
+
+        ++stepsCount;
+
+        // Determine our step, making sure that we stop at pVoiEnd if we cannot
+        // interpolate our solution and that we don't go past our ending point
+        // otherwise
+
+        double voiEnd = mInterpolateSolution?mEndingPoint:pVoiEnd;
+        double step = mStep;
+        bool lastStep = mVoi+1.01*step >= voiEnd;
+
+        if (lastStep) {
+            step = voiEnd-mVoi;
+        }
+
+        if (0.1*step <= std::numeric_limits<double>::epsilon()*qAbs(mVoi)) {
+            const_cast<DormandPrinceSolver *>(this)->emitError(tr("the step became too small at %1").arg(mVoi));
+
+            return;
+        }
+
+        // Compute k2, ..., k6
+
+        double *k1 = mK[0];
+        double *k2 = mK[1];
+        double *k3 = mK[2];
+        double *k4 = mK[3];
+        double *k5 = mK[4];
+        double *k6 = mK[5];
+        double *k7 = mK[6];
+
+        for (int i = 0; i < mRatesStatesCount; ++i) {
+            mYStage[i] = mY[i]+step*A21*k1[i];
+        }
+
+        mComputeRates(mVoi+C2*step, mConstants, k2, mYStage, mAlgebraic);
+
+        for (int i = 0; i < mRatesStatesCount; ++i) {
+            mYStage[i] = mY[i]+step*(A31*k1[i]+A32*k2[i]);
+        }
+
+        mComputeRates(mVoi+C3*step, mConstants, k3, mYStage, mAlgebraic);
+
+        for (int i = 0; i < mRatesStatesCount; ++i) {
+            mYStage[i] = mY[i]+step*(A41*k1[i]+A42*k2[i]+A43*k3[i]);
+        }
+
+        mComputeRates(mVoi+C4*step, mConstants, k4, mYStage, mAlgebraic);
+
+        for (int i = 0; i < mRatesStatesCount; ++i) {
+            mYStage[i] = mY[i]+step*(A51*k1[i]+A52*k2[i]+A53*k3[i]+A54*k4[i]);
+        }
+
+        mComputeRates(mVoi+C5*step, mConstants, k5, mYStage, mAlgebraic);
+
+        for (int i = 0; i < mRatesStatesCount; ++i) {
+            mYStage[i] = mY[i]+step*(A61*k1[i]+A62*k2[i]+A63*k3[i]+A64*k4[i]+A65*k5[i]);
+        }
+
+        mComputeRates(mVoi+step, mConstants, k6, mYStage, mAlgebraic);
+
+        // Compute our new solution and k7
+
+        for (int i = 0; i < mRatesStatesCount; ++i) {
+            mYNew[i] = mY[i]+step*(A71*k1[i]+A73*k3[i]+A74*k4[i]+A75*k5[i]+A76*k6[i]);
+        }
+
+        mComputeRates(mVoi+step, mConstants, k7, mYNew, mAlgebraic);
+
+        mRhsEvaluationsCount += 6;
+
+        // Estimate our local error
+
+        for (int i = 0; i < mRatesStatesCount; ++i) {
+            mYStage[i] = step*(E1*k1[i]+E3*k3[i]+E4*k4[i]+E5*k5[i]+E6*k6[i]+E7*k7[i]);
+        }
+
+        double norm = errorNorm(mYStage, mY, mYNew);
+        double errorFactor = qPow(norm, Exponent);
+        double newStep;
+
+        if (norm <= 1.0) {
+            // Our step is accepted, so determine our new step, making sure that
+            // it doesn't increase right after a rejected step
+
+            newStep = step/qMax(1.0/MaximumFactor,
+                                qMin(1.0/MinimumFactor,
+                                     errorFactor/qPow(mPreviousErrorNorm, Beta)/Safety));
+
+            if (mPreviousStepRejected) {
+                newStep = qMin(newStep, step);
+            }
+
+            // Don't let a step that was shortened to reach pVoiEnd (or our
+            // ending point) reduce our next step
+
+            if (lastStep) {
+                newStep = qMax(newStep, mStep);
+            }
+
+            mPreviousErrorNorm = qMax(norm, 1.0e-4);
+            mPreviousStepRejected = false;
+
+            // Advance through time, computing the coefficients of our
+            // continuous extension if we went past pVoiEnd
+
+            mPreviousVoi = mVoi;
+            mVoi = lastStep?voiEnd:mVoi+step;
+
+            if (mInterpolateSolution && (mVoi > pVoiEnd)) {
+                updateDenseCoefficients(step);
+            }
+
+            std::swap(mY, mYNew);
+            std::swap(mK[0], mK[6]);
+
+            // Keep track of our statistics
+
+            ++mStepsCount;
+        } else {
+            // Our step is rejected, so reduce it
+            // Note: our error may not be finite, e.g. if our model blew up...
+
+            newStep = qIsFinite(errorFactor)?
+                          step/qMin(1.0/MinimumFactor, errorFactor/Safety):
+                          MinimumFactor*step;
+
+            mPreviousStepRejected = true;
+
+            // Keep track of our statistics
+
+            ++mRejectedStepsCount;
+        }
+
+        // Update our step, making sure that it doesn't exceed our maximum step,
+        // if any
+
+        mStep = (mMaximumStep > 0.0)?qMin(newStep, mMaximumStep):newStep;
+    }
+
+    // Retrieve our solution at pVoiEnd, either directly (in which case, our
+    // method being FSAL, we already have our rates) or by interpolating it (in
+    // which case we need to compute our rates)
+    // Note: if we retrieve our solution directly without having taken a step,
+    //       then our algebraic variables were last computed for another point,
+    //       so we need to compute our rates too...
+
+    if (qFuzzyCompare(mVoi, pVoiEnd)) {
+        memcpy(mStates, mY, size_t(mRatesStatesCount)*Solver::SizeOfDouble);
+
+        if (stepsCount != 0) {
+            memcpy(mRates, mK[0], size_t(mRatesStatesCount)*Solver::SizeOfDouble);
+        } else {
+            mComputeRates(pVoiEnd, mConstants, mRates, mStates, mAlgebraic);
+
+            ++mRhsEvaluationsCount;
+        }
+    } else {
+        double theta = (pVoiEnd-mPreviousVoi)/(mVoi-mPreviousVoi);
+        double oneMinusTheta = 1.0-theta;
+
+        for (int i = 0; i < mRatesStatesCount; ++i) {
+            mStates[i] = mDenseCoefficients[0][i]
+                         +theta*(mDenseCoefficients[1][i]
+                                 +oneMinusTheta*(mDenseCoefficients[2][i]
+                                                 +theta*(mDenseCoefficients[3][i]
+                                                         +oneMinusTheta*mDenseCoefficients[4][i])));
+        }
+
+        mComputeRates(pVoiEnd, mConstants, mRates, mStates, mAlgebraic);
+
+        ++mRhsEvaluationsCount;
+    }
+
+    pVoi = pVoiEnd;
+}
+
+//==============================================================================
+
+DormandPrinceSolver::Statistics DormandPrinceSolver::statistics() const
+{
+    // Return our statistics, i.e. our default ones and our number of rejected
+    // steps
+
+    Statistics res = OdeSolver::statistics();
+
+    res.insert(Solver::RejectedStepsStatistic, mRejectedStepsCount);
+
+    return res;
+}
+
+//==============================================================================
+
+void DormandPrinceSolver::deleteArrays()
+{
+    // Delete our various arrays
+
+    delete[] mY;
+    delete[] mYNew;
+    delete[] mYStage;
+
+    for (auto k : mK) {
+        delete[] k;
+    }
+
+    for (auto denseCoefficients : mDenseCoefficients) {
+        delete[] denseCoefficients;
+    }
+}
+
+//==============================================================================
+
+double DormandPrinceSolver::errorNorm(const double *pErrors, const double *pY1,
+                                      const double *pY2) const
+{
+    // Return the root mean square of the given errors, weighted using our
+    // tolerances
+
+    double res = 0.0;
+
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        double error = pErrors[i]/(mAbsoluteTolerance+mRelativeTolerance*qMax(qAbs(pY1[i]), qAbs(pY2[i])));
+
+        res += error*error;
+    }
+
+    return (mRatesStatesCount != 0)?qSqrt(res/mRatesStatesCount):0.0;
+}
+
+//==============================================================================
+
+double DormandPrinceSolver::initialStep() const
+{
+    // Determine our initial step, following Hairer's DOPRI5, i.e. so that an
+    // explicit Euler step would be (roughly) within our tolerances, and then
+    // refine it using an estimate of the second derivative of our solution
+    // Note: mK[0] must contain our rates at our current point while mK[1] and
+    //       mYStage are only used as work arrays...
+
+    double ratesNorm = 0.0;
+    double statesNorm = 0.0;
+
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        double tolerance = mAbsoluteTolerance+mRelativeTolerance*qAbs(mY[i]);
+        double rate = mK[0][i]/tolerance;
+        double state = mY[i]/tolerance;
+
+        ratesNorm += rate*rate;
+        statesNorm += state*state;
+    }
+
+    double res = ((ratesNorm <= 1.0e-10) || (statesNorm <= 1.0e-10))?
+                     1.0e-6:
+                     0.01*qSqrt(statesNorm/ratesNorm);
+
+    if (mMaximumStep > 0.0) {
+        res = qMin(res, mMaximumStep);
+    }
+
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mYStage[i] = mY[i]+res*mK[0][i];
+    }
+
+    mComputeRates(mVoi+res, mConstants, mK[1], mYStage, mAlgebraic);
+
+    ++mRhsEvaluationsCount;
+
+    double secondDerivativeNorm = 0.0;
+
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        double secondDerivative = (mK[1][i]-mK[0][i])/(mAbsoluteTolerance+mRelativeTolerance*qAbs(mY[i]));
+
+        secondDerivativeNorm += secondDerivative*secondDerivative;
+    }
+
+    double derivativesNorm = qMax(qSqrt(secondDerivativeNorm)/res, qSqrt(ratesNorm));
+    double refinedStep = (derivativesNorm <= 1.0e-15)?
+                             qMax(1.0e-6, 1.0e-3*res):
+                             qPow(0.01/derivativesNorm, 0.2);
+
+    res = qMin(100.0*res, refinedStep);
+
+    if (mMaximumStep > 0.0) {
+        res = qMin(res, mMaximumStep);
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+void DormandPrinceSolver::updateDenseCoefficients(double pStep) const
+{
+    // Compute the coefficients of the continuous extension of our last step,
+    // i.e. from mY to mYNew
+    // Note: this must be done before mY/mYNew and k1/k7 get swapped...
+
+    static const double D1 = -12715105075.0/11282082432.0;
+    static const double D3 = 87487479700.0/32700410799.0;
+    static const double D4 = -10690763975.0/1880347072.0;
+    static const double D5 = 701980252875.0/199316789632.0;
+    static const double D6 = -1453857185.0/822651844.0;
+    static const double D7 = 69997945.0/29380423.0;
+
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        double yDifference = mYNew[i]-mY[i];
+        double bSpline = pStep*mK[0][i]-yDifference;
+
+        mDenseCoefficients[0][i] = mY[i];
+        mDenseCoefficients[1][i] = yDifference;
+        mDenseCoefficients[2][i] = bSpline;
+        mDenseCoefficients[3][i] = yDifference-pStep*mK[6][i]-bSpline;
+        mDenseCoefficients[4][i] = pStep*(D1*mK[0][i]+D3*mK[2][i]+D4*mK[3][i]+D5*mK[4][i]+D6*mK[5][i]+D7*mK[6][i]);
+    }
+}
+
+//==============================================================================
+
+} // namespace DormandPrinceSolver
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
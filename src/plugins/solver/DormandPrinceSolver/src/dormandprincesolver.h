@@ -0,0 +1,114 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+//==============================================================================
+// Dormand-Prince solver
+//==============================================================================
+
+#pragma once
+
+//==============================================================================
+
+#include "solverinterface.h"
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace DormandPrinceSolver {
+
+//==============================================================================
+
+static const auto RelativeToleranceId    = QStringLiteral("RelativeTolerance");
+static const auto AbsoluteToleranceId    = QStringLiteral("AbsoluteTolerance");
+static const auto MaximumStepId          = QStringLiteral("MaximumStep");
+static const auto MaximumNumberOfStepsId = QStringLiteral("MaximumNumberOfSteps");
+static const auto InterpolateSolutionId  = QStringLiteral("InterpolateSolution");
+
+//==============================================================================
+
+static const double RelativeToleranceDefaultValue = 1.0e-7;
+static const double AbsoluteToleranceDefaultValue = 1.0e-7;
+
+static const double MaximumStepDefaultValue = 0.0;
+
+enum {
+    MaximumNumberOfStepsDefaultValue = 500
+};
+
+static const bool InterpolateSolutionDefaultValue = true;
+
+//==============================================================================
+
+class DormandPrinceSolver : public OpenCOR::Solver::OdeSolver
+{
+    Q_OBJECT
+
+public:
+    ~DormandPrinceSolver() override;
+
+    void initialize(double pVoi, int pRatesStatesCount, double *pConstants,
+                    double *pRates, double *pStates, double *pAlgebraic,
+                    ComputeRatesFunction pComputeRates) override;
+    void reinitialize(double pVoi) override;
+
+    void solve(double &pVoi, double pVoiEnd) const override;
+
+    Statistics statistics() const override;
+
+private:
+    double mRelativeTolerance = RelativeToleranceDefaultValue;
+    double mAbsoluteTolerance = AbsoluteToleranceDefaultValue;
+    double mMaximumStep = MaximumStepDefaultValue;
+    int mMaximumNumberOfSteps = MaximumNumberOfStepsDefaultValue;
+    bool mInterpolateSolution = InterpolateSolutionDefaultValue;
+
+    mutable bool mStarted = false;
+
+    mutable double mVoi = 0.0;
+    mutable double mPreviousVoi = 0.0;
+    mutable double mStep = 0.0;
+    mutable double mPreviousErrorNorm = 1.0e-4;
+    mutable bool mPreviousStepRejected = false;
+
+    mutable double *mY = nullptr;
+    mutable double *mYNew = nullptr;
+    double *mYStage = nullptr;
+    mutable double *mK[7] = {};
+
+    double *mDenseCoefficients[5] = {};
+
+    mutable quint64 mRejectedStepsCount = 0;
+
+    void deleteArrays();
+
+    double errorNorm(const double *pErrors, const double *pY1,
+                     const double *pY2) const;
+
+    double initialStep() const;
+    void updateDenseCoefficients(double pStep) const;
+};
+
+//==============================================================================
+
+} // namespace DormandPrinceSolver
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
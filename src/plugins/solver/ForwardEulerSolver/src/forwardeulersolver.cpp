@@ -45,47 +45,31 @@ void ForwardEulerSolver::initialize(double pVoi, int pRatesStatesCount,
         return;
     }
 
+    if (mProperties.contains(InterpolateSolutionId)) {
+        mInterpolateSolution = mProperties.value(InterpolateSolutionId).toBool();
+    } else {
+        emit error(tr(R"(the "Interpolate solution" property value could not be retrieved)"));
+
+        return;
+    }
+
     // Initialise the ODE solver itself
 
-    OdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates, pStates,
-                          pAlgebraic, pComputeRates);
+    FixedStepOdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates,
+                                   pStates, pAlgebraic, pComputeRates);
 }
 
 //==============================================================================
 
-void ForwardEulerSolver::solve(double &pVoi, double pVoiEnd) const
+void ForwardEulerSolver::doStep(double pVoi, double pStep) const
 {
-    // Y_n+1 = Y_n + h * f(t_n, Y_n)
-
-    double voiStart = pVoi;
-
-    int stepNumber = 0;
-    double realStep = mStep;
+    Q_UNUSED(pVoi)
 
-    while (!qFuzzyCompare(pVoi, pVoiEnd)) {
-        // Check that the time step is correct
-
-        if (pVoi+realStep > pVoiEnd) {
-            realStep = pVoiEnd-pVoi;
-        }
-
-        // Compute f(t_n, Y_n)
-
-        mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
-
-        // Compute Y_n+1
-
-        for (int i = 0; i < mRatesStatesCount; ++i) {
-            mStates[i] += realStep*mRates[i];
-        }
-
-        // Advance through time
+    // Y_n+1 = Y_n + h * f(t_n, Y_n)
+    // Note: f(t_n, Y_n) is already in mRates...
 
-        if (!qFuzzyCompare(realStep, mStep)) {
-            pVoi = pVoiEnd;
-        } else {
-            pVoi = voiStart+(++stepNumber)*mStep;
-        }
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mStates[i] += pStep*mRates[i];
     }
 }
 
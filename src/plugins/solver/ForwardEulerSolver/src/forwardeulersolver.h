@@ -34,15 +34,18 @@ namespace ForwardEulerSolver {
 
 //==============================================================================
 
-static const auto StepId = QStringLiteral("Step");
+static const auto StepId                = QStringLiteral("Step");
+static const auto InterpolateSolutionId = QStringLiteral("InterpolateSolution");
 
 //==============================================================================
 
 static const double StepDefaultValue = 1.0;
 
+static const bool InterpolateSolutionDefaultValue = false;
+
 //==============================================================================
 
-class ForwardEulerSolver : public OpenCOR::Solver::OdeSolver
+class ForwardEulerSolver : public OpenCOR::Solver::FixedStepOdeSolver
 {
     Q_OBJECT
 
@@ -51,10 +54,8 @@ public:
                     double *pRates, double *pStates, double *pAlgebraic,
                     ComputeRatesFunction pComputeRates) override;
 
-    void solve(double &pVoi, double pVoiEnd) const override;
-
-private:
-    double mStep = StepDefaultValue;
+protected:
+    void doStep(double pVoi, double pStep) const override;
 };
 
 //==============================================================================
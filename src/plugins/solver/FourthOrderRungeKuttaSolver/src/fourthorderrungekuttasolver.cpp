@@ -57,10 +57,18 @@ void FourthOrderRungeKuttaSolver::initialize(double pVoi, int pRatesStatesCount,
         return;
     }
 
+    if (mProperties.contains(InterpolateSolutionId)) {
+        mInterpolateSolution = mProperties.value(InterpolateSolutionId).toBool();
+    } else {
+        emit error(tr(R"(the "Interpolate solution" property value could not be retrieved)"));
+
+        return;
+    }
+
     // Initialise the ODE solver itself
 
-    OdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates, pStates,
-                          pAlgebraic, pComputeRates);
+    FixedStepOdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates,
+                                   pStates, pAlgebraic, pComputeRates);
 
     // (Re)create our various arrays
 
@@ -75,7 +83,7 @@ void FourthOrderRungeKuttaSolver::initialize(double pVoi, int pRatesStatesCount,
 
 //==============================================================================
 
-void FourthOrderRungeKuttaSolver::solve(double &pVoi, double pVoiEnd) const
+void FourthOrderRungeKuttaSolver::doStep(double pVoi, double pStep) const
 {
     // k1 = h * f(t_n, Y_n)
     // k2 = h * f(t_n + h / 2, Y_n + k1 / 2)
@@ -83,77 +91,57 @@ void FourthOrderRungeKuttaSolver::solve(double &pVoi, double pVoiEnd) const
     // k4 = h * f(t_n + h, Y_n + k3)
     // Y_n+1 = Y_n + k1 / 6 + k2 / 3 + k3 / 3 + k4 / 6
 
-    // Note: the algorithm hereafter doesn't compute k1, k2, k3 and k4 as such
-    //       and this simply for performance reasons...
+    // Note #1: the algorithm hereafter doesn't compute k1, k2, k3 and k4 as
+    //          such and this simply for performance reasons...
+    // Note #2: f(t_n, Y_n) is already in mRates...
 
     static const double OneOverThree = 1.0/3.0;
     static const double OneOverSix   = 1.0/6.0;
 
-    double voiStart = pVoi;
-
-    int stepNumber = 0;
-    double realStep = mStep;
-    double realHalfStep = 0.5*realStep;
-
-    while (!qFuzzyCompare(pVoi, pVoiEnd)) {
-        // Check that the time step is correct
-
-        if (pVoi+realStep > pVoiEnd) {
-            realStep = pVoiEnd-pVoi;
-            realHalfStep = 0.5*realStep;
-        }
+    double halfStep = 0.5*pStep;
 
-        // Compute f(t_n, Y_n)
+    // Compute k1 and Yk1
 
-        mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
-
-        // Compute k1 and Yk1
-
-        for (int i = 0; i < mRatesStatesCount; ++i) {
-            mK1[i] = mRates[i];
-            mYk123[i] = mStates[i]+realHalfStep*mK1[i];
-        }
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mK1[i] = mRates[i];
+        mYk123[i] = mStates[i]+halfStep*mK1[i];
+    }
 
-        // Compute f(t_n + h / 2, Y_n + k1 / 2)
+    // Compute f(t_n + h / 2, Y_n + k1 / 2)
 
-        mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk123, mAlgebraic);
+    mComputeRates(pVoi+halfStep, mConstants, mRates, mYk123, mAlgebraic);
 
-        // Compute k2 and Yk2
+    // Compute k2 and Yk2
 
-        for (int i = 0; i < mRatesStatesCount; ++i) {
-            mK23[i] = mRates[i];
-            mYk123[i] = mStates[i]+realHalfStep*mK23[i];
-        }
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mK23[i] = mRates[i];
+        mYk123[i] = mStates[i]+halfStep*mK23[i];
+    }
 
-        // Compute f(t_n + h / 2, Y_n + k2 / 2)
+    // Compute f(t_n + h / 2, Y_n + k2 / 2)
 
-        mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk123, mAlgebraic);
+    mComputeRates(pVoi+halfStep, mConstants, mRates, mYk123, mAlgebraic);
 
-        // Compute k3 and Yk3
+    // Compute k3 and Yk3
 
-        for (int i = 0; i < mRatesStatesCount; ++i) {
-            mK23[i] += mRates[i];
-            mYk123[i] = mStates[i]+realStep*mK23[i];
-        }
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mK23[i] += mRates[i];
+        mYk123[i] = mStates[i]+pStep*mRates[i];
+    }
 
-        // Compute f(t_n + h, Y_n + k3)
+    // Compute f(t_n + h, Y_n + k3)
 
-        mComputeRates(pVoi+realStep, mConstants, mRates, mYk123, mAlgebraic);
+    mComputeRates(pVoi+pStep, mConstants, mRates, mYk123, mAlgebraic);
 
-        // Compute k4 and therefore Y_n+1
+    // Compute k4 and therefore Y_n+1
 
-        for (int i = 0; i < mRatesStatesCount; ++i) {
-            mStates[i] += realStep*(OneOverSix*(mK1[i]+mRates[i])+OneOverThree*mK23[i]);
-        }
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mStates[i] += pStep*(OneOverSix*(mK1[i]+mRates[i])+OneOverThree*mK23[i]);
+    }
 
-        // Advance through time
+    // Keep track of our statistics
 
-        if (!qFuzzyCompare(realStep, mStep)) {
-            pVoi = pVoiEnd;
-        } else {
-            pVoi = voiStart+(++stepNumber)*mStep;
-        }
-    }
+    mRhsEvaluationsCount += 3;
 }
 
 //==============================================================================
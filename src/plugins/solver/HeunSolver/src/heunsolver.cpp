@@ -55,10 +55,18 @@ void HeunSolver::initialize(double pVoi, int pRatesStatesCount,
         return;
     }
 
+    if (mProperties.contains(InterpolateSolutionId)) {
+        mInterpolateSolution = mProperties.value(InterpolateSolutionId).toBool();
+    } else {
+        emit error(tr(R"(the "Interpolate solution" property value could not be retrieved)"));
+
+        return;
+    }
+
     // Initialise the ODE solver itself
 
-    OdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates, pStates,
-                          pAlgebraic, pComputeRates);
+    FixedStepOdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates,
+                                   pStates, pAlgebraic, pComputeRates);
 
     // (Re)create our various arrays
 
@@ -71,54 +79,34 @@ void HeunSolver::initialize(double pVoi, int pRatesStatesCount,
 
 //==============================================================================
 
-void HeunSolver::solve(double &pVoi, double pVoiEnd) const
+void HeunSolver::doStep(double pVoi, double pStep) const
 {
     // k = h * f(t_n, Y_n)
     // Y_n+1 = Y_n + h / 2 * ( f(t_n, Y_n) + f(t_n + h, Y_n + k) )
+    // Note: f(t_n, Y_n) is already in mRates...
 
-    double voiStart = pVoi;
-
-    int stepNumber = 0;
-    double realStep = mStep;
-    double realHalfStep = 0.5*realStep;
-
-    while (!qFuzzyCompare(pVoi, pVoiEnd)) {
-        // Check that the time step is correct
+    double halfStep = 0.5*pStep;
 
-        if (pVoi+realStep > pVoiEnd) {
-            realStep = pVoiEnd-pVoi;
-            realHalfStep = 0.5*realStep;
-        }
+    // Compute k and Yk
 
-        // Compute f(t_n, Y_n)
-
-        mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
-
-        // Compute k and Yk
-
-        for (int i = 0; i < mRatesStatesCount; ++i) {
-            mK[i] = mRates[i];
-            mYk[i] = mStates[i]+realStep*mRates[i];
-        }
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mK[i] = mRates[i];
+        mYk[i] = mStates[i]+pStep*mRates[i];
+    }
 
-        // Compute f(t_n + h, Y_n + k)
+    // Compute f(t_n + h, Y_n + k)
 
-        mComputeRates(pVoi+realStep, mConstants, mRates, mYk, mAlgebraic);
+    mComputeRates(pVoi+pStep, mConstants, mRates, mYk, mAlgebraic);
 
-        // Compute Y_n+1
+    // Compute Y_n+1
 
-        for (int i = 0; i < mRatesStatesCount; ++i) {
-            mStates[i] += realHalfStep*(mK[i]+mRates[i]);
-        }
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mStates[i] += halfStep*(mK[i]+mRates[i]);
+    }
 
-        // Advance through time
+    // Keep track of our statistics
 
-        if (!qFuzzyCompare(realStep, mStep)) {
-            pVoi = pVoiEnd;
-        } else {
-            pVoi = voiStart+(++stepNumber)*mStep;
-        }
-    }
+    ++mRhsEvaluationsCount;
 }
 
 //==============================================================================
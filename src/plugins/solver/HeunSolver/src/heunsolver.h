@@ -34,15 +34,18 @@ namespace HeunSolver {
 
 //==============================================================================
 
-static const auto StepId = QStringLiteral("Step");
+static const auto StepId                = QStringLiteral("Step");
+static const auto InterpolateSolutionId = QStringLiteral("InterpolateSolution");
 
 //==============================================================================
 
 static const double StepDefaultValue = 1.0;
 
+static const bool InterpolateSolutionDefaultValue = false;
+
 //==============================================================================
 
-class HeunSolver : public OpenCOR::Solver::OdeSolver
+class HeunSolver : public OpenCOR::Solver::FixedStepOdeSolver
 {
     Q_OBJECT
 
@@ -53,11 +56,10 @@ public:
                     double *pRates, double *pStates, double *pAlgebraic,
                     ComputeRatesFunction pComputeRates) override;
 
-    void solve(double &pVoi, double pVoiEnd) const override;
+protected:
+    void doStep(double pVoi, double pStep) const override;
 
 private:
-    double mStep = StepDefaultValue;
-
     double *mK = nullptr;
     double *mYk = nullptr;
 };
@@ -0,0 +1,740 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+//==============================================================================
+// IDA solver
+//==============================================================================
+
+#include "idasolver.h"
+
+//==============================================================================
+
+#include "sundialsbegin.h"
+    #include "idas/idas.h"
+    #include "idas/idas_bbdpre.h"
+    #include "sunlinsol/sunlinsol_band.h"
+    #include "sunlinsol/sunlinsol_dense.h"
+    #include "sunlinsol/sunlinsol_spbcgs.h"
+    #include "sunlinsol/sunlinsol_spgmr.h"
+    #include "sunlinsol/sunlinsol_sptfqmr.h"
+#include "sundialsend.h"
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace IDASolver {
+
+//==============================================================================
+
+int residualsFunction(double pVoi, N_Vector pStates, N_Vector pRates,
+                      N_Vector pResiduals, void *pUserData)
+{
+    // Compute our residuals, i.e. Y'-f(t, Y) for our states and the residuals
+    // of our NLA systems for their unknowns
+    // Note: f(t, Y) is computed in the first part of our residuals, which we
+    //       then update...
+
+    auto userData = static_cast<IdaSolverUserData *>(pUserData);
+    int statesCount = userData->statesCount();
+    double *states = N_VGetArrayPointer_Serial(pStates);
+    double *rates = N_VGetArrayPointer_Serial(pRates);
+    double *residuals = N_VGetArrayPointer_Serial(pResiduals);
+
+    userData->computeRates(pVoi, states, residuals,
+                           states+statesCount, residuals+statesCount);
+
+    for (int i = 0; i < statesCount; ++i) {
+        residuals[i] = rates[i]-residuals[i];
+    }
+
+    return 0;
+}
+
+//==============================================================================
+
+int preconditionerResidualsFunction(sunindextype pSize, double pVoi,
+                                    N_Vector pStates, N_Vector pRates,
+                                    N_Vector pResiduals, void *pUserData)
+{
+    Q_UNUSED(pSize)
+
+    // Compute the residuals used by our banded preconditioner, i.e. our
+    // residuals
+
+    return residualsFunction(pVoi, pStates, pRates, pResiduals, pUserData);
+}
+
+//==============================================================================
+
+int rootsFunction(double pVoi, N_Vector pStates, N_Vector pRates,
+                  double *pRoots, void *pUserData)
+{
+    Q_UNUSED(pRates)
+
+    // Compute our roots
+
+    auto userData = static_cast<IdaSolverUserData *>(pUserData);
+    double *states = N_VGetArrayPointer_Serial(pStates);
+
+    userData->computeRoots(pVoi, states, states+userData->statesCount(), pRoots);
+
+    return 0;
+}
+
+//==============================================================================
+
+void errorHandler(int pErrorCode, const char *pModule, const char *pFunction,
+                  char *pErrorMessage, void *pUserData)
+{
+    Q_UNUSED(pModule)
+    Q_UNUSED(pFunction)
+
+    // Forward errors to our IdaSolver object
+
+    if (pErrorCode != IDA_WARNING) {
+        static_cast<IdaSolver *>(pUserData)->emitError(pErrorMessage);
+    }
+}
+
+//==============================================================================
+
+IdaSolverNlaSolver::IdaSolverNlaSolver(Solver::NlaSolver *pNlaSolver) :
+    mNlaSolver(pNlaSolver)
+{
+}
+
+//==============================================================================
+
+void IdaSolverNlaSolver::solve(ComputeSystemFunction pComputeSystem,
+                               double *pParameters, int pSize,
+                               void *pUserData)
+{
+    // Use our unknowns as the solution of the given NLA system and compute its
+    // residuals, if we are computing our residuals and know about it
+
+    void *computeSystem = reinterpret_cast<void *>(pComputeSystem);
+    int offset = mOffsets.value(computeSystem, -1);
+    size_t parametersSize = size_t(pSize)*Solver::SizeOfDouble;
+
+    if ((mResiduals != nullptr) && (offset != -1)) {
+        memcpy(pParameters, mUnknowns+offset, parametersSize);
+
+        pComputeSystem(pParameters, mResiduals+offset, pUserData);
+
+        return;
+    }
+
+    // Otherwise, actually solve the given NLA system and keep track of its
+    // solution, if we know about it or are (still) recording
+
+    mNlaSolver->solve(pComputeSystem, pParameters, pSize, pUserData);
+
+    if (offset == -1) {
+        if (!mRecording) {
+            return;
+        }
+
+        offset = mSolution.count();
+
+        mOffsets.insert(computeSystem, offset);
+        mSolution.resize(offset+pSize);
+    }
+
+    memcpy(mSolution.data()+offset, pParameters, parametersSize);
+}
+
+//==============================================================================
+
+void IdaSolverNlaSolver::stopRecording()
+{
+    // Stop recording, i.e. stop keeping track of new NLA systems
+
+    mRecording = false;
+}
+
+//==============================================================================
+
+int IdaSolverNlaSolver::unknownsCount() const
+{
+    // Return our number of unknowns
+
+    return mSolution.count();
+}
+
+//==============================================================================
+
+const double * IdaSolverNlaSolver::solution() const
+{
+    // Return the last solution of our NLA systems
+
+    return mSolution.constData();
+}
+
+//==============================================================================
+
+void IdaSolverNlaSolver::setUnknowns(double *pUnknowns, double *pResiduals)
+{
+    // Set the unknowns to use as the solution of our NLA systems and where to
+    // compute their residuals, or unset them if nullptr
+
+    mUnknowns = pUnknowns;
+    mResiduals = pResiduals;
+}
+
+//==============================================================================
+
+IdaSolverUserData::IdaSolverUserData(int pStatesCount, double *pConstants,
+                                     double *pAlgebraic,
+                                     Solver::OdeSolver::ComputeRatesFunction pComputeRates,
+                                     IdaSolverNlaSolver *pNlaSolver) :
+    mStatesCount(pStatesCount),
+    mConstants(pConstants),
+    mAlgebraic(pAlgebraic),
+    mComputeRates(pComputeRates),
+    mNlaSolver(pNlaSolver)
+{
+}
+
+//==============================================================================
+
+int IdaSolverUserData::statesCount() const
+{
+    // Return our number of states
+
+    return mStatesCount;
+}
+
+//==============================================================================
+
+void IdaSolverUserData::computeRates(double pVoi, double *pStates,
+                                     double *pRates, double *pUnknowns,
+                                     double *pResiduals) const
+{
+    // Compute our rates, using the given unknowns as the solution of our NLA
+    // systems (and computing their residuals), if any
+
+    if (mNlaSolver != nullptr) {
+        mNlaSolver->setUnknowns(pUnknowns, pResiduals);
+    }
+
+    mComputeRates(pVoi, mConstants, pRates, pStates, mAlgebraic);
+
+    if (mNlaSolver != nullptr) {
+        mNlaSolver->setUnknowns(nullptr, nullptr);
+    }
+}
+
+//==============================================================================
+
+void IdaSolverUserData::setRoots(double *pRootsRates, double *pRootsResiduals,
+                                 Solver::OdeSolver::ComputeRootsFunction pComputeRoots)
+{
+    // Keep track of what we need to compute our roots
+
+    mRootsRates = pRootsRates;
+    mRootsResiduals = pRootsResiduals;
+
+    mComputeRoots = pComputeRoots;
+}
+
+//==============================================================================
+
+void IdaSolverUserData::computeRoots(double pVoi, double *pStates,
+                                     double *pUnknowns, double *pRoots) const
+{
+    // Compute our roots, using the given unknowns as the solution of our NLA
+    // systems, if any
+    // Note: computing our roots requires computing our rates and the residuals
+    //       of our NLA systems, which we do in separate arrays so as not to
+    //       interfere with IDAS...
+
+    if (mNlaSolver != nullptr) {
+        mNlaSolver->setUnknowns(pUnknowns, mRootsResiduals);
+    }
+
+    mComputeRoots(pVoi, mConstants, mRootsRates, pStates, mAlgebraic, pRoots);
+
+    if (mNlaSolver != nullptr) {
+        mNlaSolver->setUnknowns(nullptr, nullptr);
+    }
+}
+
+//==============================================================================
+
+IdaSolver::~IdaSolver()
+{
+    // Delete our NLA solver, if any
+
+    delete mNlaSolver;
+
+    // Make sure that the solver has been initialised
+
+    if (mSolver == nullptr) {
+        return;
+    }
+
+    // Delete some internal objects
+
+    N_VDestroy_Serial(mStatesVector);
+    N_VDestroy_Serial(mRatesVector);
+    SUNLinSolFree(mLinearSolver);
+    SUNMatDestroy(mMatrix);
+
+    IDAFree(&mSolver);
+
+    delete mUserData;
+
+    delete[] mWork;
+}
+
+//==============================================================================
+
+Solver::NlaSolver * IdaSolver::nlaSolver(Solver::NlaSolver *pNlaSolver)
+{
+    // We solve the NLA systems of our model ourselves, so use our own NLA
+    // solver, which relies on the given one whenever an NLA system actually
+    // needs to be solved
+
+    if (mNlaSolver == nullptr) {
+        mNlaSolver = new IdaSolverNlaSolver(pNlaSolver);
+    }
+
+    return mNlaSolver;
+}
+
+//==============================================================================
+
+void IdaSolver::initialize(double pVoi, int pRatesStatesCount,
+                           double *pConstants, double *pRates,
+                           double *pStates, double *pAlgebraic,
+                           ComputeRatesFunction pComputeRates)
+{
+    // Compute our rates, so that the NLA systems that need to be solved to
+    // compute them, if any, get solved and recorded, and determine the size of
+    // our system, i.e. our number of states and of unknowns
+
+    pComputeRates(pVoi, pConstants, pRates, pStates, pAlgebraic);
+
+    ++mRhsEvaluationsCount;
+
+    mSize = pRatesStatesCount;
+
+    if (mNlaSolver != nullptr) {
+        mNlaSolver->stopRecording();
+
+        mSize += mNlaSolver->unknownsCount();
+    }
+
+    // Retrieve our properties
+
+    double maximumStep = MaximumStepDefaultValue;
+    int maximumNumberOfSteps = MaximumNumberOfStepsDefaultValue;
+    QString linearSolver = LinearSolverDefaultValue;
+    QString preconditioner = PreconditionerDefaultValue;
+    int upperHalfBandwidth = UpperHalfBandwidthDefaultValue;
+    int lowerHalfBandwidth = LowerHalfBandwidthDefaultValue;
+    double relativeTolerance = RelativeToleranceDefaultValue;
+    double absoluteTolerance = AbsoluteToleranceDefaultValue;
+
+    if (mProperties.contains(MaximumStepId)) {
+        maximumStep = mProperties.value(MaximumStepId).toDouble();
+    } else {
+        emit error(tr(R"(the "Maximum step" property value could not be retrieved)"));
+
+        return;
+    }
+
+    if (mProperties.contains(MaximumNumberOfStepsId)) {
+        maximumNumberOfSteps = mProperties.value(MaximumNumberOfStepsId).toInt();
+    } else {
+        emit error(tr(R"(the "Maximum number of steps" property value could not be retrieved)"));
+
+        return;
+    }
+
+    if (mProperties.contains(LinearSolverId)) {
+        linearSolver = mProperties.value(LinearSolverId).toString();
+
+        bool needUpperAndLowerHalfBandwidths = false;
+
+        if (linearSolver == DenseLinearSolver) {
+            // We are dealing with a dense linear solver, so nothing more to do
+        } else if (linearSolver == BandedLinearSolver) {
+            // We are dealing with a banded linear solver, so we need both an
+            // upper and a lower half bandwidth
+
+            needUpperAndLowerHalfBandwidths = true;
+        } else {
+            // We are dealing with a GMRES/Bi-CGStab/TFQMR linear solver, so
+            // retrieve and check its preconditioner
+
+            if (mProperties.contains(PreconditionerId)) {
+                preconditioner = mProperties.value(PreconditionerId).toString();
+            } else {
+                emit error(tr(R"(the "Preconditioner" property value could not be retrieved)"));
+
+                return;
+            }
+
+            if (preconditioner == BandedPreconditioner) {
+                // We are dealing with a banded preconditioner, so we need both
+                // an upper and a lower half bandwidth
+
+                needUpperAndLowerHalfBandwidths = true;
+            }
+        }
+
+        if (needUpperAndLowerHalfBandwidths) {
+            if (mProperties.contains(UpperHalfBandwidthId)) {
+                upperHalfBandwidth = mProperties.value(UpperHalfBandwidthId).toInt();
+
+                if (upperHalfBandwidth >= mSize) {
+                    emit error(tr(R"(the "Upper half-bandwidth" property must have a value between 0 and %1)").arg(mSize-1));
+
+                    return;
+                }
+            } else {
+                emit error(tr(R"(the "Upper half-bandwidth" property value could not be retrieved)"));
+
+                return;
+            }
+
+            if (mProperties.contains(LowerHalfBandwidthId)) {
+                lowerHalfBandwidth = mProperties.value(LowerHalfBandwidthId).toInt();
+
+                if (lowerHalfBandwidth >= mSize) {
+                    emit error(tr(R"(the "Lower half-bandwidth" property must have a value between 0 and %1)").arg(mSize-1));
+
+                    return;
+                }
+            } else {
+                emit error(tr(R"(the "Lower half-bandwidth" property value could not be retrieved)"));
+
+                return;
+            }
+        }
+    } else {
+        emit error(tr(R"(the "Linear solver" property value could not be retrieved)"));
+
+        return;
+    }
+
+    if (mProperties.contains(RelativeToleranceId)) {
+        relativeTolerance = mProperties.value(RelativeToleranceId).toDouble();
+    } else {
+        emit error(tr(R"(the "Relative tolerance" property value could not be retrieved)"));
+
+        return;
+    }
+
+    if (mProperties.contains(AbsoluteToleranceId)) {
+        absoluteTolerance = mProperties.value(AbsoluteToleranceId).toDouble();
+    } else {
+        emit error(tr(R"(the "Absolute tolerance" property value could not be retrieved)"));
+
+        return;
+    }
+
+    if (mProperties.contains(InterpolateSolutionId)) {
+        mInterpolateSolution = mProperties.value(InterpolateSolutionId).toBool();
+    } else {
+        emit error(tr(R"(the "Interpolate solution" property value could not be retrieved)"));
+
+        return;
+    }
+
+    // Initialise our ODE solver
+
+    OdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates, pStates,
+                          pAlgebraic, pComputeRates);
+
+    // Create our states and rates vectors, and initialise them using our
+    // states, our rates and the solution of our NLA systems
+    // Note: this means that our initial conditions are consistent...
+
+    mStatesVector = N_VNew_Serial(mSize);
+    mRatesVector = N_VNew_Serial(mSize);
+
+    updateVectors();
+
+    // Create our work array, i.e. the (dummy) rates and residuals that we use
+    // when we don't want to interfere with IDAS
+
+    mWork = new double[mSize];
+
+    // Create our IDAS solver
+
+    mSolver = IDACreate();
+
+    // Use our own error handler
+
+    IDASetErrHandlerFn(mSolver, errorHandler, this);
+
+    // Initialise our IDAS solver
+
+    IDAInit(mSolver, residualsFunction, pVoi, mStatesVector, mRatesVector);
+
+    // Set our user data
+
+    mUserData = new IdaSolverUserData(pRatesStatesCount, pConstants, pAlgebraic,
+                                      pComputeRates, mNlaSolver);
+
+    IDASetUserData(mSolver, mUserData);
+
+    // Set our maximum step
+
+    IDASetMaxStep(mSolver, maximumStep);
+
+    // Set our maximum number of steps
+
+    IDASetMaxNumSteps(mSolver, maximumNumberOfSteps);
+
+    // Set our linear solver
+
+    if (linearSolver == DenseLinearSolver) {
+        mMatrix = SUNDenseMatrix(mSize, mSize);
+        mLinearSolver = SUNLinSol_Dense(mStatesVector, mMatrix);
+
+        IDASetLinearSolver(mSolver, mLinearSolver, mMatrix);
+    } else if (linearSolver == BandedLinearSolver) {
+        mMatrix = SUNBandMatrix(mSize, upperHalfBandwidth, lowerHalfBandwidth);
+        mLinearSolver = SUNLinSol_Band(mStatesVector, mMatrix);
+
+        IDASetLinearSolver(mSolver, mLinearSolver, mMatrix);
+    } else {
+        // We are dealing with a GMRES/Bi-CGStab/TFQMR linear solver
+
+        int preconditioning = (preconditioner == BandedPreconditioner)?
+                                  PREC_LEFT:
+                                  PREC_NONE;
+
+        if (linearSolver == GmresLinearSolver) {
+            mLinearSolver = SUNLinSol_SPGMR(mStatesVector, preconditioning, 0);
+        } else if (linearSolver == BiCgStabLinearSolver) {
+            mLinearSolver = SUNLinSol_SPBCGS(mStatesVector, preconditioning, 0);
+        } else {
+            mLinearSolver = SUNLinSol_SPTFQMR(mStatesVector, preconditioning, 0);
+        }
+
+        IDASetLinearSolver(mSolver, mLinearSolver, mMatrix);
+
+        if (preconditioner == BandedPreconditioner) {
+            IDABBDPrecInit(mSolver, mSize, upperHalfBandwidth, lowerHalfBandwidth,
+                           upperHalfBandwidth, lowerHalfBandwidth, 0.0,
+                           preconditionerResidualsFunction, nullptr);
+        }
+    }
+
+    // Set our relative and absolute tolerances
+
+    IDASStolerances(mSolver, relativeTolerance, absoluteTolerance);
+
+    // Locate the roots of our model, if any
+
+    if (mRootsCount != 0) {
+        mUserData->setRoots(mWork, mWork+pRatesStatesCount, mComputeRoots);
+
+        IDARootInit(mSolver, mRootsCount, rootsFunction);
+    }
+}
+
+//==============================================================================
+
+void IdaSolver::reinitialize(double pVoi)
+{
+    // Keep track of our current statistics since reinitialising our IDAS
+    // object will reset its counters
+
+    Statistics counters = currentStatistics();
+
+    for (auto counter = counters.constBegin(), counterEnd = counters.constEnd();
+         counter != counterEnd; ++counter) {
+        mPreviousStatistics[counter.key()] += counter.value();
+    }
+
+    // Compute our rates, solving our NLA systems (rather than computing their
+    // residuals) in the process, so that our rates and the unknowns of our NLA
+    // systems are consistent with our (possibly modified) states and constants
+
+    mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+
+    ++mRhsEvaluationsCount;
+
+    // Reinitialise our IDAS object
+
+    updateVectors();
+
+    IDAReInit(mSolver, pVoi, mStatesVector, mRatesVector);
+}
+
+//==============================================================================
+
+void IdaSolver::solve(double &pVoi, double pVoiEnd) const
+{
+    // Solve the model, stopping at each event, if any, i.e. where one of our
+    // roots was located
+    // Note #1: an event corresponds to a discontinuity in our model, so we
+    //          reinitialise IDAS, which also makes our rates and the unknowns
+    //          of our NLA systems consistent with our states...
+    // Note #2: reinitialising IDAS unsets our stop time, hence we (re)set it
+    //          before each call to IDASolve()...
+
+    double *states = N_VGetArrayPointer_Serial(mStatesVector);
+    size_t statesSize = size_t(mRatesStatesCount)*Solver::SizeOfDouble;
+
+    forever {
+        if (!mInterpolateSolution) {
+            IDASetStopTime(mSolver, pVoiEnd);
+        }
+
+        int flag = IDASolve(mSolver, pVoiEnd, &pVoi, mStatesVector,
+                            mRatesVector, IDA_NORMAL);
+
+        memcpy(mStates, states, statesSize);
+
+        if (flag != IDA_ROOT_RETURN) {
+            break;
+        }
+
+        mEvents << pVoi;
+
+        const_cast<IdaSolver *>(this)->reinitialize(pVoi);
+
+        if (qFuzzyCompare(pVoi, pVoiEnd)) {
+            break;
+        }
+    }
+
+    // Compute the rates one more time to get up to date values for the rates
+    // and the algebraic variables, using the unknowns of our NLA systems rather
+    // than solving them
+
+    mUserData->computeRates(pVoi, mStates, mRates,
+                            states+mRatesStatesCount, mWork+mRatesStatesCount);
+
+    ++mRhsEvaluationsCount;
+}
+
+//==============================================================================
+
+IdaSolver::Statistics IdaSolver::statistics() const
+{
+    // Return our statistics, i.e. those we had before our last
+    // reinitialisation, if any, and our current ones
+
+    Statistics res = mPreviousStatistics;
+
+    Statistics counters = currentStatistics();
+
+    for (auto counter = counters.constBegin(), counterEnd = counters.constEnd();
+         counter != counterEnd; ++counter) {
+        res[counter.key()] += counter.value();
+    }
+
+    res[Solver::RhsEvaluationsStatistic] += mRhsEvaluationsCount;
+
+    if (mRootsCount != 0) {
+        res.insert(Solver::EventsStatistic, quint64(mEvents.count()));
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+void IdaSolver::updateVectors()
+{
+    // Update our states and rates vectors using our states, our rates and the
+    // solution of our NLA systems, if any
+    // Note: the unknowns of our NLA systems don't have a rate as such, hence we
+    //       set their rate to zero...
+
+    double *states = N_VGetArrayPointer_Serial(mStatesVector);
+    double *rates = N_VGetArrayPointer_Serial(mRatesVector);
+    size_t statesSize = size_t(mRatesStatesCount)*Solver::SizeOfDouble;
+
+    memcpy(states, mStates, statesSize);
+    memcpy(rates, mRates, statesSize);
+
+    if (mSize != mRatesStatesCount) {
+        size_t unknownsSize = size_t(mSize-mRatesStatesCount)*Solver::SizeOfDouble;
+
+        memcpy(states+mRatesStatesCount, mNlaSolver->solution(), unknownsSize);
+        memset(rates+mRatesStatesCount, 0, unknownsSize);
+    }
+}
+
+//==============================================================================
+
+IdaSolver::Statistics IdaSolver::currentStatistics() const
+{
+    // Retrieve IDAS' counters, which are reset each time we reinitialise our
+    // IDAS object
+    // Note: IDAS evaluates our residuals rather than our rates, but each
+    //       evaluation of our residuals is an evaluation of our rates...
+
+    Statistics res;
+
+    if (mSolver == nullptr) {
+        return res;
+    }
+
+    long int steps = 0;
+    long int residualsEvaluations = 0;
+    long int errorTestFailures = 0;
+    long int nonlinearIterations = 0;
+    long int jacobianEvaluations = 0;
+    long int linearSolverSetups = 0;
+    long int linearIterations = 0;
+
+    IDAGetNumSteps(mSolver, &steps);
+    IDAGetNumResEvals(mSolver, &residualsEvaluations);
+    IDAGetNumErrTestFails(mSolver, &errorTestFailures);
+    IDAGetNumNonlinSolvIters(mSolver, &nonlinearIterations);
+    IDAGetNumJacEvals(mSolver, &jacobianEvaluations);
+    IDAGetNumLinSolvSetups(mSolver, &linearSolverSetups);
+    IDAGetNumLinIters(mSolver, &linearIterations);
+
+    res.insert(Solver::StepsStatistic, quint64(steps));
+    res.insert(Solver::RhsEvaluationsStatistic, quint64(residualsEvaluations));
+    res.insert(Solver::RejectedStepsStatistic, quint64(errorTestFailures));
+    res.insert(Solver::NonlinearIterationsStatistic, quint64(nonlinearIterations));
+    res.insert(Solver::JacobianEvaluationsStatistic, quint64(jacobianEvaluations));
+    res.insert(Solver::LinearSolverSetupsStatistic, quint64(linearSolverSetups));
+    res.insert(Solver::LinearIterationsStatistic, quint64(linearIterations));
+
+    if (mRootsCount != 0) {
+        long int rootEvaluations = 0;
+
+        IDAGetNumGEvals(mSolver, &rootEvaluations);
+
+        res.insert(Solver::RootEvaluationsStatistic, quint64(rootEvaluations));
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+} // namespace IDASolver
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
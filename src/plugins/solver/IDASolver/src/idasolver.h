@@ -0,0 +1,222 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+//==============================================================================
+// IDA solver
+//==============================================================================
+
+#pragma once
+
+//==============================================================================
+
+#include "solverinterface.h"
+
+//==============================================================================
+
+#include "sundialsbegin.h"
+    #include "nvector/nvector_serial.h"
+    #include "sundials/sundials_linearsolver.h"
+    #include "sundials/sundials_matrix.h"
+#include "sundialsend.h"
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace IDASolver {
+
+//==============================================================================
+
+static const auto MaximumStepId          = QStringLiteral("MaximumStep");
+static const auto MaximumNumberOfStepsId = QStringLiteral("MaximumNumberOfSteps");
+static const auto LinearSolverId         = QStringLiteral("LinearSolver");
+static const auto PreconditionerId       = QStringLiteral("Preconditioner");
+static const auto UpperHalfBandwidthId   = QStringLiteral("UpperHalfBandwidth");
+static const auto LowerHalfBandwidthId   = QStringLiteral("LowerHalfBandwidth");
+static const auto RelativeToleranceId    = QStringLiteral("RelativeTolerance");
+static const auto AbsoluteToleranceId    = QStringLiteral("AbsoluteTolerance");
+static const auto InterpolateSolutionId  = QStringLiteral("InterpolateSolution");
+
+//==============================================================================
+
+static const auto DenseLinearSolver    = QStringLiteral("Dense");
+static const auto BandedLinearSolver   = QStringLiteral("Banded");
+static const auto GmresLinearSolver    = QStringLiteral("GMRES");
+static const auto BiCgStabLinearSolver = QStringLiteral("BiCGStab");
+static const auto TfqmrLinearSolver    = QStringLiteral("TFQMR");
+
+//==============================================================================
+
+static const auto NoPreconditioner     = QStringLiteral("None");
+static const auto BandedPreconditioner = QStringLiteral("Banded");
+
+//==============================================================================
+
+// Default IDAS parameter values
+// Note #1: a maximum step of 0 means that there is no maximum step as such and
+//          that IDAS can use whatever step it sees fit...
+// Note #2: IDAS' default maximum number of steps is 500, which ought to be big
+//          enough in most cases...
+
+static const double MaximumStepDefaultValue = 0.0;
+
+enum {
+    MaximumNumberOfStepsDefaultValue = 500
+};
+
+static const auto LinearSolverDefaultValue = DenseLinearSolver;
+static const auto PreconditionerDefaultValue = BandedPreconditioner;
+
+enum {
+    UpperHalfBandwidthDefaultValue = 0,
+    LowerHalfBandwidthDefaultValue = 0
+};
+
+static const double RelativeToleranceDefaultValue = 1.0e-7;
+static const double AbsoluteToleranceDefaultValue = 1.0e-7;
+
+static const bool InterpolateSolutionDefaultValue = true;
+
+//==============================================================================
+// Note: we solve the NLA systems of a model as part of our own Newton
+//       iteration. To do so, we act as the NLA solver of the model. Until we
+//       are initialised, we keep track of the NLA systems that get solved (by
+//       the NLA solver we were given) and of their solution, which becomes the
+//       initial value of their unknowns. Then, while we compute our residuals,
+//       an NLA system that we know about doesn't get solved. Instead, its
+//       unknowns are given their current value and its residuals are
+//       computed...
+
+class IdaSolverNlaSolver : public Solver::NlaSolver
+{
+public:
+    explicit IdaSolverNlaSolver(Solver::NlaSolver *pNlaSolver);
+
+    void solve(ComputeSystemFunction pComputeSystem, double *pParameters,
+               int pSize, void *pUserData) override;
+
+    void stopRecording();
+
+    int unknownsCount() const;
+    const double * solution() const;
+
+    void setUnknowns(double *pUnknowns, double *pResiduals);
+
+private:
+    Solver::NlaSolver *mNlaSolver;
+
+    bool mRecording = true;
+
+    QMap<void *, int> mOffsets;
+    QVector<double> mSolution;
+
+    double *mUnknowns = nullptr;
+    double *mResiduals = nullptr;
+};
+
+//==============================================================================
+
+class IdaSolverUserData
+{
+public:
+    explicit IdaSolverUserData(int pStatesCount, double *pConstants,
+                               double *pAlgebraic,
+                               Solver::OdeSolver::ComputeRatesFunction pComputeRates,
+                               IdaSolverNlaSolver *pNlaSolver);
+
+    int statesCount() const;
+
+    void computeRates(double pVoi, double *pStates, double *pRates,
+                      double *pUnknowns, double *pResiduals) const;
+
+    void setRoots(double *pRootsRates, double *pRootsResiduals,
+                  Solver::OdeSolver::ComputeRootsFunction pComputeRoots);
+
+    void computeRoots(double pVoi, double *pStates, double *pUnknowns,
+                      double *pRoots) const;
+
+private:
+    int mStatesCount;
+
+    double *mConstants;
+    double *mAlgebraic;
+
+    Solver::OdeSolver::ComputeRatesFunction mComputeRates;
+
+    IdaSolverNlaSolver *mNlaSolver;
+
+    double *mRootsRates = nullptr;
+    double *mRootsResiduals = nullptr;
+
+    Solver::OdeSolver::ComputeRootsFunction mComputeRoots = nullptr;
+};
+
+//==============================================================================
+
+class IdaSolver : public OpenCOR::Solver::OdeSolver
+{
+    Q_OBJECT
+
+public:
+    ~IdaSolver() override;
+
+    Solver::NlaSolver * nlaSolver(Solver::NlaSolver *pNlaSolver) override;
+
+    void initialize(double pVoi, int pRatesStatesCount, double *pConstants,
+                    double *pRates, double *pStates, double *pAlgebraic,
+                    ComputeRatesFunction pComputeRates) override;
+    void reinitialize(double pVoi) override;
+
+    void solve(double &pVoi, double pVoiEnd) const override;
+
+    Statistics statistics() const override;
+
+private:
+    void *mSolver = nullptr;
+
+    int mSize = 0;
+
+    N_Vector mStatesVector = nullptr;
+    N_Vector mRatesVector = nullptr;
+
+    SUNMatrix mMatrix = nullptr;
+    SUNLinearSolver mLinearSolver = nullptr;
+
+    IdaSolverNlaSolver *mNlaSolver = nullptr;
+
+    double *mWork = nullptr;
+
+    IdaSolverUserData *mUserData = nullptr;
+
+    bool mInterpolateSolution = InterpolateSolutionDefaultValue;
+
+    Statistics mPreviousStatistics;
+
+    void updateVectors();
+
+    Statistics currentStatistics() const;
+};
+
+//==============================================================================
+
+} // namespace IDASolver
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -38,6 +38,11 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <cfloat>
+#include <cmath>
+
+//==============================================================================
+
 namespace OpenCOR {
 namespace KINSOLSolver {
 
@@ -83,6 +88,49 @@ void errorHandler(int pErrorCode, const char *pModule, const char *pFunction,
 
 //==============================================================================
 
+void silentErrorHandler(int pErrorCode, const char *pModule,
+                        const char *pFunction, char *pErrorMessage,
+                        void *pUserData)
+{
+    Q_UNUSED(pErrorCode)
+    Q_UNUSED(pModule)
+    Q_UNUSED(pFunction)
+    Q_UNUSED(pErrorMessage)
+    Q_UNUSED(pUserData)
+
+    // Ignore errors, which we do when trying to warm start KINSOL (see
+    // KinsolSolver::solve())
+}
+
+//==============================================================================
+
+static bool solutionFound(void *pSolver, int pFlag)
+{
+    // Return whether KINSOL found a solution
+    // Note: KINSOL returns KIN_STEP_LT_STPTOL (i.e. a non-negative flag) when
+    //       it stalls, in which case we may or may not be at a solution, so we
+    //       check the norm of our system function against KINSOL's default
+    //       tolerance, i.e. the cube root of the unit roundoff...
+
+    if (pFlag < 0) {
+        return false;
+    }
+
+    if (pFlag == KIN_STEP_LT_STPTOL) {
+        static const double FunctionNormTolerance = std::cbrt(DBL_EPSILON);
+
+        double functionNorm;
+
+        KINGetFuncNorm(pSolver, &functionNorm);
+
+        return functionNorm <= FunctionNormTolerance;
+    }
+
+    return true;
+}
+
+//==============================================================================
+
 KinsolSolverUserData::KinsolSolverUserData(Solver::NlaSolver::ComputeSystemFunction pComputeSystem,
                                            void *pUserData) :
     mComputeSystem(pComputeSystem),
@@ -110,6 +158,15 @@ void * KinsolSolverUserData::userData() const
 
 //==============================================================================
 
+void KinsolSolverUserData::setUserData(void *pUserData)
+{
+    // Set our user data
+
+    mUserData = pUserData;
+}
+
+//==============================================================================
+
 KinsolSolverData::KinsolSolverData(void *pSolver, N_Vector pParametersVector,
                                    N_Vector pOnesVector, SUNMatrix pMatrix,
                                    SUNLinearSolver pLinearSolver,
@@ -177,13 +234,20 @@ KinsolSolverUserData * KinsolSolverData::userData() const
 
 //==============================================================================
 
-void KinsolSolverData::setUserData(KinsolSolverUserData *pUserData)
+bool KinsolSolverData::hasSolution() const
 {
-    // Set our user data, after having delete our 'old' ones
+    // Return whether our parameters vector contains a solution
 
-    delete mUserData;
+    return mHasSolution;
+}
 
-    mUserData = pUserData;
+//==============================================================================
+
+void KinsolSolverData::setHasSolution(bool pHasSolution)
+{
+    // Set whether our parameters vector contains a solution
+
+    mHasSolution = pHasSolution;
 }
 
 //==============================================================================
@@ -203,8 +267,12 @@ void KinsolSolver::solve(ComputeSystemFunction pComputeSystem,
                          double *pParameters, int pSize, void *pUserData)
 {
     // Check whether we need to initialise or update ourselves
+    // Note: models usually have only one NLA system, so we keep track of the
+    //       last data we used to avoid looking it up every time...
 
-    KinsolSolverData *data = mData.value(reinterpret_cast<void *>(pComputeSystem));
+    KinsolSolverData *data = (pComputeSystem == mLastComputeSystem)?
+                                 mLastData:
+                                 mData.value(reinterpret_cast<void *>(pComputeSystem));
 
     if (data == nullptr) {
         // Retrieve our properties
@@ -261,8 +329,11 @@ void KinsolSolver::solve(ComputeSystemFunction pComputeSystem,
         }
 
         // Create some vectors
+        // Note: we use our own parameters vector, so that it can hold our
+        //       previous solution, which tells us whether we can reuse our
+        //       previous Jacobian for our next solve...
 
-        N_Vector parametersVector = N_VMake_Serial(pSize, pParameters);
+        N_Vector parametersVector = N_VNew_Serial(pSize);
         N_Vector onesVector = N_VNew_Serial(pSize);
 
         N_VConst(1.0, onesVector);
@@ -328,15 +399,89 @@ void KinsolSolver::solve(ComputeSystemFunction pComputeSystem,
     } else {
         // We are already initiliased, so simply update our user data
 
-        data->setUserData(new KinsolSolverUserData(pComputeSystem, pUserData));
+        data->userData()->setUserData(pUserData);
+    }
+
+    mLastComputeSystem = pComputeSystem;
+    mLastData = data;
+
+    // Solve our NLA system, reusing our previous Jacobian if the initial guess
+    // we were given is our previous solution (i.e. nothing has modified it
+    // since our previous solve)
+    // Note: if that fails, then we try again with a fresh Jacobian...
+
+    double *parameters = N_VGetArrayPointer_Serial(data->parametersVector());
+    size_t parametersSize = size_t(pSize)*Solver::SizeOfDouble;
+    bool solved = false;
 
-        KINSetUserData(data->solver(), data->userData());
+    if (   data->hasSolution()
+        && (memcmp(parameters, pParameters, parametersSize) == 0)) {
+        KINSetErrHandlerFn(data->solver(), silentErrorHandler, nullptr);
+        KINSetNoInitSetup(data->solver(), SUNTRUE);
+
+        solved = solutionFound(data->solver(),
+                               KINSol(data->solver(), data->parametersVector(),
+                                      KIN_LINESEARCH, data->onesVector(),
+                                      data->onesVector()));
+
+        updateStatistics(data->solver());
+
+        KINSetErrHandlerFn(data->solver(), errorHandler, this);
+        KINSetNoInitSetup(data->solver(), SUNFALSE);
+    }
+
+    if (!solved) {
+        memcpy(parameters, pParameters, parametersSize);
+
+        solved = solutionFound(data->solver(),
+                               KINSol(data->solver(), data->parametersVector(),
+                                      KIN_LINESEARCH, data->onesVector(),
+                                      data->onesVector()));
+
+        updateStatistics(data->solver());
     }
 
-    // Solve our linear system
+    data->setHasSolution(solved);
+
+    memcpy(pParameters, parameters, parametersSize);
+
+    ++mSolvesCount;
+}
+
+//==============================================================================
+
+void KinsolSolver::updateStatistics(void *pSolver)
+{
+    // Keep track of our statistics
+    // Note: KINSOL resets its counters each time KINSol() is called...
+
+    long int iterations = 0;
+    long int functionEvaluations = 0;
+    long int jacobianEvaluations = 0;
+
+    KINGetNumNonlinSolvIters(pSolver, &iterations);
+    KINGetNumFuncEvals(pSolver, &functionEvaluations);
+    KINGetNumJacEvals(pSolver, &jacobianEvaluations);
+
+    mIterationsCount += quint64(iterations);
+    mFunctionEvaluationsCount += quint64(functionEvaluations);
+    mJacobianEvaluationsCount += quint64(jacobianEvaluations);
+}
+
+//==============================================================================
+
+KinsolSolver::Statistics KinsolSolver::statistics() const
+{
+    // Return our statistics
+
+    Statistics res;
+
+    res.insert(Solver::NlaSolvesStatistic, mSolvesCount);
+    res.insert(Solver::NlaIterationsStatistic, mIterationsCount);
+    res.insert(Solver::NlaFunctionEvaluationsStatistic, mFunctionEvaluationsCount);
+    res.insert(Solver::NlaJacobianEvaluationsStatistic, mJacobianEvaluationsCount);
 
-    KINSol(data->solver(), data->parametersVector(), KIN_LINESEARCH,
-           data->onesVector(), data->onesVector());
+    return res;
 }
 
 //==============================================================================
@@ -83,6 +83,7 @@ public:
     Solver::NlaSolver::ComputeSystemFunction computeSystem() const;
 
     void * userData() const;
+    void setUserData(void *pUserData);
 
 private:
     Solver::NlaSolver::ComputeSystemFunction mComputeSystem;
@@ -107,7 +108,9 @@ public:
     N_Vector onesVector() const;
 
     KinsolSolverUserData * userData() const;
-    void setUserData(KinsolSolverUserData *pUserData);
+
+    bool hasSolution() const;
+    void setHasSolution(bool pHasSolution);
 
 private:
     void *mSolver;
@@ -119,6 +122,8 @@ private:
     SUNLinearSolver mLinearSolver;
 
     KinsolSolverUserData *mUserData;
+
+    bool mHasSolution = false;
 };
 
 //==============================================================================
@@ -133,8 +138,20 @@ public:
     void solve(ComputeSystemFunction pComputeSystem, double *pParameters,
                int pSize, void *pUserData) override;
 
+    Statistics statistics() const override;
+
 private:
     QMap<void *, KinsolSolverData *> mData;
+
+    ComputeSystemFunction mLastComputeSystem = nullptr;
+    KinsolSolverData *mLastData = nullptr;
+
+    void updateStatistics(void *pSolver);
+
+    quint64 mSolvesCount = 0;
+    quint64 mIterationsCount = 0;
+    quint64 mFunctionEvaluationsCount = 0;
+    quint64 mJacobianEvaluationsCount = 0;
 };
 
 //==============================================================================
@@ -55,10 +55,18 @@ void SecondOrderRungeKuttaSolver::initialize(double pVoi, int pRatesStatesCount,
         return;
     }
 
+    if (mProperties.contains(InterpolateSolutionId)) {
+        mInterpolateSolution = mProperties.value(InterpolateSolutionId).toBool();
+    } else {
+        emit error(tr(R"(the "Interpolate solution" property value could not be retrieved)"));
+
+        return;
+    }
+
     // Initialise the ODE solver itself
 
-    OdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates, pStates,
-                          pAlgebraic, pComputeRates);
+    FixedStepOdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates,
+                                   pStates, pAlgebraic, pComputeRates);
 
     // (Re)create our mYk1 array
 
@@ -69,57 +77,37 @@ void SecondOrderRungeKuttaSolver::initialize(double pVoi, int pRatesStatesCount,
 
 //==============================================================================
 
-void SecondOrderRungeKuttaSolver::solve(double &pVoi, double pVoiEnd) const
+void SecondOrderRungeKuttaSolver::doStep(double pVoi, double pStep) const
 {
     // k1 = h * f(t_n, Y_n)
     // k2 = h * f(t_n + h / 2, Y_n + k1 / 2)
     // Y_n+1 = Y_n + k2
 
-    // Note: the algorithm hereafter doesn't compute k1 and k2 as such and this
-    //       simply for performance reasons...
-
-    double voiStart = pVoi;
-
-    int stepNumber = 0;
-    double realStep = mStep;
-    double realHalfStep = 0.5*realStep;
+    // Note #1: the algorithm hereafter doesn't compute k1 and k2 as such and
+    //          this simply for performance reasons...
+    // Note #2: f(t_n, Y_n) is already in mRates...
 
-    while (!qFuzzyCompare(pVoi, pVoiEnd)) {
-        // Check that the time step is correct
+    double halfStep = 0.5*pStep;
 
-        if (pVoi+realStep > pVoiEnd) {
-            realStep = pVoiEnd-pVoi;
-            realHalfStep = 0.5*realStep;
-        }
+    // Compute k1 and therefore Yk1
 
-        // Compute f(t_n, Y_n)
-
-        mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
-
-        // Compute k1 and therefore Yk1
-
-        for (int i = 0; i < mRatesStatesCount; ++i) {
-            mYk1[i] = mStates[i]+realHalfStep*mRates[i];
-        }
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mYk1[i] = mStates[i]+halfStep*mRates[i];
+    }
 
-        // Compute f(t_n + h / 2, Y_n + k1 / 2)
+    // Compute f(t_n + h / 2, Y_n + k1 / 2)
 
-        mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk1, mAlgebraic);
+    mComputeRates(pVoi+halfStep, mConstants, mRates, mYk1, mAlgebraic);
 
-        // Compute Y_n+1
+    // Compute Y_n+1
 
-        for (int i = 0; i < mRatesStatesCount; ++i) {
-            mStates[i] += realStep*mRates[i];
-        }
+    for (int i = 0; i < mRatesStatesCount; ++i) {
+        mStates[i] += pStep*mRates[i];
+    }
 
-        // Advance through time
+    // Keep track of our statistics
 
-        if (!qFuzzyCompare(realStep, mStep)) {
-            pVoi = pVoiEnd;
-        } else {
-            pVoi = voiStart+(++stepNumber)*mStep;
-        }
-    }
+    ++mRhsEvaluationsCount;
 }
 
 //==============================================================================
@@ -74,6 +74,7 @@ QString SecondOrderRungeKuttaSolverPlugin::id(const QString &pKisaoId) const
 
     static const QString Kisao0000381 = "KISAO:0000381";
     static const QString Kisao0000483 = "KISAO:0000483";
+    static const QString Kisao0000481 = "KISAO:0000481";
 
     if (pKisaoId == Kisao0000381) {
         return solverName();
@@ -83,6 +84,10 @@ QString SecondOrderRungeKuttaSolverPlugin::id(const QString &pKisaoId) const
         return StepId;
     }
 
+    if (pKisaoId == Kisao0000481) {
+        return InterpolateSolutionId;
+    }
+
     return {};
 }
 
@@ -102,6 +107,10 @@ QString SecondOrderRungeKuttaSolverPlugin::kisaoId(const QString &pId) const
         return "KISAO:0000483";
     }
 
+    if (pId == InterpolateSolutionId) {
+        return "KISAO:0000481";
+    }
+
     return {};
 }
 
@@ -130,11 +139,16 @@ Solver::Properties SecondOrderRungeKuttaSolverPlugin::solverProperties() const
     // Return the properties supported by the solver
 
     Descriptions stepDescriptions;
+    Descriptions interpolateSolutionDescriptions;
 
     stepDescriptions.insert("en", QString::fromUtf8("Step"));
     stepDescriptions.insert("fr", QString::fromUtf8("Pas"));
 
-    return { Solver::Property(Solver::Property::Type::DoubleGt0, StepId, stepDescriptions, {}, StepDefaultValue, true) };
+    interpolateSolutionDescriptions.insert("en", QString::fromUtf8("Interpolate solution"));
+    interpolateSolutionDescriptions.insert("fr", QString::fromUtf8("Interpoler solution"));
+
+    return { Solver::Property(Solver::Property::Type::DoubleGt0, StepId, stepDescriptions, {}, StepDefaultValue, true),
+             Solver::Property(Solver::Property::Type::Boolean, InterpolateSolutionId, interpolateSolutionDescriptions, {}, InterpolateSolutionDefaultValue, false) };
 }
 
 //==============================================================================
@@ -25,25 +25,6 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
-void doNonLinearSolve(char *pRuntime,
-                      void (*pFunction)(double *, double *, void *),
-                      double *pParameters, int pSize, void *pUserData)
-{
-    // Retrieve the NLA solver which we should use and solve our NLA system
-    // Note: we should always have an NLA solver, but better be safe than
-    //       sorry...
-
-    OpenCOR::Solver::NlaSolver *nlaSolver = OpenCOR::Solver::nlaSolver(pRuntime);
-
-    if (nlaSolver != nullptr) {
-        nlaSolver->solve(pFunction, pParameters, pSize, pUserData);
-    } else {
-        qWarning("WARNING | %s:%d: no NLA solver could be found.", __FILE__, __LINE__);
-    }
-}
-
-//==============================================================================
-
 namespace OpenCOR {
 
 //==============================================================================
@@ -52,7 +33,7 @@ extern "C" Q_DECL_EXPORT int solverInterfaceVersion()
 {
     // Version of the solver interface
 
-    return 2;
+    return 9;
 }
 
 //==============================================================================
@@ -70,6 +51,15 @@ void Solver::setProperties(const Properties &pProperties)
 
 //==============================================================================
 
+Solver::Statistics Solver::statistics() const
+{
+    // Return our statistics, which we don't have by default
+
+    return {};
+}
+
+//==============================================================================
+
 void Solver::emitError(const QString &pErrorMessage)
 {
     // Let people know that an error occured, but first reformat the error a
@@ -97,6 +87,82 @@ void Solver::emitError(const QString &pErrorMessage)
 
 //==============================================================================
 
+NlaSolver * OdeSolver::nlaSolver(NlaSolver *pNlaSolver)
+{
+    // By default, we don't solve NLA systems ourselves, so we use the given NLA
+    // solver as is
+
+    return pNlaSolver;
+}
+
+//==============================================================================
+
+bool OdeSolver::supportsSensitivities() const
+{
+    // By default, we don't support sensitivities
+
+    return false;
+}
+
+//==============================================================================
+
+void OdeSolver::setSensitivities(const QVector<int> &pConstants,
+                                 int pConstantsCount, double *pSensitivities,
+                                 ComputeComputedConstantsFunction pComputeComputedConstants)
+{
+    // Keep track of the constants with respect to which we want the
+    // sensitivities of our states (and of how many constants there are), as
+    // well as of where those sensitivities are to be stored and of how to
+    // compute our computed constants (since they may depend on those
+    // constants)
+
+    mSensitivityConstants = pConstants;
+    mConstantsCount = pConstantsCount;
+    mSensitivities = pSensitivities;
+
+    mComputeComputedConstants = pComputeComputedConstants;
+}
+
+//==============================================================================
+
+void OdeSolver::setRoots(int pRootsCount, ComputeRootsFunction pComputeRoots)
+{
+    // Keep track of our roots and of how to compute them
+
+    mRootsCount = pRootsCount;
+
+    mComputeRoots = pComputeRoots;
+}
+
+//==============================================================================
+
+void OdeSolver::setAlgebraicCount(int pAlgebraicCount)
+{
+    // Keep track of our number of algebraic variables
+
+    mAlgebraicCount = pAlgebraicCount;
+}
+
+//==============================================================================
+
+void OdeSolver::setEndingPoint(double pEndingPoint)
+{
+    // Keep track of our ending point
+
+    mEndingPoint = pEndingPoint;
+}
+
+//==============================================================================
+
+QVector<double> OdeSolver::events() const
+{
+    // Return our events, i.e. the points at which one of our roots was located
+
+    return mEvents;
+}
+
+//==============================================================================
+
 void OdeSolver::initialize(double pVoi, int pRatesStatesCount,
                            double *pConstants, double *pRates, double *pStates,
                            double *pAlgebraic,
@@ -127,42 +193,249 @@ void OdeSolver::reinitialize(double pVoi)
 
 //==============================================================================
 
-NlaSolver::~NlaSolver() = default;
+Solver::Statistics OdeSolver::statistics() const
+{
+    // Return the statistics that we keep track of by default, i.e. the number
+    // of steps and of RHS evaluations (which is all that fixed-step solvers can
+    // report)
+
+    Statistics res;
+
+    res.insert(StepsStatistic, mStepsCount);
+    res.insert(RhsEvaluationsStatistic, mRhsEvaluationsCount);
+
+    return res;
+}
+
+//==============================================================================
+
+FixedStepOdeSolver::~FixedStepOdeSolver()
+{
+    // Delete some internal objects
+
+    deleteArrays();
+}
 
 //==============================================================================
 
-QString objectAddress(QObject *pObject)
+void FixedStepOdeSolver::initialize(double pVoi, int pRatesStatesCount,
+                                    double *pConstants, double *pRates,
+                                    double *pStates, double *pAlgebraic,
+                                    ComputeRatesFunction pComputeRates)
 {
-    // Return the given object's address as a string
+    // Initialise the ODE solver itself
+
+    OdeSolver::initialize(pVoi, pRatesStatesCount, pConstants, pRates, pStates,
+                          pAlgebraic, pComputeRates);
+
+    // (Re)create the arrays that we need to interpolate our solution, if
+    // needed
+
+    deleteArrays();
 
-    return QString::number(quint64(pObject));
+    if (mInterpolateSolution) {
+        mY = new double[pRatesStatesCount] {};
+        mYRates = new double[pRatesStatesCount] {};
+        mPreviousY = new double[pRatesStatesCount] {};
+        mPreviousYRates = new double[pRatesStatesCount] {};
+    }
+
+    // Start from our current point
+
+    reinitialize(pVoi);
 }
 
 //==============================================================================
 
-NlaSolver * nlaSolver(const QString &pObjectAddress)
+void FixedStepOdeSolver::reinitialize(double pVoi)
 {
-    // Return the runtime's NLA solver
+    Q_UNUSED(pVoi)
 
-    QObject *object = reinterpret_cast<NlaSolver *>(QVariant(pObjectAddress).toULongLong());
+    // Our states may have been modified, so make sure that we restart from
+    // them the next time we are asked to solve our model
 
-    return reinterpret_cast<NlaSolver *>(QVariant(object->objectName()).toULongLong());
+    mStarted = false;
 }
 
 //==============================================================================
 
-void setNlaSolver(QObject *pObject, NlaSolver *pNlaSolver)
+void FixedStepOdeSolver::solve(double &pVoi, double pVoiEnd) const
 {
-    // Keep track of the runtime's NLA solver
-    // Note: normally, we would use QObject::setProperty(), but it doesn't play
-    //       well on Windows without a GUI (see https://bit.ly/2YCpzew). So,
-    //       instead, we use QObject::setObjectName() (!!)...
+    // Step to pVoiEnd, unless we are to interpolate our solution
+
+    if (!mInterpolateSolution) {
+        // Compute f(t_n, Y_n), if needed, i.e. if we have just been
+        // (re)initialised since, otherwise, it was computed at the end of our
+        // previous step
+
+        if (!mStarted) {
+            mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+
+            ++mRhsEvaluationsCount;
+
+            mStarted = true;
+        }
+
+        double voiStart = pVoi;
+
+        int stepNumber = 0;
+        double realStep = mStep;
+
+        while (!qFuzzyCompare(pVoi, pVoiEnd)) {
+            // Check that the time step is correct
+
+            if (pVoi+realStep > pVoiEnd) {
+                realStep = pVoiEnd-pVoi;
+            }
+
+            // Compute Y_n+1
+
+            doStep(pVoi, realStep);
+
+            // Advance through time
+
+            if (!qFuzzyCompare(realStep, mStep)) {
+                pVoi = pVoiEnd;
+            } else {
+                pVoi = voiStart+(++stepNumber)*mStep;
+            }
+
+            // Compute f(t_n+1, Y_n+1), which is f(t_n, Y_n) for our next step
+            // and which means that our rates are up to date when we are done
+
+            mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+
+            // Keep track of our statistics
+
+            ++mStepsCount;
+            ++mRhsEvaluationsCount;
+        }
+
+        return;
+    }
+
+    // Start from our current point, if needed
+
+    size_t arraySize = size_t(mRatesStatesCount)*SizeOfDouble;
+
+    if (!mStarted) {
+        mVoiStart = mVoi = mPreviousVoi = pVoi;
+        mStepNumber = 0;
+
+        memcpy(mY, mStates, arraySize);
+
+        mComputeRates(mVoi, mConstants, mYRates, mY, mAlgebraic);
+
+        ++mRhsEvaluationsCount;
+
+        mStarted = true;
+    }
 
-    pObject->setObjectName(objectAddress(pNlaSolver));
+    // Step through time until we reach or go past pVoiEnd, making sure that we
+    // don't go past our ending point
+
+    bool stepped = false;
+
+    while ((mVoi < pVoiEnd) && !qFuzzyCompare(mVoi, pVoiEnd)) {
+        // Make our current point our previous one and compute Y_n+1 from it,
+        // shortening our step if it would take us past our ending point
+
+        std::swap(mY, mPreviousY);
+        std::swap(mYRates, mPreviousYRates);
+
+        mPreviousVoi = mVoi;
+
+        memcpy(mStates, mPreviousY, arraySize);
+        memcpy(mRates, mPreviousYRates, arraySize);
+
+        double voi = mVoiStart+(++mStepNumber)*mStep;
+        bool lastStep = (voi > mEndingPoint) && !qFuzzyCompare(voi, mEndingPoint);
+
+        if (lastStep) {
+            voi = mEndingPoint;
+        }
+
+        doStep(mPreviousVoi, lastStep?voi-mPreviousVoi:mStep);
+
+        mVoi = voi;
+
+        memcpy(mY, mStates, arraySize);
+
+        // Compute f(t_n+1, Y_n+1), which we need to interpolate our solution
+        // and which is also f(t_n, Y_n) for our next step
+
+        mComputeRates(mVoi, mConstants, mYRates, mY, mAlgebraic);
+
+        // Keep track of our statistics
+
+        ++mStepsCount;
+        ++mRhsEvaluationsCount;
+
+        stepped = true;
+    }
+
+    // Retrieve our solution at pVoiEnd, either directly or using a cubic
+    // Hermite interpolation between our previous and current points (in which
+    // case we need to compute our rates)
+    // Note: if we retrieve our solution directly without having taken a step,
+    //       then our algebraic variables were last computed for another point,
+    //       so we need to compute our rates too...
+
+    if (qFuzzyCompare(mVoi, pVoiEnd)) {
+        memcpy(mStates, mY, arraySize);
+
+        if (stepped) {
+            memcpy(mRates, mYRates, arraySize);
+        } else {
+            mComputeRates(pVoiEnd, mConstants, mRates, mStates, mAlgebraic);
+
+            ++mRhsEvaluationsCount;
+        }
+    } else {
+        double step = mVoi-mPreviousVoi;
+        double theta = (pVoiEnd-mPreviousVoi)/step;
+        double oneMinusTheta = 1.0-theta;
+        double previousYCoefficient = (1.0+2.0*theta)*oneMinusTheta*oneMinusTheta;
+        double previousYRatesCoefficient = step*theta*oneMinusTheta*oneMinusTheta;
+        double yCoefficient = theta*theta*(3.0-2.0*theta);
+        double yRatesCoefficient = -step*theta*theta*oneMinusTheta;
+
+        for (int i = 0; i < mRatesStatesCount; ++i) {
+            mStates[i] = previousYCoefficient*mPreviousY[i]+previousYRatesCoefficient*mPreviousYRates[i]
+                        +yCoefficient*mY[i]+yRatesCoefficient*mYRates[i];
+        }
+
+        mComputeRates(pVoiEnd, mConstants, mRates, mStates, mAlgebraic);
+
+        ++mRhsEvaluationsCount;
+    }
+
+    pVoi = pVoiEnd;
 }
 
 //==============================================================================
 
+void FixedStepOdeSolver::deleteArrays()
+{
+    // Delete the arrays that we use to interpolate our solution
+
+    delete[] mY;
+    delete[] mYRates;
+    delete[] mPreviousY;
+    delete[] mPreviousYRates;
+
+    mY = nullptr;
+    mYRates = nullptr;
+    mPreviousY = nullptr;
+    mPreviousYRates = nullptr;
+}
+
+//==============================================================================
+
+NlaSolver::~NlaSolver() = default;
+
+//==============================================================================
+
 Property::Property(Type pType, const QString &pId,
                    const Descriptions &pDescriptions,
                    const QStringList &pListValues,
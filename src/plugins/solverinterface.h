@@ -29,14 +29,9 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QtNumeric>
 #include <QVariant>
-
-//==============================================================================
-
-extern "C" void doNonLinearSolve(char *pRuntime,
-                                 void (*pFunction)(double *, double *, void *),
-                                 double *pParameters, int pSize,
-                                 void *pUserData);
+#include <QVector>
 
 //==============================================================================
 
@@ -51,15 +46,41 @@ enum {
 
 //==============================================================================
 
+// Solver statistics
+// Note: ODE solvers report (some of) our "ODE" statistics while NLA solvers
+//       report (some of) our "NLA" statistics...
+
+static const auto RhsEvaluationsStatistic      = QStringLiteral("rhsEvaluations");
+static const auto StepsStatistic               = QStringLiteral("steps");
+static const auto RejectedStepsStatistic       = QStringLiteral("rejectedSteps");
+static const auto JacobianEvaluationsStatistic = QStringLiteral("jacobianEvaluations");
+static const auto LinearSolverSetupsStatistic  = QStringLiteral("linearSolverSetups");
+static const auto LinearIterationsStatistic    = QStringLiteral("linearIterations");
+static const auto NonlinearIterationsStatistic = QStringLiteral("nonlinearIterations");
+
+static const auto SensitivityRhsEvaluationsStatistic = QStringLiteral("sensitivityRhsEvaluations");
+static const auto RootEvaluationsStatistic           = QStringLiteral("rootEvaluations");
+static const auto EventsStatistic                    = QStringLiteral("events");
+
+static const auto NlaSolvesStatistic              = QStringLiteral("nlaSolves");
+static const auto NlaIterationsStatistic          = QStringLiteral("nlaIterations");
+static const auto NlaFunctionEvaluationsStatistic = QStringLiteral("nlaFunctionEvaluations");
+static const auto NlaJacobianEvaluationsStatistic = QStringLiteral("nlaJacobianEvaluations");
+
+//==============================================================================
+
 class Solver : public QObject
 {
     Q_OBJECT
 
 public:
     using Properties = QMap<QString, QVariant>;
+    using Statistics = QMap<QString, quint64>;
 
     void setProperties(const Properties &pProperties);
 
+    virtual Statistics statistics() const;
+
     void emitError(const QString &pErrorMessage);
 
 protected:
@@ -70,11 +91,61 @@ signals:
 };
 
 //==============================================================================
+// Note #1: the sensitivities of our states with respect to the given constants
+//          are stored in pSensitivities, one constant after the other, i.e.
+//          pSensitivities[i*pRatesStatesCount+j] = dY_j/dC_i. They must be set
+//          before calling initialize() and only if supportsSensitivities()
+//          returns true. We are also told how many constants there are, so
+//          that the solver can work on its own (perturbed) copy of them...
+// Note #2: the roots of a model change sign whenever the condition of one of
+//          its piecewise expressions changes value. They must also be set
+//          before calling initialize(). A solver that supports root finding
+//          stops at each of them and keeps track of where they are in mEvents,
+//          while other solvers simply ignore them...
+// Note #3: an ODE solver may solve the NLA systems of a model as part of its
+//          own (Newton) iteration. In that case, nlaSolver() returns the NLA
+//          solver that must be used while computing our model and which relies
+//          on pNlaSolver whenever an NLA system actually needs to be solved.
+//          By default, pNlaSolver is used as is...
+// Note #4: once solve() returns, mRates and the algebraic variables on which
+//          they depend must be up to date with mStates at pVoiEnd. This means
+//          that whoever uses our results only needs to compute the remaining
+//          algebraic variables (see SimulationResults::addPoint())...
+// Note #5: an ODE solver may compute our rates in several threads at once, in
+//          which case each thread needs its own copy of our algebraic
+//          variables, hence we may be told how many of them there are. This
+//          must also be done before calling initialize(). If we are not told,
+//          then mAlgebraicCount is -1 and our rates must only be computed in
+//          the calling thread...
+// Note #6: an ODE solver that doesn't stop at pVoiEnd (e.g. because it
+//          interpolates its solution) must still not go past our ending point,
+//          if we were told about it. This must also be done before calling
+//          initialize()...
+
+class NlaSolver;
 
 class OdeSolver : public Solver
 {
 public:
     using ComputeRatesFunction = void (*)(double pVoi, double *pConstants, double *pRates, double *pStates, double *pAlgebraic);
+    using ComputeComputedConstantsFunction = ComputeRatesFunction;
+    using ComputeRootsFunction = void (*)(double pVoi, double *pConstants, double *pRates, double *pStates, double *pAlgebraic, double *pRoots);
+
+    virtual NlaSolver * nlaSolver(NlaSolver *pNlaSolver);
+
+    virtual bool supportsSensitivities() const;
+
+    void setSensitivities(const QVector<int> &pConstants, int pConstantsCount,
+                          double *pSensitivities,
+                          ComputeComputedConstantsFunction pComputeComputedConstants);
+
+    void setRoots(int pRootsCount, ComputeRootsFunction pComputeRoots);
+
+    void setAlgebraicCount(int pAlgebraicCount);
+
+    void setEndingPoint(double pEndingPoint);
+
+    QVector<double> events() const;
 
     virtual void initialize(double pVoi, int pRatesStatesCount,
                             double *pConstants, double *pRates, double *pStates,
@@ -84,6 +155,8 @@ public:
 
     virtual void solve(double &pVoi, double pVoiEnd) const = 0;
 
+    Statistics statistics() const override;
+
 protected:
     int mRatesStatesCount = 0;
 
@@ -93,6 +166,68 @@ protected:
     double *mAlgebraic = nullptr;
 
     ComputeRatesFunction mComputeRates = nullptr;
+
+    QVector<int> mSensitivityConstants;
+    int mConstantsCount = 0;
+    double *mSensitivities = nullptr;
+
+    ComputeComputedConstantsFunction mComputeComputedConstants = nullptr;
+
+    int mRootsCount = 0;
+
+    ComputeRootsFunction mComputeRoots = nullptr;
+
+    int mAlgebraicCount = -1;
+
+    double mEndingPoint = qInf();
+
+    mutable QVector<double> mEvents;
+
+    mutable quint64 mStepsCount = 0;
+    mutable quint64 mRhsEvaluationsCount = 0;
+};
+
+//==============================================================================
+// Note: a fixed-step ODE solver only needs to implement doStep(), which
+//       computes Y_n+1 in mStates from Y_n in mStates and f(t_n, Y_n) in
+//       mRates. By default, we step to pVoiEnd, shortening our last step if
+//       needed. If we are to interpolate our solution, then we instead always
+//       use the same step (except to reach our ending point) and interpolate
+//       our solution at pVoiEnd...
+
+class FixedStepOdeSolver : public OdeSolver
+{
+public:
+    ~FixedStepOdeSolver() override;
+
+    void initialize(double pVoi, int pRatesStatesCount, double *pConstants,
+                    double *pRates, double *pStates, double *pAlgebraic,
+                    ComputeRatesFunction pComputeRates) override;
+    void reinitialize(double pVoi) override;
+
+    void solve(double &pVoi, double pVoiEnd) const override;
+
+protected:
+    double mStep = 1.0;
+    bool mInterpolateSolution = false;
+
+    virtual void doStep(double pVoi, double pStep) const = 0;
+
+private:
+    mutable bool mStarted = false;
+
+    mutable double mVoiStart = 0.0;
+    mutable int mStepNumber = 0;
+
+    mutable double mVoi = 0.0;
+    mutable double mPreviousVoi = 0.0;
+
+    mutable double *mY = nullptr;
+    mutable double *mYRates = nullptr;
+    mutable double *mPreviousY = nullptr;
+    mutable double *mPreviousYRates = nullptr;
+
+    void deleteArrays();
 };
 
 //==============================================================================
@@ -111,14 +246,6 @@ public:
 
 //==============================================================================
 
-QString objectAddress(QObject *pObject);
-
-NlaSolver * nlaSolver(const QString &pObjectAddress);
-
-void setNlaSolver(QObject *pObject, NlaSolver *pNlaSolver);
-
-//==============================================================================
-
 enum class Type {
     Nla,
     Ode
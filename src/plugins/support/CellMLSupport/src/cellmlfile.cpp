@@ -23,19 +23,23 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 #include "cellmlfile.h"
 #include "cellmlfilecellml10exporter.h"
+#include "cellmlfileimportcontentscache.h"
 #include "cellmlfilemanager.h"
 #include "centralwidget.h"
 #include "corecliutils.h"
 #include "coreguiutils.h"
 #include "filemanager.h"
+#include "tracer.h"
 
 //==============================================================================
 
 #include <QDir>
 #include <QDomDocument>
 #include <QFile>
+#include <QFileInfo>
 #include <QStringList>
 #include <QUrl>
+#include <QXmlStreamReader>
 
 //==============================================================================
 
@@ -69,6 +73,10 @@ CellmlFile::CellmlFile(const QString &pFileName) :
 CellmlFile::~CellmlFile()
 {
     // Reset ourselves
+    // Note: we are only being deleted, so we don't want our remote imports to
+    //       be removed from our process-wide cache (see reset())...
+
+    mImportContents.clear();
 
     try {
         reset();
@@ -108,6 +116,19 @@ void CellmlFile::reset()
     mFullInstantiationNeeded = true;
     mDependenciesNeeded = true;
 
+    // Remove our remote imports from our process-wide cache, so that they get
+    // downloaded again if we are to be reloaded
+    // Note: this is not needed for our local imports since they get reloaded
+    //       if they have been modified since they were cached...
+
+    for (auto importContents = mImportContents.constBegin(),
+              importContentsEnd = mImportContents.constEnd();
+         importContents != importContentsEnd; ++importContents) {
+        if (!QUrl(importContents.key()).host().isEmpty()) {
+            CellmlFileImportContentsCache::instance()->uncache(importContents.key());
+        }
+    }
+
     mImportContents.clear();
 
     mUsedCmetaIds.clear();
@@ -159,9 +180,172 @@ void CellmlFile::retrieveImports(const QString &pXmlBase,
 
 //==============================================================================
 
+static QStringList importFileNamesOrUrls(const QString &pFileNameOrUrl,
+                                         const QString &pFileContents)
+{
+    // Return the file name or URL of the imports found in the given contents
+    // Note: we scan the given contents rather than instantiate them using the
+    //       CellML API, which is much cheaper. We don't, however, account for
+    //       xml:base attributes, meaning that we may retrieve the wrong file
+    //       name or URL for some imports, in which case they will simply be
+    //       loaded when instantiated (see fullyInstantiateImports())...
+
+    static const QString XlinkNamespace = "http://www.w3.org/1999/xlink";
+
+    QUrl xmlBase = QUrl(pFileNameOrUrl).host().isEmpty()?
+                       QUrl::fromLocalFile(pFileNameOrUrl):
+                       QUrl(pFileNameOrUrl);
+    QXmlStreamReader xmlStreamReader(pFileContents);
+    QStringList res;
+
+    while (!xmlStreamReader.atEnd()) {
+        if (   (xmlStreamReader.readNext() == QXmlStreamReader::StartElement)
+            && (xmlStreamReader.name() == "import")) {
+            QString xlinkHref = xmlStreamReader.attributes().value(XlinkNamespace, "href").toString();
+
+            if (!xlinkHref.isEmpty()) {
+                bool dummy;
+                QString fileNameOrUrl;
+
+                Core::checkFileNameOrUrl(xmlBase.resolved(xlinkHref).toString(),
+                                         dummy, fileNameOrUrl);
+
+                res << fileNameOrUrl;
+            }
+        }
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+static QString importFileNameOrUrl(iface::cellml_api::CellMLImport *pImport,
+                                   const QString &pImportXmlBase,
+                                   bool &pIsLocalFile)
+{
+    // Return the file name or URL of the given import
+
+    QString xlinkHrefString = QString::fromStdWString(pImport->xlinkHref()->asText());
+    QString res;
+
+    Core::checkFileNameOrUrl(QUrl(pImportXmlBase).resolved(xlinkHrefString).toString(),
+                             pIsLocalFile, res);
+
+    return res;
+}
+
+//==============================================================================
+
+bool CellmlFile::prefetchImports(const QString &pFileNameOrUrl,
+                                 QString &pFileContents,
+                                 const QList<iface::cellml_api::CellMLImport *> &pImportList,
+                                 const QStringList &pImportXmlBaseList)
+{
+    // Load the contents of the given import, as well as that of all the other
+    // imports that are waiting to be instantiated and that we don't know about,
+    // all at once, and cache them. Then, do the same with the imports of the
+    // imports that we have just loaded, and so on, so that we only need one
+    // round trip per level of imports rather than one per import
+    // Note: our cache is bounded, so the contents of the given import may get
+    //       evicted before we are done, hence we return it directly...
+
+    CellmlFileImportContentsCache *importContentsCache = CellmlFileImportContentsCache::instance();
+    QStringList fileNamesOrUrls = { pFileNameOrUrl };
+    bool res = false;
+
+    for (int i = 0, iMax = pImportList.count(); i < iMax; ++i) {
+        iface::cellml_api::CellMLImport *import = pImportList[i];
+
+        if (!import->wasInstantiated()) {
+            bool isLocalFile;
+            QString fileNameOrUrl = importFileNameOrUrl(import, pImportXmlBaseList[i], isLocalFile);
+            QString dummy;
+
+            if (   !fileNamesOrUrls.contains(fileNameOrUrl)
+                && (fileNameOrUrl != mFileName)
+                && !mImportContents.contains(fileNameOrUrl)
+                && !importContentsCache->contents(fileNameOrUrl, isLocalFile, dummy)) {
+                fileNamesOrUrls << fileNameOrUrl;
+            }
+        }
+    }
+
+    QStringList knownFileNamesOrUrls = fileNamesOrUrls;
+
+    while (!fileNamesOrUrls.isEmpty()) {
+        // Load and cache the contents of our current imports
+
+        bool hasRemoteFiles = false;
+
+        for (const auto &fileNameOrUrl : fileNamesOrUrls) {
+            if (!QUrl(fileNameOrUrl).host().isEmpty()) {
+                hasRemoteFiles = true;
+
+                break;
+            }
+        }
+
+        QMap<QString, QByteArray> filesContents;
+
+        if (hasRemoteFiles) {
+            Core::showCentralBusyWidget();
+        }
+
+        Core::readFiles(fileNamesOrUrls, filesContents);
+
+        if (hasRemoteFiles) {
+            Core::hideCentralBusyWidget();
+        }
+
+        fileNamesOrUrls.clear();
+
+        for (auto fileContents = filesContents.constBegin(),
+                  fileContentsEnd = filesContents.constEnd();
+             fileContents != fileContentsEnd; ++fileContents) {
+            QString contents = fileContents.value();
+
+            importContentsCache->cache(fileContents.key(),
+                                       QUrl(fileContents.key()).host().isEmpty(),
+                                       contents);
+
+            if (fileContents.key() == pFileNameOrUrl) {
+                pFileContents = contents;
+
+                res = true;
+            }
+
+            // Keep track of the imports of the import that we have just loaded
+            // that we don't know about
+
+            for (const auto &fileNameOrUrl : importFileNamesOrUrls(fileContents.key(), contents)) {
+                QString dummy;
+
+                if (   !knownFileNamesOrUrls.contains(fileNameOrUrl)
+                    && (fileNameOrUrl != mFileName)
+                    && !mImportContents.contains(fileNameOrUrl)
+                    && !importContentsCache->contents(fileNameOrUrl,
+                                                      QUrl(fileNameOrUrl).host().isEmpty(),
+                                                      dummy)) {
+                    knownFileNamesOrUrls << fileNameOrUrl;
+                    fileNamesOrUrls << fileNameOrUrl;
+                }
+            }
+        }
+    }
+
+    return res;
+}
+
+//==============================================================================
+
 bool CellmlFile::fullyInstantiateImports(iface::cellml_api::Model *pModel,
                                          CellmlFileIssues &pIssues)
 {
+    // Trace ourselves
+
+    Core::TraceEvent traceEvent("CellmlFile::fullyInstantiateImports");
+
     // Fully instantiate all the imports, but only if we are not directly
     // dealing with our model or if we are dealing with a non CellML 1.0 model,
     // and then keep track of that fact (so we don't fully instantiate everytime
@@ -182,7 +366,8 @@ bool CellmlFile::fullyInstantiateImports(iface::cellml_api::Model *pModel,
             //       call CDA_CellMLImport::instantiateFromText() instead, which
             //       requires loading the imported CellML file. Otherwise, to
             //       speed things up as much as possible, we cache the contents
-            //       of the URLs that we load...
+            //       of the URLs that we load and load all the imports that we
+            //       know about at once...
 
             // Retrieve the list of imports, together with their XML base values
 
@@ -211,13 +396,11 @@ bool CellmlFile::fullyInstantiateImports(iface::cellml_api::Model *pModel,
                     //       instantiate it from text instead...
 
                     QString xlinkHrefString = QString::fromStdWString(import->xlinkHref()->asText());
-                    QString url = QUrl(importXmlBase).resolved(xlinkHrefString).toString();
                     bool isLocalFile;
-                    QString fileNameOrUrl;
+                    QString fileNameOrUrl = importFileNameOrUrl(import, importXmlBase, isLocalFile);
                     bool dummy;
                     QString xmlBaseFileNameOrUrl;
 
-                    Core::checkFileNameOrUrl(url, isLocalFile, fileNameOrUrl);
                     Core::checkFileNameOrUrl(importXmlBase, dummy, xmlBaseFileNameOrUrl);
 
                     if (fileNameOrUrl == mFileName) {
@@ -232,20 +415,17 @@ bool CellmlFile::fullyInstantiateImports(iface::cellml_api::Model *pModel,
 
                         import->instantiateFromText(mImportContents.value(fileNameOrUrl).toStdWString());
                     } else {
-                        // We haven't already loaded the import contents, so do
-                        // so now, with a busy widget if requested and if we are
-                        // not dealing with a local file
+                        // We haven't already loaded the import contents, so
+                        // check whether it has been cached and, if not, load
+                        // it now, together with that of all the imports in our
+                        // list
 
                         QString fileContents;
+                        bool res = CellmlFileImportContentsCache::instance()->contents(fileNameOrUrl, isLocalFile, fileContents);
 
-                        if (!isLocalFile) {
-                            Core::showCentralBusyWidget();
-                        }
-
-                        bool res = Core::readFile(fileNameOrUrl, fileContents);
-
-                        if (!isLocalFile) {
-                            Core::hideCentralBusyWidget();
+                        if (!res) {
+                            res = prefetchImports(fileNameOrUrl, fileContents,
+                                                  importList, importXmlBaseList);
                         }
 
                         if (res) {
@@ -326,6 +506,10 @@ bool CellmlFile::load(const QString &pFileContents,
                       ObjRef<iface::cellml_api::Model> *pModel,
                       CellmlFileIssues &pIssues)
 {
+    // Trace ourselves
+
+    Core::TraceEvent traceEvent("CellmlFile::load");
+
     // Make sure that pIssues is empty
 
     pIssues.clear();
@@ -166,6 +166,10 @@ private:
                          QList<iface::cellml_api::CellMLImport *> &pImportList,
                          QStringList &pImportXmlBaseList);
 
+    bool prefetchImports(const QString &pFileNameOrUrl,
+                         QString &pFileContents,
+                         const QList<iface::cellml_api::CellMLImport *> &pImportList,
+                         const QStringList &pImportXmlBaseList);
     bool fullyInstantiateImports(iface::cellml_api::Model *pModel,
                                  CellmlFileIssues &pIssues);
 
@@ -0,0 +1,240 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+//==============================================================================
+// CellML file import contents cache
+//==============================================================================
+
+#include "cellmlfileimportcontentscache.h"
+#include "corecliutils.h"
+
+//==============================================================================
+
+#include <QFileInfo>
+#include <QMutexLocker>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace CellMLSupport {
+
+//==============================================================================
+// Note: the contents of imports is cached process-wide, so that the same import
+//       (e.g. a units definitions file) is only ever loaded once. A cached
+//       local file is reloaded if it has been modified since it was cached,
+//       while a cached remote file is kept until a CellML file that imports it
+//       gets reset (e.g. when it is reloaded). Also, identical contents (e.g.
+//       the same file at different URLs) is only stored once, thanks to its
+//       SHA-1 value. Finally, the size of the cached contents is bounded, the
+//       least recently used contents being evicted first...
+
+static const int DefaultMaximumSize = 64*1024*1024;
+
+//==============================================================================
+
+CellmlFileImportContentsCache::CellmlFileImportContentsCache() :
+    mContents(DefaultMaximumSize)
+{
+}
+
+//==============================================================================
+
+CellmlFileImportContentsCache * CellmlFileImportContentsCache::instance()
+{
+    // Return the 'global' instance of our CellML file import contents cache
+    // class
+
+    static CellmlFileImportContentsCache instance;
+
+    return static_cast<CellmlFileImportContentsCache *>(Core::globalInstance("OpenCOR::CellMLSupport::CellmlFileImportContentsCache::instance()",
+                                                                             &instance));
+}
+
+//==============================================================================
+
+bool CellmlFileImportContentsCache::contents(const QString &pFileNameOrUrl,
+                                             bool pIsLocalFile,
+                                             QString &pContents)
+{
+    // Retrieve the cached contents of the given import, if any and if still up
+    // to date
+
+    QMutexLocker locker(&mMutex);
+
+    auto sha1 = mSha1s.find(pFileNameOrUrl);
+
+    if (   (sha1 == mSha1s.end())
+        || (   pIsLocalFile
+            && (sha1.value().second != QFileInfo(pFileNameOrUrl).lastModified()))) {
+        return false;
+    }
+
+    // Make sure that the contents of the given import has not been evicted
+
+    QString *contents = mContents.object(sha1.value().first);
+
+    if (contents == nullptr) {
+        mSha1s.erase(sha1);
+
+        return false;
+    }
+
+    pContents = *contents;
+
+    return true;
+}
+
+//==============================================================================
+
+void CellmlFileImportContentsCache::cache(const QString &pFileNameOrUrl,
+                                          bool pIsLocalFile,
+                                          const QString &pContents)
+{
+    // Cache the contents of the given import, replacing its previous contents,
+    // if any (e.g. a local file that has been modified)
+
+    QString sha1 = Core::sha1(pContents);
+    QMutexLocker locker(&mMutex);
+    QString oldSha1 = mSha1s.value(pFileNameOrUrl).first;
+
+    mSha1s.insert(pFileNameOrUrl,
+                  qMakePair(sha1,
+                            pIsLocalFile?
+                                QFileInfo(pFileNameOrUrl).lastModified():
+                                QDateTime()));
+
+    if (!oldSha1.isEmpty() && (oldSha1 != sha1)) {
+        removeContents(oldSha1);
+    }
+
+    if (!mContents.contains(sha1)) {
+        mContents.insert(sha1, new QString(pContents), pContents.size());
+    }
+}
+
+//==============================================================================
+
+void CellmlFileImportContentsCache::uncache(const QString &pFileNameOrUrl)
+{
+    // Remove the given import from our cache, as well as its contents, unless
+    // another import has the same contents
+
+    QMutexLocker locker(&mMutex);
+
+    auto sha1 = mSha1s.find(pFileNameOrUrl);
+
+    if (sha1 == mSha1s.end()) {
+        return;
+    }
+
+    QString oldSha1 = sha1.value().first;
+
+    mSha1s.erase(sha1);
+
+    removeContents(oldSha1);
+}
+
+//==============================================================================
+
+void CellmlFileImportContentsCache::clear()
+{
+    // Clear our cache
+
+    QMutexLocker locker(&mMutex);
+
+    mSha1s.clear();
+    mContents.clear();
+}
+
+//==============================================================================
+
+int CellmlFileImportContentsCache::maximumSize() const
+{
+    // Return the maximum size of our cached contents, in characters
+
+    QMutexLocker locker(&mMutex);
+
+    return mContents.maxCost();
+}
+
+//==============================================================================
+
+void CellmlFileImportContentsCache::setMaximumSize(int pMaximumSize)
+{
+    // Set the maximum size of our cached contents, in characters, evicting
+    // some of them if needed
+
+    QMutexLocker locker(&mMutex);
+
+    mContents.setMaxCost(pMaximumSize);
+}
+
+//==============================================================================
+
+int CellmlFileImportContentsCache::fileNamesOrUrlsCount() const
+{
+    // Return the number of imports which contents is cached
+
+    QMutexLocker locker(&mMutex);
+
+    int res = 0;
+
+    for (const auto &sha1 : mSha1s) {
+        if (mContents.contains(sha1.first)) {
+            ++res;
+        }
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+int CellmlFileImportContentsCache::contentsCount() const
+{
+    // Return the number of contents that we cache
+
+    QMutexLocker locker(&mMutex);
+
+    return mContents.count();
+}
+
+//==============================================================================
+
+void CellmlFileImportContentsCache::removeContents(const QString &pSha1)
+{
+    // Remove the given contents, unless an import still has it
+    // Note: our mutex must already be locked...
+
+    for (const auto &sha1 : mSha1s) {
+        if (sha1.first == pSha1) {
+            return;
+        }
+    }
+
+    mContents.remove(pSha1);
+}
+
+//==============================================================================
+
+} // namespace CellMLSupport
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
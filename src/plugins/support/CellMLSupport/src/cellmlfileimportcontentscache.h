@@ -0,0 +1,83 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+//==============================================================================
+// CellML file import contents cache
+//==============================================================================
+
+#pragma once
+
+//==============================================================================
+
+#include "cellmlsupportglobal.h"
+
+//==============================================================================
+
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace CellMLSupport {
+
+//==============================================================================
+
+class CELLMLSUPPORT_EXPORT CellmlFileImportContentsCache
+{
+public:
+    static CellmlFileImportContentsCache * instance();
+
+    bool contents(const QString &pFileNameOrUrl, bool pIsLocalFile,
+                  QString &pContents);
+
+    void cache(const QString &pFileNameOrUrl, bool pIsLocalFile,
+               const QString &pContents);
+    void uncache(const QString &pFileNameOrUrl);
+
+    void clear();
+
+    int maximumSize() const;
+    void setMaximumSize(int pMaximumSize);
+
+    int fileNamesOrUrlsCount() const;
+    int contentsCount() const;
+
+private:
+    mutable QMutex mMutex;
+
+    QHash<QString, QPair<QString, QDateTime>> mSha1s;
+    QCache<QString, QString> mContents;
+
+    explicit CellmlFileImportContentsCache();
+
+    void removeContents(const QString &pSha1);
+};
+
+//==============================================================================
+
+} // namespace CellMLSupport
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -445,6 +445,112 @@ CellmlFileRdfTriples::CellmlFileRdfTriples(CellmlFile *pCellmlFile) :
 
 //==============================================================================
 
+CellmlFileRdfTriples & CellmlFileRdfTriples::operator<<(CellmlFileRdfTriple *pRdfTriple)
+{
+    // Add the given RDF triple to ourselves and index it
+    // Note: our RDF triples can only be modified through our own methods, so
+    //       that our indexes always reflect them...
+
+    mRdfTriples << pRdfTriple;
+
+    index(pRdfTriple);
+
+    return *this;
+}
+
+//==============================================================================
+
+void CellmlFileRdfTriples::clear()
+{
+    // Clear ourselves and our indexes
+
+    mRdfTriples.clear();
+
+    mSubjectIndex.clear();
+    mMetadataIdIndex.clear();
+}
+
+//==============================================================================
+
+bool CellmlFileRdfTriples::isEmpty() const
+{
+    // Return whether we have no RDF triples
+
+    return mRdfTriples.isEmpty();
+}
+
+//==============================================================================
+
+int CellmlFileRdfTriples::count() const
+{
+    // Return our number of RDF triples
+
+    return mRdfTriples.count();
+}
+
+//==============================================================================
+
+CellmlFileRdfTriple * CellmlFileRdfTriples::first() const
+{
+    // Return our first RDF triple
+
+    return mRdfTriples.first();
+}
+
+//==============================================================================
+
+CellmlFileRdfTriples::ConstIterator CellmlFileRdfTriples::begin() const
+{
+    // Return an iterator to our first RDF triple
+
+    return mRdfTriples.constBegin();
+}
+
+//==============================================================================
+
+CellmlFileRdfTriples::ConstIterator CellmlFileRdfTriples::end() const
+{
+    // Return an iterator to after our last RDF triple
+
+    return mRdfTriples.constEnd();
+}
+
+//==============================================================================
+
+void CellmlFileRdfTriples::index(CellmlFileRdfTriple *pRdfTriple)
+{
+    // Index the given RDF triple by subject and metadata id
+    // Note: we keep our indexed RDF triples in the order in which they were
+    //       added, so that our lookups return them in the same order as if we
+    //       were to go through all of our RDF triples...
+
+    mSubjectIndex[pRdfTriple->subject()->asString()] << pRdfTriple;
+    mMetadataIdIndex[pRdfTriple->metadataId()] << pRdfTriple;
+}
+
+//==============================================================================
+
+void CellmlFileRdfTriples::unindex(CellmlFileRdfTriple *pRdfTriple)
+{
+    // Remove the given RDF triple from our indexes
+
+    QString subject = pRdfTriple->subject()->asString();
+    QString metadataId = pRdfTriple->metadataId();
+
+    mSubjectIndex[subject].removeOne(pRdfTriple);
+    mMetadataIdIndex[metadataId].removeOne(pRdfTriple);
+
+    if (mSubjectIndex.value(subject).isEmpty()) {
+        mSubjectIndex.remove(subject);
+    }
+
+    if (mMetadataIdIndex.value(metadataId).isEmpty()) {
+        mMetadataIdIndex.remove(metadataId);
+    }
+}
+
+//==============================================================================
+
 CellmlFileRdfTriple::Type CellmlFileRdfTriples::type() const
 {
     // Return the type of the RDF triples
@@ -530,27 +636,24 @@ bool CellmlFileRdfTriple::decodeTerm(const QString &pTerm, QString &pResource,
 //==============================================================================
 
 void CellmlFileRdfTriples::recursiveAssociatedWith(CellmlFileRdfTriples &pRdfTriples,
+                                                   QSet<CellmlFileRdfTriple *> &pVisitedRdfTriples,
                                                    CellmlFileRdfTriple *pRdfTriple) const
 {
-    // Add pRdfTriple to pRdfTriples, but only if it's not already part of
-    // pRdfTriples
+    // Add pRdfTriple to pRdfTriples, but only if we haven't already visited it
     // Note: indeed, a given RDF triple may be referenced more than once...
 
-    if (pRdfTriples.contains(pRdfTriple)) {
+    if (pVisitedRdfTriples.contains(pRdfTriple)) {
         return;
     }
 
+    pVisitedRdfTriples << pRdfTriple;
     pRdfTriples << pRdfTriple;
 
     // Recursively add all the RDF triples, which subject matches that of
     // pRdfTriple's object
 
-    QString rdfTripleObject = pRdfTriple->object()->asString();
-
-    for (auto rdfTriple : *this) {
-        if (rdfTriple->subject()->asString() == rdfTripleObject) {
-            recursiveAssociatedWith(pRdfTriples, rdfTriple);
-        }
+    for (auto rdfTriple : mSubjectIndex.value(pRdfTriple->object()->asString())) {
+        recursiveAssociatedWith(pRdfTriples, pVisitedRdfTriples, rdfTriple);
     }
 }
 
@@ -562,17 +665,10 @@ CellmlFileRdfTriples CellmlFileRdfTriples::associatedWith(iface::cellml_api::Cel
     // with the given element's metadata id
 
     CellmlFileRdfTriples res = CellmlFileRdfTriples(mCellmlFile);
-    QString cmetaId = QString::fromStdWString(pElement->cmetaId());
+    QSet<CellmlFileRdfTriple *> visitedRdfTriples;
 
-    for (auto rdfTriple : *this) {
-        // Retrieve the RDF triple's subject so we can determine whether it's
-        // from the group of RDF triples in which we are interested
-
-        if (cmetaId == rdfTriple->metadataId()) {
-            // It's the correct metadata id, so add it to our list
-
-            recursiveAssociatedWith(res, rdfTriple);
-        }
+    for (auto rdfTriple : mMetadataIdIndex.value(QString::fromStdWString(pElement->cmetaId()))) {
+        recursiveAssociatedWith(res, visitedRdfTriples, rdfTriple);
     }
 
     return res;
@@ -584,7 +680,7 @@ CellmlFileRdfTriple * CellmlFileRdfTriples::add(CellmlFileRdfTriple *pRdfTriple)
 {
     // Add the given RDF triple
 
-    append(pRdfTriple);
+    *this << pRdfTriple;
 
     // Create a CellML API version of the RDF triple
 
@@ -616,7 +712,8 @@ bool CellmlFileRdfTriples::removeRdfTriples(const CellmlFileRdfTriples &pRdfTrip
         for (auto rdfTriple : pRdfTriples) {
             // Remove the RDF triple
 
-            removeOne(rdfTriple);
+            mRdfTriples.removeOne(rdfTriple);
+            unindex(rdfTriple);
 
             // Remove the CellML API version of the RDF triple from its data
             // source
@@ -666,8 +763,9 @@ bool CellmlFileRdfTriples::remove(iface::cellml_api::CellMLElement *pElement)
 bool CellmlFileRdfTriples::removeAll()
 {
     // Call our generic remove function
+    // Note: we use a copy of ourselves since we are going to be modified...
 
-    return removeRdfTriples(*this);
+    return removeRdfTriples(CellmlFileRdfTriples(*this));
 }
 
 //==============================================================================
@@ -30,6 +30,8 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QHash>
+#include <QSet>
 #include <QStringList>
 
 //==============================================================================
@@ -159,11 +161,25 @@ private:
 
 //==============================================================================
 
-class CELLMLSUPPORT_EXPORT CellmlFileRdfTriples: public QList<CellmlFileRdfTriple *>
+class CELLMLSUPPORT_EXPORT CellmlFileRdfTriples
 {
 public:
+    using ConstIterator = QList<CellmlFileRdfTriple *>::const_iterator;
+
     explicit CellmlFileRdfTriples(CellmlFile *pCellmlFile);
 
+    CellmlFileRdfTriples & operator<<(CellmlFileRdfTriple *pRdfTriple);
+
+    void clear();
+
+    bool isEmpty() const;
+    int count() const;
+
+    CellmlFileRdfTriple * first() const;
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
     CellmlFileRdfTriple::Type type() const;
 
     CellmlFileRdfTriples associatedWith(iface::cellml_api::CellMLElement *pElement) const;
@@ -179,9 +195,18 @@ public:
 private:
     CellmlFile *mCellmlFile;
 
+    QList<CellmlFileRdfTriple *> mRdfTriples;
+
     QStringList mOriginalRdfTriples;
 
+    QHash<QString, QList<CellmlFileRdfTriple *>> mSubjectIndex;
+    QHash<QString, QList<CellmlFileRdfTriple *>> mMetadataIdIndex;
+
+    void index(CellmlFileRdfTriple *pRdfTriple);
+    void unindex(CellmlFileRdfTriple *pRdfTriple);
+
     void recursiveAssociatedWith(CellmlFileRdfTriples &pRdfTriples,
+                                 QSet<CellmlFileRdfTriple *> &pVisitedRdfTriples,
                                  CellmlFileRdfTriple *pRdfTriple) const;
 
     bool removeRdfTriples(const CellmlFileRdfTriples &pRdfTriples);
@@ -33,16 +33,19 @@ along with this program. If not, see <https://gnu.org/licenses>.
 #include "compilermath.h"
 #include "corecliutils.h"
 #include "solverinterface.h"
+#include "tracer.h"
 
 //==============================================================================
 
 #include <QRegularExpression>
 #include <QStringList>
+#include <QtNumeric>
 
 //==============================================================================
 
 #include "cellmlapibegin.h"
     #include "CCGSBootstrap.hpp"
+    #include "CeVASBootstrap.hpp"
 #include "cellmlapiend.h"
 
 //==============================================================================
@@ -57,6 +60,31 @@ along with this program. If not, see <https://gnu.org/licenses>.
 namespace OpenCOR {
 namespace CellMLSupport {
 
+//==============================================================================
+// Note: the NLA solver to be used by our model code is specific to the thread
+//       in which our model code is run. This means that several simulations
+//       can share the same runtime while using their own NLA solver, and that
+//       we don't need to look up our NLA solver each time an NLA system needs
+//       to be solved...
+
+static thread_local Solver::NlaSolver *currentNlaSolver = nullptr;
+
+//==============================================================================
+
+static void doNonLinearSolve(void (*pFunction)(double *, double *, void *),
+                             double *pParameters, int pSize, void *pUserData)
+{
+    // Solve our NLA system using the NLA solver for the current thread
+    // Note: we should always have an NLA solver, but better be safe than
+    //       sorry...
+
+    if (currentNlaSolver != nullptr) {
+        currentNlaSolver->solve(pFunction, pParameters, pSize, pUserData);
+    } else {
+        qWarning("WARNING | %s:%d: no NLA solver could be found.", __FILE__, __LINE__);
+    }
+}
+
 //==============================================================================
 
 CellmlFileRuntimeParameter::CellmlFileRuntimeParameter(const QString &pName,
@@ -271,6 +299,10 @@ CellmlFileRuntime::~CellmlFileRuntime()
 
 void CellmlFileRuntime::update(CellmlFile *pCellmlFile, bool pAll)
 {
+    // Trace ourselves
+
+    Core::TraceEvent traceEvent("CellmlFileRuntime::update");
+
     // Reset the runtime's properties
 
     reset(true, true, pAll);
@@ -503,7 +535,7 @@ void CellmlFileRuntime::update(CellmlFile *pCellmlFile, bool pAll)
                       "    double *aALGEBRAIC;\n"
                       "};\n"
                       "\n"
-                      "extern void doNonLinearSolve(char *, void (*)(double *, double *, void*), double *, int, void *);\n"
+                      "extern void doNonLinearSolve(void (*)(double *, double *, void*), double *, int, void *);\n"
                       "\n"
                      +functionsString
                      +"\n";
@@ -532,6 +564,8 @@ void CellmlFileRuntime::update(CellmlFile *pCellmlFile, bool pAll)
         }
     }
 
+    QString ratesCode = cleanCode(mCodeInformation->ratesString());
+
     modelCode +=  methodCode("initializeConstants(double *CONSTANTS, double *RATES, double *STATES)",
                              initConsts)
                  +methodCode("computeComputedConstants(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC)",
@@ -539,7 +573,46 @@ void CellmlFileRuntime::update(CellmlFile *pCellmlFile, bool pAll)
                  +methodCode("computeVariables(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC, double *CONDVAR)",
                              mCodeInformation->variablesString())
                  +methodCode("computeRates(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC)",
-                             mCodeInformation->ratesString());
+                             ratesCode);
+
+    // Generate a function that computes our roots, if any, i.e. the functions
+    // that change sign whenever the (time-varying) condition of a piecewise
+    // expression changes value
+    // Note: the conditions may involve algebraic variables, in which case we
+    //       need to compute them first, i.e. compute our rates and then our
+    //       variables since CCGS splits the computation of our algebraic
+    //       variables between the two, without telling us which ones are
+    //       computed where...
+
+    mRoots = retrieveRoots(model);
+
+    if (!mRoots.isEmpty()) {
+        static const QRegularExpression AlgebraicRegEx = QRegularExpression(R"(\bALGEBRAIC\[)");
+
+        bool needAlgebraic = false;
+
+        for (const auto &root : mRoots) {
+            if (AlgebraicRegEx.match(root).hasMatch()) {
+                needAlgebraic = true;
+
+                break;
+            }
+        }
+
+        QString rootsCode;
+
+        if (needAlgebraic) {
+            rootsCode += "computeRates(VOI, CONSTANTS, RATES, STATES, ALGEBRAIC);\n"
+                         "computeVariables(VOI, CONSTANTS, RATES, STATES, ALGEBRAIC, 0);\n";
+        }
+
+        for (int i = 0, iMax = mRoots.count(); i < iMax; ++i) {
+            rootsCode += QString("ROOTS[%1] = %2;\n").arg(i).arg(mRoots[i]);
+        }
+
+        modelCode += methodCode("computeRoots(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC, double *ROOTS)",
+                                rootsCode);
+    }
 
     // Check whether the model code contains a definite integral, otherwise
     // compute it and check that everything went fine
@@ -571,10 +644,15 @@ void CellmlFileRuntime::update(CellmlFile *pCellmlFile, bool pAll)
         mComputeVariables = reinterpret_cast<ComputeVariablesFunction>(mCompilerEngine->getFunction("computeVariables"));
         mComputeRates = reinterpret_cast<ComputeRatesFunction>(mCompilerEngine->getFunction("computeRates"));
 
+        if (!mRoots.isEmpty()) {
+            mComputeRoots = reinterpret_cast<ComputeRootsFunction>(mCompilerEngine->getFunction("computeRoots"));
+        }
+
         // Make sure that we managed to retrieve all the ODE functions
 
         if (   (mInitializeConstants == nullptr) || (mComputeComputedConstants == nullptr)
-            || (mComputeVariables == nullptr) || (mComputeRates == nullptr)) {
+            || (mComputeVariables == nullptr) || (mComputeRates == nullptr)
+            || (!mRoots.isEmpty() && (mComputeRoots == nullptr))) {
             mIssues << CellmlFileIssue(CellmlFileIssue::Type::Error,
                                        tr("an unexpected problem occurred while trying to retrieve the model functions"));
 
@@ -603,6 +681,24 @@ bool CellmlFileRuntime::needNlaSolver() const
 
 //==============================================================================
 
+Solver::NlaSolver * CellmlFileRuntime::nlaSolver()
+{
+    // Return the NLA solver to be used by our model code in the current thread
+
+    return currentNlaSolver;
+}
+
+//==============================================================================
+
+void CellmlFileRuntime::setNlaSolver(Solver::NlaSolver *pNlaSolver)
+{
+    // Set the NLA solver to be used by our model code in the current thread
+
+    currentNlaSolver = pNlaSolver;
+}
+
+//==============================================================================
+
 void CellmlFileRuntime::importData(const QString &pName,
                                    const QStringList &pComponentHierarchy,
                                    int pIndex, double *pData)
@@ -651,6 +747,24 @@ int CellmlFileRuntime::algebraicCount() const
 
 //==============================================================================
 
+int CellmlFileRuntime::rootsCount() const
+{
+    // Return the number of roots in the model
+
+    return mRoots.count();
+}
+
+//==============================================================================
+
+QStringList CellmlFileRuntime::roots() const
+{
+    // Return the C code of the roots in the model
+
+    return mRoots;
+}
+
+//==============================================================================
+
 CellmlFileRuntime::InitializeConstantsFunction CellmlFileRuntime::initializeConstants() const
 {
     // Return the initializeConstants function
@@ -687,6 +801,15 @@ CellmlFileRuntime::ComputeRatesFunction CellmlFileRuntime::computeRates() const
 
 //==============================================================================
 
+CellmlFileRuntime::ComputeRootsFunction CellmlFileRuntime::computeRoots() const
+{
+    // Return the computeRoots function
+
+    return mComputeRoots;
+}
+
+//==============================================================================
+
 CellmlFileIssues CellmlFileRuntime::issues() const
 {
     // Return the issue(s)
@@ -742,6 +865,7 @@ void CellmlFileRuntime::resetFunctions()
     mComputeComputedConstants = nullptr;
     mComputeVariables = nullptr;
     mComputeRates = nullptr;
+    mComputeRoots = nullptr;
 }
 
 //==============================================================================
@@ -753,6 +877,8 @@ void CellmlFileRuntime::reset(bool pRecreateCompilerEngine, bool pResetIssues,
 
     mAtLeastOneNlaSystem = false;
 
+    mRoots.clear();
+
     resetCodeInformation();
 
     delete mCompilerEngine;
@@ -953,11 +1079,306 @@ QString CellmlFileRuntime::cleanCode(const std::wstring &pCode)
 
     // Also rename do_nonlinearsolve() to doNonLinearSolve() since CellML's CIS
     // service already defines do_nonlinearsolve() and, yet, we want to use our
-    // own non-linear solve routine defined in our Solver interface, and add a
-    // new parameter to all our calls to doNonLinearSolve() so that
-    // doNonLinearSolve() can retrieve the correct instance of our NLA solver
+    // own non-linear solve routine, which uses the NLA solver set for the
+    // current thread (see setNlaSolver())
+
+    res.replace("do_nonlinearsolve(", "doNonLinearSolve(");
+
+    return res;
+}
+
+//==============================================================================
+
+QString CellmlFileRuntime::mathmlCode(iface::dom::Element *pElement,
+                                      iface::cellml_api::CellMLComponent *pComponent,
+                                      const QMap<iface::cellml_api::CellMLVariable *, QString> &pVariablesCode)
+{
+    // Generate and return the C code for the given MathML element, but only if
+    // it is a variable, a real number or the application of an arithmetic
+    // operator or function to such elements, i.e. what we need to compute our
+    // roots
+    // Note #1: we return an empty string for anything else, i.e. we don't
+    //          compute a root for a condition that uses it...
+    // Note #2: a variable which units are not those of its source variable
+    //          would need a conversion factor, so we don't support it either...
+
+    if (QString::fromStdWString(pElement->namespaceURI()) != MathmlNamespace) {
+        return {};
+    }
+
+    QString elementName = QString::fromStdWString(pElement->localName());
+    ObjRef<iface::dom::NodeList> childNodes = pElement->childNodes();
+
+    if ((elementName == "ci") || (elementName == "cn")) {
+        QString text;
+
+        for (uint i = 0, iMax = childNodes->length(); i < iMax; ++i) {
+            ObjRef<iface::dom::Node> childNode = childNodes->item(i);
+
+            if (childNode->nodeType() == iface::dom::Node::TEXT_NODE) {
+                text += QString::fromStdWString(childNode->nodeValue());
+            }
+        }
+
+        text = text.trimmed();
+
+        if (elementName == "ci") {
+            ObjRef<iface::cellml_api::CellMLVariable> variable = pComponent->variables()->getVariable(text.toStdWString());
+
+            if (variable == nullptr) {
+                return {};
+            }
+
+            ObjRef<iface::cellml_api::CellMLVariable> sourceVariable = variable->sourceVariable();
+
+            if (   (sourceVariable == nullptr)
+                || (variable->unitsName() != sourceVariable->unitsName())) {
+                return {};
+            }
+
+            return pVariablesCode.value(sourceVariable);
+        }
+
+        std::wstring type = pElement->getAttribute(L"type");
+        bool ok;
+        double value = text.toDouble(&ok);
+
+        if ((!type.empty() && (type != L"real")) || !ok || !qIsFinite(value)) {
+            return {};
+        }
+
+        return (text.contains('.') || text.contains('e', Qt::CaseInsensitive))?
+                    text:
+                    text+".0";
+    }
+
+    if (elementName != "apply") {
+        return {};
+    }
+
+    QString operatorName;
+    QStringList operands;
+
+    for (uint i = 0, iMax = childNodes->length(); i < iMax; ++i) {
+        ObjRef<iface::dom::Node> childNode = childNodes->item(i);
+
+        if (childNode->nodeType() != iface::dom::Node::ELEMENT_NODE) {
+            continue;
+        }
+
+        ObjRef<iface::dom::Element> childElement = QueryInterface(childNode);
+
+        if (operatorName.isEmpty()) {
+            operatorName = QString::fromStdWString(childElement->localName());
+        } else {
+            QString operand = mathmlCode(childElement, pComponent, pVariablesCode);
+
+            if (operand.isEmpty()) {
+                return {};
+            }
+
+            operands << operand;
+        }
+    }
+
+    int operandsCount = operands.count();
+
+    if ((operatorName == "plus") && (operandsCount >= 1)) {
+        return "("+operands.join(")+(")+")";
+    }
+
+    if ((operatorName == "minus") && (operandsCount == 1)) {
+        return QString("-(%1)").arg(operands[0]);
+    }
+
+    if ((operatorName == "minus") && (operandsCount == 2)) {
+        return QString("(%1)-(%2)").arg(operands[0], operands[1]);
+    }
+
+    if ((operatorName == "times") && (operandsCount >= 2)) {
+        return "("+operands.join(")*(")+")";
+    }
+
+    if ((operatorName == "divide") && (operandsCount == 2)) {
+        return QString("(%1)/(%2)").arg(operands[0], operands[1]);
+    }
+
+    if ((operatorName == "power") && (operandsCount == 2)) {
+        return QString("pow(%1, %2)").arg(operands[0], operands[1]);
+    }
+
+    if ((operatorName == "exp") && (operandsCount == 1)) {
+        return QString("exp(%1)").arg(operands[0]);
+    }
+
+    if ((operatorName == "ln") && (operandsCount == 1)) {
+        return QString("log(%1)").arg(operands[0]);
+    }
+
+    if ((operatorName == "abs") && (operandsCount == 1)) {
+        return QString("fabs(%1)").arg(operands[0]);
+    }
+
+    return {};
+}
+
+//==============================================================================
+
+void CellmlFileRuntime::retrieveConditionRoots(iface::dom::Element *pElement,
+                                               iface::cellml_api::CellMLComponent *pComponent,
+                                               const QMap<iface::cellml_api::CellMLVariable *, QString> &pVariablesCode,
+                                               QStringList &pRoots)
+{
+    // Retrieve the roots of the given condition, i.e. convert its relational
+    // conditions ("lhs<rhs", "lhs<=rhs", "lhs>rhs" and "lhs>=rhs") into roots
+    // ("(lhs)-(rhs)"), looking into its logical operators, if any
+    // Note: a relational condition must be time-varying, i.e. involve our VOI,
+    //       a state or an algebraic variable, otherwise it can never change
+    //       value...
+
+    static const QRegularExpression TimeVaryingRegEx = QRegularExpression(R"(\b(VOI\b|STATES\[|ALGEBRAIC\[))");
+    static const QStringList LogicalOperators = { "and", "or", "xor", "not" };
+    static const QStringList RelationalOperators = { "lt", "leq", "gt", "geq" };
+
+    if (   (QString::fromStdWString(pElement->namespaceURI()) != MathmlNamespace)
+        || (QString::fromStdWString(pElement->localName()) != "apply")) {
+        return;
+    }
+
+    QString operatorName;
+    QStringList operands;
+    ObjRef<iface::dom::NodeList> childNodes = pElement->childNodes();
+
+    for (uint i = 0, iMax = childNodes->length(); i < iMax; ++i) {
+        ObjRef<iface::dom::Node> childNode = childNodes->item(i);
+
+        if (childNode->nodeType() != iface::dom::Node::ELEMENT_NODE) {
+            continue;
+        }
+
+        ObjRef<iface::dom::Element> childElement = QueryInterface(childNode);
+
+        if (operatorName.isEmpty()) {
+            operatorName = QString::fromStdWString(childElement->localName());
+        } else if (LogicalOperators.contains(operatorName)) {
+            retrieveConditionRoots(childElement, pComponent, pVariablesCode, pRoots);
+        } else if (RelationalOperators.contains(operatorName)) {
+            operands << mathmlCode(childElement, pComponent, pVariablesCode);
+        }
+    }
+
+    if (   (operands.count() == 2)
+        && !operands[0].isEmpty() && !operands[1].isEmpty()
+        && (   TimeVaryingRegEx.match(operands[0]).hasMatch()
+            || TimeVaryingRegEx.match(operands[1]).hasMatch())) {
+        QString root = QString("(%1)-(%2)").arg(operands[0], operands[1]);
+
+        if (!pRoots.contains(root)) {
+            pRoots << root;
+        }
+    }
+}
+
+//==============================================================================
+
+void CellmlFileRuntime::retrievePiecewiseRoots(iface::dom::Element *pElement,
+                                               iface::cellml_api::CellMLComponent *pComponent,
+                                               const QMap<iface::cellml_api::CellMLVariable *, QString> &pVariablesCode,
+                                               QStringList &pRoots)
+{
+    // Retrieve the roots of the conditions of the pieces found in the given
+    // MathML element, i.e. of the second child element of each piece
+
+    bool piece =    (QString::fromStdWString(pElement->namespaceURI()) == MathmlNamespace)
+                 && (QString::fromStdWString(pElement->localName()) == "piece");
+    int childElementNumber = 0;
+    ObjRef<iface::dom::NodeList> childNodes = pElement->childNodes();
+
+    for (uint i = 0, iMax = childNodes->length(); i < iMax; ++i) {
+        ObjRef<iface::dom::Node> childNode = childNodes->item(i);
+
+        if (childNode->nodeType() != iface::dom::Node::ELEMENT_NODE) {
+            continue;
+        }
+
+        ObjRef<iface::dom::Element> childElement = QueryInterface(childNode);
+
+        if (piece && (++childElementNumber == 2)) {
+            retrieveConditionRoots(childElement, pComponent, pVariablesCode, pRoots);
+        }
+
+        retrievePiecewiseRoots(childElement, pComponent, pVariablesCode, pRoots);
+    }
+}
+
+//==============================================================================
+
+QStringList CellmlFileRuntime::retrieveRoots(iface::cellml_api::Model *pModel)
+{
+    // Map the (source) variables of our model to their C code
+    // Note: our map is keyed on the variables' pointers, so we must keep our
+    //       variables alive for as long as we use our map, hence we also keep
+    //       track of them...
+
+    QList<ObjRef<iface::cellml_api::CellMLVariable>> variables;
+    QMap<iface::cellml_api::CellMLVariable *, QString> variablesCode;
+    ObjRef<iface::cellml_services::ComputationTargetIterator> computationTargetIter = mCodeInformation->iterateTargets();
+
+    for (ObjRef<iface::cellml_services::ComputationTarget> computationTarget = computationTargetIter->nextComputationTarget();
+         computationTarget != nullptr; computationTarget = computationTargetIter->nextComputationTarget()) {
+        if (computationTarget->degree() != 0) {
+            continue;
+        }
+
+        ObjRef<iface::cellml_api::CellMLVariable> variable = computationTarget->variable();
+
+        variables << variable;
+
+        switch (computationTarget->type()) {
+        case iface::cellml_services::VARIABLE_OF_INTEGRATION:
+            variablesCode.insert(variable, "VOI");
+
+            break;
+        case iface::cellml_services::CONSTANT:
+            variablesCode.insert(variable, QString("CONSTANTS[%1]").arg(computationTarget->assignedIndex()));
+
+            break;
+        case iface::cellml_services::STATE_VARIABLE:
+            variablesCode.insert(variable, QString("STATES[%1]").arg(computationTarget->assignedIndex()));
+
+            break;
+        case iface::cellml_services::ALGEBRAIC:
+            variablesCode.insert(variable, QString("ALGEBRAIC[%1]").arg(computationTarget->assignedIndex()));
 
-    res.replace("do_nonlinearsolve(", QString(R"(doNonLinearSolve("%1", )").arg(Solver::objectAddress(this)));
+            break;
+        case iface::cellml_services::PSEUDOSTATE_VARIABLE:
+        case iface::cellml_services::FLOATING:
+        case iface::cellml_services::LOCALLY_BOUND:
+            break;
+        }
+    }
+
+    // Retrieve the roots of the piecewise expressions used in the (relevant)
+    // components of our model, including imported ones
+
+    QStringList res;
+    ObjRef<iface::cellml_services::CeVAS> cevas = CreateCeVASBootstrap()->createCeVASForModel(pModel);
+
+    if (!cevas->modelError().empty()) {
+        return res;
+    }
+
+    ObjRef<iface::cellml_api::CellMLComponentIterator> componentsIter = cevas->iterateRelevantComponents();
+
+    for (ObjRef<iface::cellml_api::CellMLComponent> component = componentsIter->nextComponent();
+         component != nullptr; component = componentsIter->nextComponent()) {
+        ObjRef<iface::cellml_api::MathMLElementIterator> mathIter = component->math()->iterate();
+
+        for (ObjRef<iface::mathml_dom::MathMLElement> mathNode = mathIter->next();
+             mathNode != nullptr; mathNode = mathIter->next()) {
+            retrievePiecewiseRoots(mathNode, component, variablesCode, res);
+        }
+    }
 
     return res;
 }
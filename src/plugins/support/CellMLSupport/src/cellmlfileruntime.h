@@ -59,6 +59,12 @@ namespace Compiler {
 
 //==============================================================================
 
+namespace Solver {
+    class NlaSolver;
+} // namespace Solver
+
+//==============================================================================
+
 namespace CellMLSupport {
 
 //==============================================================================
@@ -134,6 +140,7 @@ public:
     using ComputeComputedConstantsFunction = void (*)(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC);
     using ComputeVariablesFunction = void (*)(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC);
     using ComputeRatesFunction = void (*)(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC);
+    using ComputeRootsFunction = void (*)(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC, double *ROOTS);
 
     explicit CellmlFileRuntime(CellmlFile *pCellmlFile);
     ~CellmlFileRuntime() override;
@@ -144,6 +151,9 @@ public:
 
     bool needNlaSolver() const;
 
+    static Solver::NlaSolver * nlaSolver();
+    static void setNlaSolver(Solver::NlaSolver *pNlaSolver);
+
     void importData(const QString &pName,
                     const QStringList &pComponentHierarchy, int pIndex,
                     double *pData);
@@ -152,11 +162,14 @@ public:
     int statesCount() const;
     int ratesCount() const;
     int algebraicCount() const;
+    int rootsCount() const;
+    QStringList roots() const;
 
     InitializeConstantsFunction initializeConstants() const;
     ComputeComputedConstantsFunction computeComputedConstants() const;
     ComputeVariablesFunction computeVariables() const;
     ComputeRatesFunction computeRates() const;
+    ComputeRootsFunction computeRoots() const;
 
     CellmlFileIssues issues() const;
 
@@ -174,6 +187,8 @@ private:
     int mStatesRatesCount = 0;
     int mAlgebraicCount = 0;
 
+    QStringList mRoots;
+
     Compiler::CompilerEngine *mCompilerEngine = nullptr;
 
     CellmlFileIssues mIssues;
@@ -185,6 +200,7 @@ private:
     ComputeComputedConstantsFunction mComputeComputedConstants = nullptr;
     ComputeVariablesFunction mComputeVariables = nullptr;
     ComputeRatesFunction mComputeRates = nullptr;
+    ComputeRootsFunction mComputeRoots = nullptr;
 
     void resetCodeInformation();
 
@@ -200,6 +216,18 @@ private:
     void retrieveCodeInformation(iface::cellml_api::Model *pModel);
 
     QString cleanCode(const std::wstring &pCode);
+    QString mathmlCode(iface::dom::Element *pElement,
+                       iface::cellml_api::CellMLComponent *pComponent,
+                       const QMap<iface::cellml_api::CellMLVariable *, QString> &pVariablesCode);
+    void retrieveConditionRoots(iface::dom::Element *pElement,
+                                iface::cellml_api::CellMLComponent *pComponent,
+                                const QMap<iface::cellml_api::CellMLVariable *, QString> &pVariablesCode,
+                                QStringList &pRoots);
+    void retrievePiecewiseRoots(iface::dom::Element *pElement,
+                                iface::cellml_api::CellMLComponent *pComponent,
+                                const QMap<iface::cellml_api::CellMLVariable *, QString> &pVariablesCode,
+                                QStringList &pRoots);
+    QStringList retrieveRoots(iface::cellml_api::Model *pModel);
     QString methodCode(const QString &pCodeSignature, const QString &pCodeBody);
     QString methodCode(const QString &pCodeSignature,
                        const std::wstring &pCodeBody);
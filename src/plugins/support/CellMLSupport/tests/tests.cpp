@@ -26,6 +26,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 //==============================================================================
 
 #include "cellmlfile.h"
+#include "cellmlfileimportcontentscache.h"
 #include "corecliutils.h"
 #include "tests.h"
 
@@ -134,6 +135,151 @@ void Tests::runtimeTests()
 
 //==============================================================================
 
+void Tests::rootsTests()
+{
+    // Make sure that a model without any piecewise expression (Noble 1962) has
+    // no roots
+
+    OpenCOR::CellMLSupport::CellmlFile nobleCellmlFile(OpenCOR::fileName("models/noble_model_1962.cellml"));
+    OpenCOR::CellMLSupport::CellmlFileRuntime *nobleRuntime = nobleCellmlFile.runtime();
+
+    QVERIFY(nobleRuntime->isValid());
+    QCOMPARE(nobleRuntime->rootsCount(), 0);
+    QVERIFY(nobleRuntime->computeRoots() == nullptr);
+
+    // Make sure that a model with a stimulus current that is applied between
+    // two given times (Hodgkin-Huxley 1952) has one root for each of them
+
+    OpenCOR::CellMLSupport::CellmlFile hhCellmlFile(OpenCOR::fileName("models/hodgkin_huxley_squid_axon_model_1952.cellml"));
+    OpenCOR::CellMLSupport::CellmlFileRuntime *hhRuntime = hhCellmlFile.runtime();
+
+    QVERIFY(hhRuntime->isValid());
+    QCOMPARE(hhRuntime->rootsCount(), 2);
+    QCOMPARE(hhRuntime->roots(), QStringList() << "(VOI)-(10.0)" << "(VOI)-(10.5)");
+    QVERIFY(hhRuntime->computeRoots() != nullptr);
+
+    // Make sure that a model which piecewise expression only has conditions
+    // that involve a constant (our parabola ODE model) has no roots
+
+    OpenCOR::CellMLSupport::CellmlFile parabolaCellmlFile(OpenCOR::fileName("models/tests/cellml/parabola_ode_model.cellml"));
+    OpenCOR::CellMLSupport::CellmlFileRuntime *parabolaRuntime = parabolaCellmlFile.runtime();
+
+    QVERIFY(parabolaRuntime->isValid());
+    QCOMPARE(parabolaRuntime->rootsCount(), 0);
+    QVERIFY(parabolaRuntime->computeRoots() == nullptr);
+}
+
+//==============================================================================
+
+void Tests::importContentsCacheTests()
+{
+    // Create a local import tree where our main model imports two models, each
+    // of which imports a units model, the two units models being identical
+
+    static const QString UnitsModel = R"(<?xml version='1.0' encoding='UTF-8'?>)""\n"
+                                      R"(<model name="units" xmlns="http://www.cellml.org/cellml/1.1#">)""\n"
+                                      R"(    <units name="millisecond">)""\n"
+                                      R"(        <unit prefix="milli" units="second"/>)""\n"
+                                      R"(    </units>)""\n"
+                                      R"(</model>)""\n";
+    static const QString ImportModel = R"(<?xml version='1.0' encoding='UTF-8'?>)""\n"
+                                       R"(<model name="%1" xmlns="http://www.cellml.org/cellml/1.1#" xmlns:xlink="http://www.w3.org/1999/xlink">)""\n"
+                                       R"(    <import xlink:href="%2">)""\n"
+                                       R"(        <units name="millisecond" units_ref="millisecond"/>)""\n"
+                                       R"(    </import>)""\n"
+                                       R"(    <units name="per_millisecond">)""\n"
+                                       R"(        <unit exponent="-1" units="millisecond"/>)""\n"
+                                       R"(    </units>)""\n"
+                                       R"(</model>)""\n";
+    static const QString MainModel = R"(<?xml version='1.0' encoding='UTF-8'?>)""\n"
+                                     R"(<model name="main" xmlns="http://www.cellml.org/cellml/1.1#" xmlns:xlink="http://www.w3.org/1999/xlink">)""\n"
+                                     R"(    <import xlink:href="a.cellml">)""\n"
+                                     R"(        <units name="per_millisecond_a" units_ref="per_millisecond"/>)""\n"
+                                     R"(    </import>)""\n"
+                                     R"(    <import xlink:href="b.cellml">)""\n"
+                                     R"(        <units name="per_millisecond_b" units_ref="per_millisecond"/>)""\n"
+                                     R"(    </import>)""\n"
+                                     R"(</model>)""\n";
+
+    QTemporaryDir temporaryDir;
+    QString mainFileName = temporaryDir.path()+"/main.cellml";
+    QString unitsFileName = temporaryDir.path()+"/units.cellml";
+
+    QVERIFY(OpenCOR::Core::writeFile(mainFileName, MainModel));
+    QVERIFY(OpenCOR::Core::writeFile(temporaryDir.path()+"/a.cellml", ImportModel.arg("a", "units.cellml")));
+    QVERIFY(OpenCOR::Core::writeFile(temporaryDir.path()+"/b.cellml", ImportModel.arg("b", "units_copy.cellml")));
+    QVERIFY(OpenCOR::Core::writeFile(unitsFileName, UnitsModel));
+    QVERIFY(OpenCOR::Core::writeFile(temporaryDir.path()+"/units_copy.cellml", UnitsModel));
+
+    // Make sure that all our imports get prefetched and cached, and that the
+    // contents of our two units models is only cached once
+
+    OpenCOR::CellMLSupport::CellmlFileImportContentsCache *importContentsCache = OpenCOR::CellMLSupport::CellmlFileImportContentsCache::instance();
+
+    importContentsCache->clear();
+
+    OpenCOR::CellMLSupport::CellmlFile mainCellmlFile(mainFileName);
+
+    QVERIFY(mainCellmlFile.isValid());
+    QCOMPARE(mainCellmlFile.importedFileNames().count(), 4);
+    QCOMPARE(importContentsCache->fileNamesOrUrlsCount(), 4);
+    QCOMPARE(importContentsCache->contentsCount(), 3);
+
+    // Modify our first units model and make sure that it gets reloaded since
+    // its modification time has changed, while the contents of our second
+    // units model remains cached
+
+    QString newUnitsModel = QString(UnitsModel).replace("</model>", "    <!-- Modified units model -->\n</model>");
+    QFile unitsFile(unitsFileName);
+
+    QVERIFY(OpenCOR::Core::writeFile(unitsFileName, newUnitsModel));
+    QVERIFY(unitsFile.open(QIODevice::ReadWrite));
+    QVERIFY(unitsFile.setFileTime(QFileInfo(unitsFileName).lastModified().addSecs(3600),
+                                  QFileDevice::FileModificationTime));
+
+    unitsFile.close();
+
+    OpenCOR::CellMLSupport::CellmlFile otherMainCellmlFile(mainFileName);
+
+    QVERIFY(otherMainCellmlFile.isValid());
+
+    bool foundUnitsModel = false;
+
+    for (const auto &importedFileName : otherMainCellmlFile.importedFileNames()) {
+        if (QFileInfo(importedFileName).fileName() == "units.cellml") {
+            QCOMPARE(otherMainCellmlFile.importedFileContents(importedFileName), newUnitsModel);
+
+            foundUnitsModel = true;
+        }
+    }
+
+    QVERIFY(foundUnitsModel);
+    QCOMPARE(importContentsCache->fileNamesOrUrlsCount(), 4);
+    QCOMPARE(importContentsCache->contentsCount(), 4);
+
+    // Make sure that our cache is bounded and that we can still fully
+    // instantiate our imports when nothing can be cached
+
+    int maximumSize = importContentsCache->maximumSize();
+
+    importContentsCache->setMaximumSize(0);
+
+    QCOMPARE(importContentsCache->fileNamesOrUrlsCount(), 0);
+    QCOMPARE(importContentsCache->contentsCount(), 0);
+
+    OpenCOR::CellMLSupport::CellmlFile uncachedMainCellmlFile(mainFileName);
+
+    QVERIFY(uncachedMainCellmlFile.isValid());
+
+    QCOMPARE(uncachedMainCellmlFile.importedFileNames().count(), 4);
+    QCOMPARE(importContentsCache->contentsCount(), 0);
+
+    importContentsCache->setMaximumSize(maximumSize);
+    importContentsCache->clear();
+}
+
+//==============================================================================
+
 QTEST_GUILESS_MAIN(Tests)
 
 //==============================================================================
@@ -39,6 +39,8 @@ private:
 
 private slots:
     void runtimeTests();
+    void rootsTests();
+    void importContentsCacheTests();
 };
 
 //==============================================================================
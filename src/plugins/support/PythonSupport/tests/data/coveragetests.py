@@ -175,4 +175,66 @@ if __name__ == '__main__':
     test_data_store_variables(data_store.variables(), 'DataStore.variables()', '   ')
     test_data_store_variables(data_store.voi_and_variables(), 'DataStore.voi_and_variables()', '   ')
 
+    # Coverage tests for Simulation.run_async()
+    # Note: a simulation must not be running anymore once its future is done,
+    #       so we should be able to run it again straightaway...
+
+    utils.header('Simulation.run_async() coverage tests', False)
+
+    simulation.reset()
+
+    runs_count = simulation.runsCount()
+    runs_ok = True
+
+    for i in range(10):
+        try:
+            future = simulation.run_async()
+
+            if not future.result() or not future.done() or (future.elapsed_time() < 0):
+                runs_ok = False
+        except Exception:
+            runs_ok = False
+
+        del future
+
+    print(' - Test successive runs: %s' % ("yes" if runs_ok else "no"))
+    print(' - Test number of runs: %s' % ("yes" if simulation.runsCount() == runs_count + 10 else "no"))
+
+    # Coverage tests for Simulation.statistics() and
+    # Simulation.set_instrumented()
+    # Note: timings are only reported for an instrumented simulation, while
+    #       counters are always reported...
+
+    utils.header('Simulation statistics coverage tests', False)
+
+    print(' - Test not instrumented by default: %s' % ("yes" if not simulation.instrumented() else "no"))
+
+    simulation.reset()
+    simulation.run()
+
+    statistics = simulation.statistics()
+    points = len(simulation.results().voi().values())
+
+    print(' - Test counters: %s'
+          % ("yes" if (statistics.get('steps', 0) > 0) and (statistics.get('rhsEvaluations', 0) > 0) else "no"))
+    print(' - Test number of points: %s' % ("yes" if statistics.get('points') == points else "no"))
+    print(' - Test no timings: %s'
+          % ("yes" if ('solverTime' not in statistics) and ('addPointTime' not in statistics) else "no"))
+
+    simulation.set_instrumented(True)
+
+    print(' - Test instrumented: %s' % ("yes" if simulation.instrumented() else "no"))
+
+    simulation.reset()
+    simulation.run()
+
+    statistics = simulation.statistics()
+
+    print(' - Test timings: %s'
+          % ("yes" if (statistics.get('solverTime', -1) >= 0) and (statistics.get('addPointTime', -1) >= 0) else "no"))
+
+    simulation.set_instrumented(False)
+
+    print(' - Test not instrumented: %s' % ("yes" if not simulation.instrumented() else "no"))
+
     oc.close_simulation(simulation)
@@ -0,0 +1,111 @@
+import math
+import opencor as oc
+import sys
+
+sys.dont_write_bytecode = True
+
+import utils
+
+
+def run_dae_simulation(model, ode_solver):
+    # Run the given DAE model using the given ODE solver and a fine point
+    # interval, i.e. with many points at which our ODE solver could be (but
+    # shouldn't need to be) reinitialised
+
+    simulation = utils.open_simulation(model)
+    data = simulation.data()
+
+    data.set_ending_point(10.0)
+    data.set_point_interval(0.001)
+    data.set_ode_solver(ode_solver)
+
+    simulation.run()
+
+    return simulation
+
+
+def test_parabola_dae_model(ode_solver):
+    # y' = 2*time with y(0) = offset, and x = time^2+offset, so we should have
+    # y = time^2+y(0) and x = y
+
+    simulation = run_dae_simulation('tests/cellml/parabola_dae_model.cellml', ode_solver)
+    results = simulation.results()
+    voi = results.voi().values()
+    y = results.states()['main/y'].values()
+    x = results.algebraic()['main/x'].values()
+
+    print('    - parabola_dae_model.cellml:')
+    print('       - main/y = time^2+y(0): %s' % utils.yes_no(utils.close_values(y, [t * t + y[0] for t in voi], 1e-5)))
+    print('       - main/x = main/y: %s' % utils.yes_no(utils.close_values(x, y, 1e-5)))
+
+    oc.close_simulation(simulation)
+
+
+def test_simple_dae_model(ode_solver):
+    # a' = cos(b) with a(0) = 1, and cos(b) = sin(a), so we should have
+    # a = 2*atan(tan(1/2)*exp(t))
+
+    simulation = run_dae_simulation('tests/cellml/simple_dae_model.cellml', ode_solver)
+    results = simulation.results()
+    voi = results.voi().values()
+    a = results.states()['main/a'].values()
+
+    print('    - simple_dae_model.cellml:')
+    print('       - main/a = 2*atan(tan(1/2)*exp(t)): %s'
+          % utils.yes_no(utils.close_values(a, [2.0 * math.atan(math.tan(0.5) * math.exp(t)) for t in voi], 1e-5)))
+
+    oc.close_simulation(simulation)
+
+
+def test_nla_initial_guess(ode_solver, initial_guess):
+    # cos(b) = sin(a) has two solutions of opposite sign for b at time 0, so
+    # the one that KINSOL finds tells us whether it used the initial guess that
+    # we gave it for b
+
+    simulation = utils.open_simulation('tests/cellml/simple_dae_model.cellml')
+    data = simulation.data()
+
+    data.set_ending_point(10.0)
+    data.set_point_interval(0.001)
+    data.set_ode_solver(ode_solver)
+    data.algebraic()['main/b'].set_value(initial_guess)
+
+    simulation.run()
+
+    results = simulation.results()
+    a = results.states()['main/a'].values()
+    b = results.algebraic()['main/b'].values()
+    statistics = simulation.statistics()
+
+    print('    - Initial guess of %s:' % utils.str_value(initial_guess))
+    print('       - Initial solution: %s'
+          % utils.yes_no(math.isclose(b[0], math.copysign(math.acos(math.sin(a[0])), initial_guess), abs_tol=1e-5)))
+    print('       - cos(main/b) = sin(main/a): %s'
+          % utils.yes_no(utils.close_values([math.cos(value) for value in b], [math.sin(value) for value in a], 1e-5)))
+    print('       - NLA solves: %s' % utils.yes_no(statistics.get('nlaSolves', 0) > 0))
+
+    oc.close_simulation(simulation)
+
+
+if __name__ == '__main__':
+    # Check the results of our DAE models against their analytical solution
+
+    utils.header('DAE tests')
+
+    for ode_solver in ['CVODE', 'IDA']:
+        print(' - %s:' % ode_solver)
+
+        test_parabola_dae_model(ode_solver)
+        test_simple_dae_model(ode_solver)
+
+    # Check that KINSOL starts from the initial guess that it is given and that
+    # it finds an actual solution, be it used by CVODE for each evaluation of
+    # the rates or by IDA to get consistent initial conditions
+
+    utils.header('NLA tests', False)
+
+    for ode_solver in ['CVODE', 'IDA']:
+        print(' - %s:' % ode_solver)
+
+        test_nla_initial_guess(ode_solver, 1.0)
+        test_nla_initial_guess(ode_solver, -1.0)
@@ -0,0 +1,39 @@
+import opencor as oc
+import sys
+
+sys.dont_write_bytecode = True
+
+import utils
+
+
+def test_events(ode_solver, expected_events):
+    # Run the Hodgkin-Huxley 1952 model, which stimulus current is applied
+    # from time 10 to time 10.5, using the given ODE solver and check its events
+
+    simulation = utils.open_simulation('hodgkin_huxley_squid_axon_model_1952.cellml')
+    data = simulation.data()
+
+    data.set_ending_point(50.0)
+    data.set_point_interval(0.1)
+    data.set_ode_solver(ode_solver)
+
+    if ode_solver != 'CVODE':
+        data.set_ode_solver_property('Step', 0.01)
+
+    simulation.run()
+
+    print(' - %s:' % ode_solver)
+    print('    - Events: %s' % utils.yes_no(utils.close_values(simulation.results().events(), expected_events)))
+
+    oc.close_simulation(simulation)
+
+
+if __name__ == '__main__':
+    # Check that CVODE locates the events of a model, i.e. the points at which
+    # the condition of a piecewise expression changes value, while other
+    # solvers ignore them
+
+    utils.header('Event tests')
+
+    test_events('CVODE', [10.0, 10.5])
+    test_events('Euler (forward)', [])
@@ -0,0 +1,61 @@
+import math
+import opencor as oc
+import sys
+
+sys.dont_write_bytecode = True
+
+import utils
+
+
+def run_simulation(simulation, ode_solver, interpolate_solution):
+    data = simulation.data()
+
+    data.set_ode_solver(ode_solver)
+
+    if ode_solver != 'Dormand-Prince':
+        data.set_ode_solver_property('Step', 0.01)
+
+    data.set_ode_solver_property('InterpolateSolution', interpolate_solution)
+
+    simulation.reset()
+    simulation.clear_results()
+    simulation.run()
+
+    return simulation.statistics()['steps']
+
+
+if __name__ == '__main__':
+    # Run the parabola ODE model (i.e. y' = 2*time with y(0) = 3) using a
+    # point interval that is not a multiple of our fixed step, both with and
+    # without interpolating our solution
+    # Note: y = time^2+3 is a quadratic, so all our solvers but forward Euler
+    #       compute it exactly, and so does the interpolation of their
+    #       solution...
+
+    utils.header('Interpolation tests')
+
+    simulation = utils.open_simulation('tests/cellml/parabola_ode_model.cellml')
+    data = simulation.data()
+
+    data.set_ending_point(10.0)
+    data.set_point_interval(0.025)
+
+    for ode_solver in ['Dormand-Prince', 'Euler (forward)', 'Heun', 'Runge-Kutta (2nd order)', 'Runge-Kutta (4th order)']:
+        steps = run_simulation(simulation, ode_solver, False)
+        interpolated_steps = run_simulation(simulation, ode_solver, True)
+
+        results = simulation.results()
+        voi = results.voi().values()
+        y = results.states()['main/y'].values()
+
+        print(' - %s:' % ode_solver)
+        print('    - Number of points: %s' % utils.yes_no(len(voi) == 401))
+        print('    - Ending point: %s' % utils.yes_no(voi[-1] == 10.0))
+        print('    - Fewer steps: %s' % utils.yes_no(interpolated_steps < steps))
+
+        if ode_solver != 'Euler (forward)':
+            print('    - Exact solution: %s'
+                  % utils.yes_no(all(math.isclose(y[i], voi[i] * voi[i] + 3.0, rel_tol=1e-9, abs_tol=1e-9)
+                                     for i in range(len(voi)))))
+
+    oc.close_simulation(simulation)
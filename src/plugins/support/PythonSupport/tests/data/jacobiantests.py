@@ -0,0 +1,61 @@
+import opencor as oc
+import sys
+
+sys.dont_write_bytecode = True
+
+import utils
+
+
+def run_simulation(model, linear_solver, threads_count):
+    # Run the given model using CVODE with tight tolerances, the given linear
+    # solver and the given number of threads to compute its Jacobian, and
+    # return the values of its states
+
+    simulation = utils.open_simulation(model)
+    data = simulation.data()
+
+    data.set_ending_point(1000.0)
+    data.set_point_interval(1.0)
+    data.set_ode_solver('CVODE')
+    data.set_ode_solver_property('LinearSolver', linear_solver)
+    data.set_ode_solver_property('RelativeTolerance', 1.0e-10)
+    data.set_ode_solver_property('AbsoluteTolerance', 1.0e-10)
+    data.set_ode_solver_property('ThreadsCount', threads_count)
+
+    if linear_solver == 'Banded':
+        data.set_ode_solver_property('UpperHalfBandwidth', 1)
+        data.set_ode_solver_property('LowerHalfBandwidth', 1)
+
+    simulation.run()
+
+    res = {uri: list(state.values()) for uri, state in simulation.results().states().items()}
+
+    oc.close_simulation(simulation)
+
+    return res
+
+
+def test_jacobian(model, linear_solver):
+    # Check that computing the Jacobian of the given model using several
+    # threads gives the same results as computing it in CVODES' own thread
+
+    reference_states = run_simulation(model, linear_solver, 1)
+    states = run_simulation(model, linear_solver, 4)
+
+    print('    - %s: %s'
+          % (linear_solver,
+             utils.yes_no((states.keys() == reference_states.keys())
+                          and all(utils.close_values(states[uri], reference_states[uri]) for uri in states))))
+
+
+if __name__ == '__main__':
+    # Compare the results of CVODE using one and four threads to compute the
+    # dense and banded Jacobians of our models
+
+    utils.header('Jacobian tests')
+
+    for model in ['noble_model_1962.cellml', 'hodgkin_huxley_squid_axon_model_1952.cellml']:
+        print(' - %s:' % model)
+
+        test_jacobian(model, 'Dense')
+        test_jacobian(model, 'Banded')
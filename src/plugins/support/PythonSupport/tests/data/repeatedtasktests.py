@@ -0,0 +1,104 @@
+import opencor as oc
+import sys
+
+sys.dont_write_bytecode = True
+
+import utils
+
+
+if __name__ == '__main__':
+    # Open a SED-ML file with a repeated task that runs the Lorenz model for
+    # different values of sigma
+
+    utils.header('Repeated task tests')
+
+    simulation = utils.open_simulation('tests/sedml/lorenz_repeated_task.sedml')
+    data = simulation.data()
+    results = simulation.results()
+
+    # Modify one of our states, so that we can check that each iteration starts
+    # from our model's initial values rather than from our current ones
+
+    data.states()['main/x'].set_value(5.0)
+
+    # Run our repeated task asynchronously
+
+    runs_count = simulation.runsCount()
+
+    future = simulation.run_async()
+
+    future.wait()
+
+    print(' - Asynchronous run: %s' % utils.yes_no(future.result()))
+    print(' - Number of runs: %d' % (simulation.runsCount() - runs_count))
+
+    # Check each iteration against a run of the Lorenz model using the same
+    # settings and the corresponding value of sigma
+
+    reference = utils.open_simulation('tests/cellml/lorenz.cellml')
+    reference_data = reference.data()
+
+    reference_data.set_ending_point(10.0)
+    reference_data.set_point_interval(0.01)
+    reference_data.set_ode_solver('Euler (forward)')
+    reference_data.set_ode_solver_property('Step', 0.001)
+
+    for i, sigma in enumerate([8.0, 10.0, 12.0]):
+        reference.reset()
+        reference.clear_results()
+
+        reference_data.constants()['main/sigma'].set_value(sigma)
+
+        reference.run()
+
+        run = runs_count + i
+        sigma_values = results.constants()['main/sigma'].values(run)
+
+        print(' - Iteration #%d:' % (i + 1))
+        print('    - main/sigma = %s: %s' % (utils.str_value(sigma),
+                                            utils.yes_no(utils.close_values(sigma_values, [sigma] * len(sigma_values),
+                                                                            1e-9, 1e-12))))
+
+        for uri in ['main/x', 'main/y', 'main/z']:
+            print('    - %s: %s' % (uri, utils.yes_no(utils.close_values(results.states()[uri].values(run),
+                                                                          reference.results().states()[uri].values(),
+                                                                          1e-9, 1e-12))))
+
+    # Run our repeated task again, this time using CVODES and asking for the
+    # sensitivities of our states with respect to rho, and check that they are
+    # stored for each iteration
+
+    utils.header('Repeated task sensitivities tests', False)
+
+    data.set_ode_solver('CVODE')
+    data.set_sensitivity_parameters(['main/rho'])
+
+    reference_data.set_ode_solver('CVODE')
+    reference_data.set_sensitivity_parameters(['main/rho'])
+
+    runs_count = simulation.runsCount()
+
+    simulation.run()
+
+    print(' - Number of runs: %d' % (simulation.runsCount() - runs_count))
+
+    for i, sigma in enumerate([8.0, 10.0, 12.0]):
+        reference.reset()
+        reference.clear_results()
+
+        reference_data.constants()['main/sigma'].set_value(sigma)
+
+        reference.run()
+
+        sensitivities = results.sensitivities(runs_count + i)
+        reference_sensitivities = reference.results().sensitivities()
+
+        print(' - Iteration #%d:' % (i + 1))
+
+        for uri in ['d(main/x)/d(main/rho)', 'd(main/y)/d(main/rho)', 'd(main/z)/d(main/rho)']:
+            print('    - %s: %s' % (uri, utils.yes_no(utils.close_values(list(sensitivities[uri]),
+                                                                          list(reference_sensitivities[uri]),
+                                                                          1e-9, 1e-12))))
+
+    oc.close_simulation(reference)
+    oc.close_simulation(simulation)
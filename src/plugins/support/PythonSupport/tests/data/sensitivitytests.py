@@ -0,0 +1,92 @@
+import opencor as oc
+import sys
+
+sys.dont_write_bytecode = True
+
+import utils
+
+
+def run_simulation(model, constants, sensitivity_parameters=None):
+    # Run the given model using CVODE with tight tolerances, after having
+    # updated the value of the given constants and asked for the sensitivities
+    # with respect to the given parameters, if any
+
+    simulation = utils.open_simulation(model)
+    data = simulation.data()
+
+    data.set_ending_point(1.0)
+    data.set_point_interval(0.01)
+    data.set_ode_solver('CVODE')
+    data.set_ode_solver_property('RelativeTolerance', 1.0e-10)
+    data.set_ode_solver_property('AbsoluteTolerance', 1.0e-10)
+
+    for uri, value in constants.items():
+        data.constants()[uri].set_value(value)
+
+    if sensitivity_parameters is not None:
+        data.set_sensitivity_parameters(sensitivity_parameters)
+
+    simulation.run()
+
+    return simulation
+
+
+def test_sensitivities(model, parameters, tolerance):
+    # Compute the sensitivities of the states of the given model with respect
+    # to the given parameters using CVODES, and compare them against a central
+    # finite difference quotient of two perturbed simulations
+
+    print(' - %s:' % model.split('/')[-1])
+
+    simulation = run_simulation('tests/cellml/%s' % model, {}, parameters)
+    states = list(simulation.results().states().keys())
+    sensitivities = simulation.results().sensitivities()
+    values = {uri: simulation.data().constants()[uri].value() for uri in parameters}
+
+    for parameter in parameters:
+        delta = 1.0e-4 * max(abs(values[parameter]), 1.0)
+        lower_simulation = run_simulation('tests/cellml/%s' % model, {parameter: values[parameter] - delta})
+        upper_simulation = run_simulation('tests/cellml/%s' % model, {parameter: values[parameter] + delta})
+
+        for state in states:
+            lower_values = lower_simulation.results().states()[state].values()
+            upper_values = upper_simulation.results().states()[state].values()
+            uri = 'd(%s)/d(%s)' % (state, parameter)
+
+            print('    - %s: %s'
+                  % (uri,
+                     utils.yes_no(utils.close_values(list(sensitivities[uri]),
+                                                     [(upper_value - lower_value) / (2.0 * delta)
+                                                      for lower_value, upper_value in zip(lower_values, upper_values)],
+                                                     tolerance))))
+
+        oc.close_simulation(lower_simulation)
+        oc.close_simulation(upper_simulation)
+
+    oc.close_simulation(simulation)
+
+
+if __name__ == '__main__':
+    # Check the sensitivities computed by CVODES against a finite difference
+    # reference, both for a constant that only affects the initial value of a
+    # state and for constants that affect the rates of several states
+
+    utils.header('Sensitivity tests')
+
+    test_sensitivities('parabola_ode_model.cellml', ['main/offset'], 1.0e-5)
+    test_sensitivities('lorenz.cellml', ['main/sigma', 'main/rho', 'main/beta'], 1.0e-3)
+
+    # Check that the sensitivity parameters must be constants
+
+    utils.header('Sensitivity parameters tests', False)
+
+    simulation = utils.open_simulation('tests/cellml/lorenz.cellml')
+
+    try:
+        simulation.data().set_sensitivity_parameters(['main/x'])
+
+        print(' - Non-constant parameter rejected: no')
+    except Exception:
+        print(' - Non-constant parameter rejected: yes')
+
+    oc.close_simulation(simulation)
@@ -14,6 +14,19 @@ def header(title, first=True):
     print('---------------------------------------')
 
 
+def yes_no(value):
+    return 'yes' if value else 'no'
+
+
+def close_values(values, reference_values, rel_tol=1e-6, abs_tol=None):
+    if abs_tol is None:
+        abs_tol = rel_tol
+
+    return (len(values) == len(reference_values)) \
+           and all(math.isclose(value, reference_value, rel_tol=rel_tol, abs_tol=abs_tol)
+                   for value, reference_value in zip(values, reference_values))
+
+
 def open_simulation(file_name_or_url):
     if file_name_or_url.startswith('https://'):
         return oc.open_simulation(file_name_or_url)
@@ -196,6 +209,7 @@ def run_simulations(model, title):
     simulation = open_simulation(model)
 
     run_solver_simulation(simulation, 'CVODE')
+    run_solver_simulation(simulation, 'Dormand-Prince')
     run_solver_simulation(simulation, 'Euler (forward)')
     run_solver_simulation(simulation, 'Heun')
     run_solver_simulation(simulation, 'Runge-Kutta (2nd order)')
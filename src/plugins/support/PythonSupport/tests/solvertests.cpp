@@ -0,0 +1,88 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+//==============================================================================
+// Python support solver tests
+//==============================================================================
+
+#include "../../../../tests/src/testsutils.h"
+
+//==============================================================================
+
+#include "solvertests.h"
+
+//==============================================================================
+
+#include <QtTest/QtTest>
+
+//==============================================================================
+
+void SolverTests::tests_data()
+{
+    // The Python scripts to run, each of them coming with the output that it
+    // is expected to generate
+
+    QTest::addColumn<QString>("script");
+
+    // Make sure that DAE models (i.e. models with an NLA system) can be
+    // properly simulated
+
+    QTest::newRow("dae") << "daetests";
+
+    // Make sure that events are located correctly
+
+    QTest::newRow("event") << "eventtests";
+
+    // Make sure that our solvers can interpolate their solution
+
+    QTest::newRow("interpolation") << "interpolationtests";
+
+    // Make sure that Jacobians are computed correctly using several threads
+
+    QTest::newRow("jacobian") << "jacobiantests";
+
+    // Make sure that repeated tasks work fine
+
+    QTest::newRow("repeatedtask") << "repeatedtasktests";
+
+    // Make sure that sensitivities are computed correctly
+
+    QTest::newRow("sensitivity") << "sensitivitytests";
+}
+
+//==============================================================================
+
+void SolverTests::tests()
+{
+    // Run the given Python script and check its output
+
+    QFETCH(QString, script);
+
+    QStringList output;
+
+    QVERIFY(!OpenCOR::runCli({ "-c", "PythonShell", OpenCOR::fileName(QString("src/plugins/support/PythonSupport/tests/data/%1.py").arg(script)) }, output));
+    QCOMPARE(output, OpenCOR::fileContents(OpenCOR::fileName(QString("src/plugins/support/PythonSupport/tests/data/%1.out").arg(script))));
+}
+
+//==============================================================================
+
+QTEST_APPLESS_MAIN(SolverTests)
+
+//==============================================================================
+// End of file
+//==============================================================================
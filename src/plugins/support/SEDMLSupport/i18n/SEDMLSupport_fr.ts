@@ -95,9 +95,13 @@
         <translation>seulement les fichiers SED-ML avec deux simulations avec le même algorithme sont supportés</translation>
     </message>
     <message>
-        <source>only SED-ML files that execute one or two simulations once are supported</source>
+        <source>only SED-ML files that execute one or two simulations are supported</source>
         <translation>seulement les fichiers SED-ML qui exécutent une ou deux simulations sont supportés</translation>
     </message>
+    <message>
+        <source>only SED-ML files that execute one or two simulations, possibly for each value of a vector or uniform range and with set value changes, are supported</source>
+        <translation>seulement les fichiers SED-ML qui exécutent une ou deux simulations, éventuellement pour chaque valeur d&apos;une plage vectorielle ou uniforme et avec des changements de valeur, sont supportés</translation>
+    </message>
     <message>
         <source>only SED-ML files with data generators for one variable are supported</source>
         <translation>seulement les fichiers SED-ML avec des générateurs de donnée pour une variable sont supportés</translation>
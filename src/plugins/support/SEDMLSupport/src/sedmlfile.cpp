@@ -39,6 +39,10 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <cmath>
+
+//==============================================================================
+
 #include "libsedmlbegin.h"
     #include "sedml/SedAlgorithm.h"
     #include "sedml/SedCurve.h"
@@ -47,8 +51,10 @@ along with this program. If not, see <https://gnu.org/licenses>.
     #include "sedml/SedPlot2D.h"
     #include "sedml/SedReader.h"
     #include "sedml/SedRepeatedTask.h"
+    #include "sedml/SedSetValue.h"
     #include "sedml/SedTask.h"
     #include "sedml/SedWriter.h"
+    #include "sedml/SedUniformRange.h"
     #include "sedml/SedUniformTimeCourse.h"
     #include "sedml/SedVectorRange.h"
 #include "libsedmlend.h"
@@ -461,6 +467,109 @@ bool SedmlFile::validColorPropertyValue(const libsbml::XMLNode &pPropertyNode,
 
 //==============================================================================
 
+static bool cellmlVariable(const std::string &pTarget, QString &pComponentName,
+                           QString &pVariableName)
+{
+    // Retrieve the name of the CellML component and variable referenced by the
+    // given target, if it follows the correct CellML format
+
+    static const QRegularExpression TargetStartRegEx  = QRegularExpression(R"(^\/cellml:model\/cellml:component\[@name=')");
+    static const QRegularExpression TargetMiddleRegEx = QRegularExpression(R"(']\/cellml:variable\[@name=')");
+    static const QRegularExpression TargetEndRegEx    = QRegularExpression(R"('\]$)");
+
+    QString target = QString::fromStdString(pTarget);
+
+    if (target.contains(TargetStartRegEx) && target.contains(TargetEndRegEx)) {
+        static const QString Separator = "|";
+
+        target.remove(TargetStartRegEx);
+        target.replace(TargetMiddleRegEx, Separator);
+        target.remove(TargetEndRegEx);
+
+        QStringList identifiers = target.split(Separator);
+
+        if (identifiers.count() == 2) {
+            static const QRegularExpression IdentifierRegEx = QRegularExpression("^[[:alpha:]_][[:alnum:]_]*$");
+
+            pComponentName = identifiers.first();
+            pVariableName = identifiers.last();
+
+            return    IdentifierRegEx.match(pComponentName).hasMatch()
+                   && IdentifierRegEx.match(pVariableName).hasMatch();
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+
+static QList<double> rangeValues(libsedml::SedRange *pRange)
+{
+    // Return the values of the given range, if it is a vector or a uniform
+    // range
+    // Note: like for a uniform time course, the number of points of a uniform
+    //       range is its number of intervals...
+
+    QList<double> res;
+
+    if (pRange->getTypeCode() == libsedml::SEDML_RANGE_VECTORRANGE) {
+        for (auto value : static_cast<libsedml::SedVectorRange *>(pRange)->getValues()) {
+            res << value;
+        }
+    } else if (pRange->getTypeCode() == libsedml::SEDML_RANGE_UNIFORMRANGE) {
+        auto uniformRange = static_cast<libsedml::SedUniformRange *>(pRange);
+        double start = uniformRange->getStart();
+        double end = uniformRange->getEnd();
+        int nbOfPoints = uniformRange->getNumberOfPoints();
+        bool logarithmic = uniformRange->getType() == "log";
+
+        if (   (nbOfPoints > 0)
+            && (!logarithmic || ((start > 0.0) && (end > 0.0)))) {
+            for (int i = 0; i <= nbOfPoints; ++i) {
+                res << (logarithmic?
+                            start*std::pow(end/start, double(i)/nbOfPoints):
+                            start+i*(end-start)/nbOfPoints);
+            }
+        }
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+static bool setValueMath(libsedml::SedSetValue *pSetValue,
+                         const std::string &pRangeId, double pRangeValue,
+                         double &pValue)
+{
+    // Determine the value to be set by the given set value change, which must
+    // either be a number or a reference to the given range
+
+    const libsbml::ASTNode *mathNode = pSetValue->getMath();
+
+    if (mathNode == nullptr) {
+        return false;
+    }
+
+    if (mathNode->isNumber()) {
+        pValue = mathNode->getValue();
+
+        return true;
+    }
+
+    if (   (mathNode->getType() == libsbml::AST_NAME)
+        && (mathNode->getName() == pRangeId)) {
+        pValue = pRangeValue;
+
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+
 bool SedmlFile::isSupported()
 {
     // Make sure that we are valid
@@ -714,13 +823,13 @@ bool SedmlFile::isSupported()
     }
 
     // Make sure that we have only one repeated task, which aim is to execute
-    // each simulation (using a sub-task) once
+    // each simulation (using a sub-task) for each value of its range
 
     uint totalNbOfTasks = (secondSimulation != nullptr)?3:2;
 
     if (mSedmlDocument->getNumTasks() != totalNbOfTasks) {
         mIssues << SedmlFileIssue(SedmlFileIssue::Type::Information,
-                                  tr("only SED-ML files that execute one or two simulations once are supported"));
+                                  tr("only SED-ML files that execute one or two simulations are supported"));
 
         return false;
     }
@@ -742,28 +851,48 @@ bool SedmlFile::isSupported()
 
         if (task->getTypeCode() == libsedml::SEDML_TASK_REPEATEDTASK) {
             // Make sure that the repeated task asks for the model to be reset,
-            // that it has one range, no task change and one/two sub-task/s
+            // that it has one range and one/two sub-task/s
+            // Note: resetting the model means that the different iterations of
+            //       the repeated task are independent of one another, and can
+            //       therefore be run in parallel...
 
             repeatedTask = reinterpret_cast<libsedml::SedRepeatedTask *>(task);
 
             if (   repeatedTask->getResetModel()
                 && (repeatedTask->getNumRanges() == 1)
-                && (repeatedTask->getNumTaskChanges() == 0)
                 && (repeatedTask->getNumSubTasks() == totalNbOfTasks-1)) {
-                // Make sure that the range is a vector range and that it's the
-                // one referenced in the repeated task
+                // Make sure that the range is a vector or a uniform range with
+                // at least one value and that it's the one referenced in the
+                // repeated task
 
                 libsedml::SedRange *range = repeatedTask->getRange(0);
+                QList<double> values = rangeValues(range);
 
-                if (    (range->getTypeCode() == libsedml::SEDML_RANGE_VECTORRANGE)
+                if (   !values.isEmpty()
                     && (repeatedTask->getRangeId() == range->getId())) {
-                    // Make sure that the vector range has one value that is
-                    // equal to 1
+                    // Make sure that the task changes, if any, are set value
+                    // changes that reference both our model and a CellML
+                    // variable, and that their value is either a number or the
+                    // value of our range
 
-                    auto vectorRange = static_cast<libsedml::SedVectorRange *>(range);
+                    bool taskChangesOk = true;
+
+                    for (uint j = 0, jMax = repeatedTask->getNumTaskChanges(); j < jMax; ++j) {
+                        libsedml::SedSetValue *setValue = repeatedTask->getTaskChange(j);
+                        QString componentName;
+                        QString variableName;
+                        double value;
+
+                        if (   (setValue->getModelReference() != model->getId())
+                            || !cellmlVariable(setValue->getTarget(), componentName, variableName)
+                            || !setValueMath(setValue, range->getId(), values.first(), value)) {
+                            taskChangesOk = false;
+
+                            break;
+                        }
+                    }
 
-                    if (   (vectorRange->getNumValues() == 1)
-                        && (qFuzzyCompare(vectorRange->getValues().front(), 1.0))) {
+                    if (taskChangesOk) {
                         // Make sure that the one/two sub-tasks have the correct
                         // order and retrieve their id
 
@@ -803,7 +932,7 @@ bool SedmlFile::isSupported()
         || (   (secondSimulation != nullptr)
             && (!secondSubTaskOk || (repeatedTaskSecondSubTaskId != secondSubTaskId)))) {
         mIssues << SedmlFileIssue(SedmlFileIssue::Type::Information,
-                                  tr("only SED-ML files that execute one or two simulations once are supported"));
+                                  tr("only SED-ML files that execute one or two simulations, possibly for each value of a vector or uniform range and with set value changes, are supported"));
 
         return false;
     }
@@ -839,32 +968,9 @@ bool SedmlFile::isSupported()
             return false;
         }
 
-        static const QRegularExpression TargetStartRegEx  = QRegularExpression(R"(^\/cellml:model\/cellml:component\[@name=')");
-        static const QRegularExpression TargetMiddleRegEx = QRegularExpression(R"(']\/cellml:variable\[@name=')");
-        static const QRegularExpression TargetEndRegEx    = QRegularExpression(R"('\]$)");
-
-        bool referencingCellmlVariable = false;
-        QString target = QString::fromStdString(variable->getTarget());
-
-        if (target.contains(TargetStartRegEx) && target.contains(TargetEndRegEx)) {
-            static const QString Separator = "|";
-
-            target.remove(TargetStartRegEx);
-            target.replace(TargetMiddleRegEx, Separator);
-            target.remove(TargetEndRegEx);
-
-            QStringList identifiers = target.split(Separator);
-
-            if (identifiers.count() == 2) {
-                static const QRegularExpression IdentifierRegEx = QRegularExpression("^[[:alpha:]_][[:alnum:]_]*$");
-
-                QString componentName = identifiers.first();
-                QString variableName = identifiers.last();
-
-                referencingCellmlVariable =    IdentifierRegEx.match(componentName).hasMatch()
-                                            && IdentifierRegEx.match(variableName).hasMatch();
-            }
-        }
+        QString componentName;
+        QString variableName;
+        bool referencingCellmlVariable = cellmlVariable(variable->getTarget(), componentName, variableName);
 
         if (!referencingCellmlVariable) {
             mIssues << SedmlFileIssue(SedmlFileIssue::Type::Information,
@@ -1376,6 +1482,52 @@ bool SedmlFile::isSupported()
 
 //==============================================================================
 
+SedmlFileRepeatedTaskIterations SedmlFile::repeatedTaskIterations()
+{
+    // Return the iterations of our repeated task, i.e. for each value of its
+    // range, the value that each CellML variable should be given
+    // Note: we return no iteration if we are not supported...
+
+    SedmlFileRepeatedTaskIterations res;
+
+    if (!isSupported()) {
+        return res;
+    }
+
+    for (uint i = 0, iMax = mSedmlDocument->getNumTasks(); i < iMax; ++i) {
+        auto task = mSedmlDocument->getTask(i);
+
+        if (task->getTypeCode() == libsedml::SEDML_TASK_REPEATEDTASK) {
+            auto repeatedTask = reinterpret_cast<libsedml::SedRepeatedTask *>(task);
+            libsedml::SedRange *range = repeatedTask->getRange(0);
+
+            for (auto rangeValue : rangeValues(range)) {
+                SedmlFileRepeatedTaskIteration iteration;
+
+                for (uint j = 0, jMax = repeatedTask->getNumTaskChanges(); j < jMax; ++j) {
+                    libsedml::SedSetValue *setValue = repeatedTask->getTaskChange(j);
+                    QString componentName;
+                    QString variableName;
+                    double value;
+
+                    cellmlVariable(setValue->getTarget(), componentName, variableName);
+                    setValueMath(setValue, range->getId(), rangeValue, value);
+
+                    iteration.insert(QPair<QString, QString>(componentName, variableName), value);
+                }
+
+                res << iteration;
+            }
+
+            break;
+        }
+    }
+
+    return res;
+}
+
+//==============================================================================
+
 CellMLSupport::CellmlFile * SedmlFile::cellmlFile()
 {
     // Return our CellML file, after having created it, if necessary
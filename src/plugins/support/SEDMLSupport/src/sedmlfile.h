@@ -31,6 +31,8 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QMap>
+#include <QPair>
 #include <QString>
 
 //==============================================================================
@@ -112,6 +114,11 @@ namespace Language {
 
 //==============================================================================
 
+using SedmlFileRepeatedTaskIteration = QMap<QPair<QString, QString>, double>;
+using SedmlFileRepeatedTaskIterations = QList<SedmlFileRepeatedTaskIteration>;
+
+//==============================================================================
+
 class SEDMLSUPPORT_EXPORT SedmlFile : public StandardSupport::StandardFile
 {
     Q_OBJECT
@@ -135,6 +142,8 @@ public:
     bool isValid();
     bool isSupported();
 
+    SedmlFileRepeatedTaskIterations repeatedTaskIterations();
+
     CellMLSupport::CellmlFile * cellmlFile();
 
     SedmlFileIssues issues() const;
@@ -15,6 +15,14 @@
         <source>the starting point cannot be greater than the ending point</source>
         <translation>le point de départ ne peut pas être plus grand que le point d&apos;arrivée</translation>
     </message>
+    <message>
+        <source>the value of %1 in %2 cannot be set</source>
+        <translation>la valeur de %1 dans %2 ne peut pas être spécifiée</translation>
+    </message>
+    <message>
+        <source>the memory required for the repeated task could not be allocated</source>
+        <translation>la mémoire requise pour la tâche répétée n&apos;a pas pu être allouée</translation>
+    </message>
 </context>
 <context>
     <name>OpenCOR::SimulationSupport::SimulationSupportPythonWrapper</name>
@@ -30,6 +38,29 @@
         <source>The memory required for the simulation could not be allocated.</source>
         <translation>La mémoire requise pour la simulation n&apos;a pas pu être allouée.</translation>
     </message>
+    <message>
+        <source>The simulation is already running.</source>
+        <translation>La simulation est déjà en cours d&apos;exécution.</translation>
+    </message>
+    <message>
+        <source>The simulation has no results.</source>
+        <translation>La simulation n&apos;a pas de résultats.</translation>
+    </message>
+    <message>
+        <source>The requested sensitivity parameter (%1) is not a constant.</source>
+        <translation>Le paramètre de sensibilité demandé (%1) n&apos;est pas une constante.</translation>
+    </message>
+    <message>
+        <source>The sensitivity parameters cannot be set while the simulation is running.</source>
+        <translation>Les paramètres de sensibilité ne peuvent pas être définis pendant que la simulation est en cours d&apos;exécution.</translation>
+    </message>
+</context>
+<context>
+    <name>OpenCOR::SimulationSupport::SimulationWorker</name>
+    <message>
+        <source>the %1 solver cannot compute sensitivities</source>
+        <translation>le solveur %1 ne peut pas calculer de sensibilités</translation>
+    </message>
 </context>
 <context>
     <name>QObject</name>
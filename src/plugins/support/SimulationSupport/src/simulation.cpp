@@ -33,6 +33,11 @@ along with this program. If not, see <https://gnu.org/licenses>.
 //==============================================================================
 
 #include <QThread>
+#include <QtMath>
+
+//==============================================================================
+
+#include <limits>
 
 //==============================================================================
 
@@ -50,6 +55,17 @@ namespace SimulationSupport {
 
 //==============================================================================
 
+static QString uri(const QStringList &pComponentHierarchy, const QString &pName)
+{
+    // Generate an URI using the given component hierarchy and name
+
+    QString res = pComponentHierarchy.join('/')+"/"+pName;
+
+    return res.replace('\'', "/prime");
+}
+
+//==============================================================================
+
 SimulationIssue::SimulationIssue(Type pType, int pLine, int pColumn,
                                  const QString &pMessage) :
     mType(pType),
@@ -235,6 +251,154 @@ DataStore::DataStoreValues * SimulationData::algebraicValues() const
 
 //==============================================================================
 
+int SimulationData::sensitivityConstantIndex(const QString &pUri) const
+{
+    // Return the index of the given constant, but only if it is a "proper"
+    // constant, i.e. not a computed constant, since only the former can be
+    // used to compute sensitivities
+
+    CellMLSupport::CellmlFileRuntime *runtime = mSimulation->runtime();
+
+    if (runtime != nullptr) {
+        for (auto parameter : runtime->parameters()) {
+            if (   (parameter->type() == CellMLSupport::CellmlFileRuntimeParameter::Type::Constant)
+                && (mConstantsValues->uri(parameter->index()) == pUri)) {
+                return parameter->index();
+            }
+        }
+    }
+
+    return -1;
+}
+
+//==============================================================================
+
+QVector<int> SimulationData::sensitivityConstants() const
+{
+    // Return the constants with respect to which we compute the sensitivities
+    // of our states
+
+    return mSensitivityConstants;
+}
+
+//==============================================================================
+
+bool SimulationData::setSensitivityConstants(const QVector<int> &pSensitivityConstants)
+{
+    // Keep track of the constants with respect to which we want to compute the
+    // sensitivities of our states and (re)create our sensitivities array
+    // Note #1: we cannot do this while our simulation is running since our
+    //          worker and ODE solver use our sensitivities array...
+    // Note #2: our simulation results keep track of our sensitivities array,
+    //          so we need to reset them...
+
+    if (mSimulation->isRunning()) {
+        return false;
+    }
+
+    if (pSensitivityConstants == mSensitivityConstants) {
+        return true;
+    }
+
+    delete[] mSensitivities;
+
+    mSensitivityConstants = pSensitivityConstants;
+    mSensitivities = mSensitivityConstants.isEmpty()?
+                         nullptr:
+                         new double[mSensitivityConstants.count()*mSimulation->runtime()->statesCount()]{};
+
+    mSimulation->results()->reset();
+
+    return true;
+}
+
+//==============================================================================
+
+double * SimulationData::sensitivities() const
+{
+    // Return our sensitivities, i.e. dY_j/dC_i is at [i*statesCount+j]
+
+    return mSensitivities;
+}
+
+//==============================================================================
+
+void SimulationData::resetSensitivities(double pCurrentPoint)
+{
+    // Reset our sensitivities using our model data
+
+    if (mSensitivities == nullptr) {
+        return;
+    }
+
+    resetSensitivities(pCurrentPoint, constants(), rates(), states(),
+                       algebraic(), mSensitivities);
+}
+
+//==============================================================================
+
+void SimulationData::resetSensitivities(double pCurrentPoint,
+                                        double *pConstants, double *pRates,
+                                        const double *pStates,
+                                        double *pAlgebraic,
+                                        double *pSensitivities) const
+{
+    // Reset the given sensitivities, which are zero unless the initial value of
+    // a state is computed using a constant, in which case we compute its
+    // sensitivity using a forward difference quotient
+    // Note #1: we compute the initial value of our states in copies of the
+    //          given states since the user may have modified some of them...
+    // Note #2: computing our computed constants may require solving some NLA
+    //          systems, so this method must be called with an NLA solver set,
+    //          if needed...
+    // Note #3: the given model data may be that of an iteration of a repeated
+    //          task, so we only use our own sensitivity constants...
+
+    static const double SqrtEpsilon = qSqrt(std::numeric_limits<double>::epsilon());
+
+    CellMLSupport::CellmlFileRuntime *runtime = mSimulation->runtime();
+    int statesCount = runtime->statesCount();
+    auto initialStates = new double[statesCount];
+    auto perturbedInitialStates = new double[statesCount];
+
+    memcpy(initialStates, pStates, size_t(statesCount)*Solver::SizeOfDouble);
+
+    runtime->computeComputedConstants()(pCurrentPoint, pConstants, pRates,
+                                        initialStates, pAlgebraic);
+
+    for (int i = 0, iMax = mSensitivityConstants.count(); i < iMax; ++i) {
+        int constantIndex = mSensitivityConstants[i];
+        double constant = pConstants[constantIndex];
+        double delta = SqrtEpsilon*((constant != 0.0)?qAbs(constant):1.0);
+        double *sensitivities = pSensitivities+i*statesCount;
+
+        memcpy(perturbedInitialStates, pStates, size_t(statesCount)*Solver::SizeOfDouble);
+
+        pConstants[constantIndex] = constant+delta;
+
+        runtime->computeComputedConstants()(pCurrentPoint, pConstants, pRates,
+                                            perturbedInitialStates, pAlgebraic);
+
+        pConstants[constantIndex] = constant;
+
+        for (int j = 0; j < statesCount; ++j) {
+            sensitivities[j] = (perturbedInitialStates[j]-initialStates[j])/delta;
+        }
+    }
+
+    // Recompute our computed constants using our unperturbed constants
+    // Note: we use our perturbed initial states as dummy states since the given
+    //       states must not be overwritten...
+
+    runtime->computeComputedConstants()(pCurrentPoint, pConstants, pRates,
+                                        perturbedInitialStates, pAlgebraic);
+
+    delete[] initialStates;
+    delete[] perturbedInitialStates;
+}
+
+//==============================================================================
+
 double * SimulationData::data(DataStore::DataStore *pDataStore) const
 {
     // Return our corresponding data array
@@ -534,7 +698,7 @@ void SimulationData::reset(bool pInitialize, bool pAll)
 
         nlaSolver = static_cast<Solver::NlaSolver *>(nlaSolverInterface()->solverInstance());
 
-        Solver::setNlaSolver(runtime, nlaSolver);
+        CellMLSupport::CellmlFileRuntime::setNlaSolver(nlaSolver);
 
         // Keep track of any error that might be reported by our NLA solver
 
@@ -594,6 +758,8 @@ void SimulationData::reset(bool pInitialize, bool pAll)
 
     if (nlaSolver != nullptr) {
         delete nlaSolver;
+
+        CellMLSupport::CellmlFileRuntime::setNlaSolver(nullptr);
     }
 
     // Let people know whether our data is clean, i.e. not modified, and ask our
@@ -651,11 +817,12 @@ void SimulationData::recomputeComputedConstantsAndVariables(double pCurrentPoint
 void SimulationData::recomputeVariables(double pCurrentPoint)
 {
     // Recompute our 'variables'
+    // Note: our rates (and the algebraic variables on which they depend) are
+    //       expected to be up to date, be it because our ODE solver has just
+    //       computed them (see the note about solve() in OdeSolver) or because
+    //       our simulation worker has just initialised them...
 
-    CellMLSupport::CellmlFileRuntime *runtime = mSimulation->runtime();
-
-    runtime->computeRates()(pCurrentPoint, constants(), rates(), states(), algebraic());
-    runtime->computeVariables()(pCurrentPoint, constants(), rates(), states(), algebraic());
+    mSimulation->runtime()->computeVariables()(pCurrentPoint, constants(), rates(), states(), algebraic());
 }
 
 //==============================================================================
@@ -752,12 +919,61 @@ void SimulationData::createArrays()
         mStatesArray = new DataStore::DataStoreArray(quint64(runtime->statesCount()));
         mAlgebraicArray = new DataStore::DataStoreArray(quint64(runtime->algebraicCount()));
 
-        // Create our various values to hold our model's arrays
+        // Create our various values to hold our model's arrays, after having
+        // determined the URI of each of their values
+        // Note: our URIs are held in (implicitly shared) string lists, so that
+        //       they can be reused by our simulation results...
+
+        QStringList constantsUris;
+        QStringList ratesUris;
+        QStringList statesUris;
+        QStringList algebraicUris;
+
+        constantsUris.reserve(runtime->constantsCount());
+        ratesUris.reserve(runtime->ratesCount());
+        statesUris.reserve(runtime->statesCount());
+        algebraicUris.reserve(runtime->algebraicCount());
+
+        for (int i = 0, iMax = runtime->constantsCount(); i < iMax; ++i) {
+            constantsUris << QString();
+        }
+
+        for (int i = 0, iMax = runtime->ratesCount(); i < iMax; ++i) {
+            ratesUris << QString();
+        }
+
+        for (int i = 0, iMax = runtime->statesCount(); i < iMax; ++i) {
+            statesUris << QString();
+        }
+
+        for (int i = 0, iMax = runtime->algebraicCount(); i < iMax; ++i) {
+            algebraicUris << QString();
+        }
+
+        for (auto parameter : runtime->parameters()) {
+            CellMLSupport::CellmlFileRuntimeParameter::Type parameterType = parameter->type();
+            QStringList *uris = nullptr;
+
+            if (   (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Constant)
+                || (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::ComputedConstant)) {
+                uris = &constantsUris;
+            } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Rate) {
+                uris = &ratesUris;
+            } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::State) {
+                uris = &statesUris;
+            } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Algebraic) {
+                uris = &algebraicUris;
+            }
+
+            if (uris != nullptr) {
+                (*uris)[parameter->index()] = uri(parameter->componentHierarchy(), parameter->formattedName());
+            }
+        }
 
-        mConstantsValues = new DataStore::DataStoreValues(mConstantsArray);
-        mRatesValues = new DataStore::DataStoreValues(mRatesArray);
-        mStatesValues = new DataStore::DataStoreValues(mStatesArray);
-        mAlgebraicValues = new DataStore::DataStoreValues(mAlgebraicArray);
+        mConstantsValues = new DataStore::DataStoreValues(mConstantsArray, constantsUris);
+        mRatesValues = new DataStore::DataStoreValues(mRatesArray, ratesUris);
+        mStatesValues = new DataStore::DataStoreValues(mStatesArray, statesUris);
+        mAlgebraicValues = new DataStore::DataStoreValues(mAlgebraicArray, algebraicUris);
 
         // Create our various arrays to keep track of our various initial values
 
@@ -808,12 +1024,19 @@ void SimulationData::deleteArrays()
     delete[] mInitialStates;
     delete[] mDummyStates;
 
+    delete[] mSensitivities;
+
     // Reset our various arrays
-    // Note: this shouldn't be needed, but better be safe than sorry...
+    // Note #1: this shouldn't be needed, but better be safe than sorry...
+    // Note #2: our sensitivity constants are indices in our constants array,
+    //          which may not be valid anymore, hence we forget about them...
 
     mConstantsArray = mRatesArray = mStatesArray = mAlgebraicArray = nullptr;
     mConstantsValues = mRatesValues = mStatesValues = mAlgebraicValues = nullptr;
     mInitialConstants = mInitialStates = mDummyStates = nullptr;
+
+    mSensitivityConstants.clear();
+    mSensitivities = nullptr;
 }
 
 //==============================================================================
@@ -846,18 +1069,6 @@ SimulationResults::~SimulationResults()
 
 //==============================================================================
 
-QString SimulationResults::uri(const QStringList &pComponentHierarchy,
-                               const QString &pName)
-{
-    // Generate an URI using the given component hierarchy and name
-
-    QString res = pComponentHierarchy.join('/')+"/"+pName;
-
-    return res.replace('\'', "/prime");
-}
-
-//==============================================================================
-
 void SimulationResults::createDataStore()
 {
     // Make sure that we have a runtime and a VOI
@@ -888,11 +1099,13 @@ void SimulationResults::createDataStore()
     DataStore::DataStoreValues *ratesValues = simulationData->ratesValues();
     DataStore::DataStoreValues *statesValues = simulationData->statesValues();
     DataStore::DataStoreValues *algebraicValues = simulationData->algebraicValues();
+    QVector<CellMLSupport::CellmlFileRuntimeParameter *> constantsParameters(runtime->constantsCount());
+    QVector<CellMLSupport::CellmlFileRuntimeParameter *> statesParameters(runtime->statesCount());
 
     for (auto parameter : runtime->parameters()) {
         CellMLSupport::CellmlFileRuntimeParameter::Type parameterType = parameter->type();
         DataStore::DataStoreVariable *variable = nullptr;
-        DataStore::DataStoreValue *value = nullptr;
+        DataStore::DataStoreValues *values = nullptr;
 
         if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Voi) {
             mPointsVariable->setType(int(parameter->type()));
@@ -902,27 +1115,56 @@ void SimulationResults::createDataStore()
         } else if (   (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Constant)
                    || (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::ComputedConstant)) {
             variable = mConstantsVariables[parameter->index()];
-            value = constantsValues->at(parameter->index());
+            values = constantsValues;
+
+            constantsParameters[parameter->index()] = parameter;
         } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Rate) {
             variable = mRatesVariables[parameter->index()];
-            value = ratesValues->at(parameter->index());
+            values = ratesValues;
         } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::State) {
             variable = mStatesVariables[parameter->index()];
-            value = statesValues->at(parameter->index());
+            values = statesValues;
+
+            statesParameters[parameter->index()] = parameter;
         } else if (parameterType == CellMLSupport::CellmlFileRuntimeParameter::Type::Algebraic) {
             variable = mAlgebraicVariables[parameter->index()];
-            value = algebraicValues->at(parameter->index());
+            values = algebraicValues;
         }
 
         if (variable != nullptr) {
             variable->setType(int(parameter->type()));
-            variable->setUri(uri(parameter->componentHierarchy(), parameter->formattedName()));
+            variable->setUri(values->uri(parameter->index()));
             variable->setName(parameter->formattedName());
             variable->setUnit(parameter->formattedUnit(runtime->voi()->unit()));
         }
+    }
 
-        if (value != nullptr) {
-            value->setUri(uri(parameter->componentHierarchy(), parameter->formattedName()));
+    // Add and customise our sensitivity variables, if any, i.e. dY/dC where Y
+    // is a state and C a constant
+
+    QVector<int> sensitivityConstants = simulationData->sensitivityConstants();
+
+    if (!sensitivityConstants.isEmpty()) {
+        int statesCount = runtime->statesCount();
+
+        mSensitivitiesVariables = mDataStore->addVariables(simulationData->sensitivities(),
+                                                           sensitivityConstants.count()*statesCount);
+
+        for (int i = 0, iMax = sensitivityConstants.count(); i < iMax; ++i) {
+            int constantIndex = sensitivityConstants[i];
+            CellMLSupport::CellmlFileRuntimeParameter *constantParameter = constantsParameters[constantIndex];
+
+            for (int j = 0; j < statesCount; ++j) {
+                DataStore::DataStoreVariable *variable = mSensitivitiesVariables[i*statesCount+j];
+                CellMLSupport::CellmlFileRuntimeParameter *stateParameter = statesParameters[j];
+
+                variable->setUri(QString("d(%1)/d(%2)").arg(statesValues->uri(j),
+                                                             constantsValues->uri(constantIndex)));
+                variable->setName(QString("d(%1)/d(%2)").arg(stateParameter->formattedName(),
+                                                             constantParameter->formattedName()));
+                variable->setUnit(QString("%1/%2").arg(stateParameter->formattedUnit(runtime->voi()->unit()),
+                                                       constantParameter->formattedUnit(runtime->voi()->unit())));
+            }
         }
     }
 
@@ -971,6 +1213,9 @@ void SimulationResults::deleteDataStore()
     mRatesVariables = DataStore::DataStoreVariables();
     mStatesVariables = DataStore::DataStoreVariables();
     mAlgebraicVariables = DataStore::DataStoreVariables();
+    mSensitivitiesVariables = DataStore::DataStoreVariables();
+
+    mEvents.clear();
 
     mData.clear();
 }
@@ -1102,6 +1347,8 @@ bool SimulationResults::addRun()
         bool res = mDataStore->addRun(simulationSize);
 
         if (res) {
+            mEvents << QVector<double>();
+
             emit runAdded();
         }
 
@@ -1212,6 +1459,60 @@ void SimulationResults::addPoint(double pPoint)
 
 //==============================================================================
 
+void SimulationResults::addData(double pPoint, int pRun)
+{
+    // Add the values of our imported data at the given point to the given run
+    // Note: this is used by the iterations of a repeated task, which all start
+    //       from our starting point and are run in parallel, hence we use the
+    //       given point as is (rather than its real value, as in addPoint())
+    //       and we don't update our imported data arrays...
+
+    for (auto data = mDataDataStores.constBegin(), dataEnd = mDataDataStores.constEnd();
+         data != dataEnd; ++data) {
+        DataStore::DataStoreVariable *voi = data.value()->voi();
+        DataStore::DataStoreVariables variables = data.value()->variables();
+        DataStore::DataStoreVariables resultsVariables = mData.value(data.key());
+
+        for (int i = 0, iMax = variables.count(); i < iMax; ++i) {
+            resultsVariables[i]->addValue(realValue(pPoint, voi, variables[i]), pRun);
+        }
+    }
+}
+
+//==============================================================================
+
+void SimulationResults::addEvents(const QVector<double> &pEvents, int pRun)
+{
+    // Keep track of the given events for the given run or our current one
+
+    if (mEvents.isEmpty()) {
+        mEvents << QVector<double>();
+    }
+
+    if (pRun == -1) {
+        mEvents.last() << pEvents;
+    } else if (pRun < mEvents.count()) {
+        mEvents[pRun] << pEvents;
+    }
+}
+
+//==============================================================================
+
+QVector<double> SimulationResults::events(int pRun) const
+{
+    // Return our events for the given run
+
+    if (mEvents.isEmpty()) {
+        return {};
+    }
+
+    return (pRun == -1)?
+                mEvents.last():
+                mEvents.value(pRun);
+}
+
+//==============================================================================
+
 quint64 SimulationResults::size(int pRun) const
 {
     // Return the size of our data store for the given run
@@ -1345,6 +1646,15 @@ DataStore::DataStoreVariables SimulationResults::algebraicVariables() const
 
 //==============================================================================
 
+DataStore::DataStoreVariables SimulationResults::sensitivitiesVariables() const
+{
+    // Return our sensitivities variables
+
+    return mSensitivitiesVariables;
+}
+
+//==============================================================================
+
 SimulationImportData::SimulationImportData(Simulation *pSimulation) :
     SimulationObject(pSimulation)
 {
@@ -1400,6 +1710,12 @@ Simulation::Simulation(const QString &pFileName) :
 
     connect(Core::FileManager::instance(), &Core::FileManager::fileManaged,
             this, &Simulation::fileManaged);
+
+    // Make sure that our solvers have been activated, if they were deferred,
+    // since our workers will need them and we are on the main thread while
+    // they are not (see Core::solverInterfaces())
+
+    Core::solverInterfaces();
 }
 
 //==============================================================================
@@ -1911,6 +2227,45 @@ void Simulation::setDelay(quint64 pDelay)
 
 //==============================================================================
 
+bool Simulation::isInstrumented() const
+{
+    // Return whether we are instrumented
+
+    return mInstrumented;
+}
+
+//==============================================================================
+
+void Simulation::setInstrumented(bool pInstrumented)
+{
+    // Set whether we are instrumented, i.e. whether our worker should time how
+    // long is spent solving our model and adding points to our results
+    // Note: our solvers' statistics are always available since they come at
+    //       (virtually) no cost...
+
+    mInstrumented = pInstrumented;
+}
+
+//==============================================================================
+
+QVariantMap Simulation::statistics() const
+{
+    // Return the statistics of our last run
+
+    return mStatistics;
+}
+
+//==============================================================================
+
+void Simulation::setStatistics(const QVariantMap &pStatistics)
+{
+    // Set the statistics of our last run
+
+    mStatistics = pStatistics;
+}
+
+//==============================================================================
+
 bool Simulation::simulationSettingsOk(bool pEmitSignal)
 {
     // Check and return whether our simulation settings are sound
@@ -1962,38 +2317,161 @@ void Simulation::run()
     // settings we were given are sound
 
     if ((mWorker == nullptr) && simulationSettingsOk()) {
-        // Create and move our worker to a thread
+        // Reset the statistics of our last run
+
+        mStatistics.clear();
 
-        auto thread = new QThread();
-        mWorker = new SimulationWorker(this, thread, mWorker);
+        // Create and start our worker
 
-        mWorker->moveToThread(thread);
+        createWorker();
+        startWorker();
+    }
+}
+
+//==============================================================================
+
+void Simulation::createWorker()
+{
+    // Create and move our worker to a thread
+
+    auto thread = new QThread();
+    mWorker = new SimulationWorker(this, thread, mWorker);
+
+    mWorker->moveToThread(thread);
+
+    connect(thread, &QThread::started,
+            mWorker, &SimulationWorker::run);
+
+    connect(mWorker, &SimulationWorker::running,
+            this, &Simulation::running);
+    connect(mWorker, &SimulationWorker::paused,
+            this, &Simulation::paused);
+
+    connect(mWorker, &SimulationWorker::progress,
+            this, &Simulation::progress);
+
+    connect(mWorker, &SimulationWorker::done,
+            this, &Simulation::done);
+    connect(mWorker, &SimulationWorker::done,
+            thread, &QThread::quit);
+    connect(mWorker, &SimulationWorker::done,
+            mWorker, &SimulationWorker::deleteLater);
+
+    connect(mWorker, &SimulationWorker::error,
+            this, &Simulation::error);
+
+    connect(thread, &QThread::finished,
+            thread, &QThread::deleteLater);
+}
+
+//==============================================================================
+
+void Simulation::startWorker()
+{
+    // Let people know about our worker, before it gets started, so that they
+    // can (directly) connect to it, if needed
+
+    emit workerCreated(mWorker);
+
+    // Start our worker by starting the thread in which it is
+
+    mWorker->thread()->start();
+}
+
+//==============================================================================
+
+bool Simulation::hasRepeatedTask()
+{
+    // Return whether we have a repeated task that does more than running our
+    // simulation once
+
+    if ((mSedmlFile == nullptr) || hasBlockingIssues()) {
+        return false;
+    }
 
-        connect(thread, &QThread::started,
-                mWorker, &SimulationWorker::run);
+    SEDMLSupport::SedmlFileRepeatedTaskIterations iterations = mSedmlFile->repeatedTaskIterations();
 
-        connect(mWorker, &SimulationWorker::running,
-                this, &Simulation::running);
-        connect(mWorker, &SimulationWorker::paused,
-                this, &Simulation::paused);
+    return    (iterations.count() > 1)
+           || ((iterations.count() == 1) && !iterations.first().isEmpty());
+}
+
+//==============================================================================
+
+bool Simulation::runRepeatedTask()
+{
+    // Make sure that we have a runtime, that we are not already running and
+    // that our simulation settings are sound
+
+    if ((mRuntime == nullptr) || (mWorker != nullptr) || !simulationSettingsOk()) {
+        return false;
+    }
 
-        connect(mWorker, &SimulationWorker::done,
-                this, &Simulation::done);
-        connect(mWorker, &SimulationWorker::done,
-                thread, &QThread::quit);
-        connect(mWorker, &SimulationWorker::done,
-                mWorker, &SimulationWorker::deleteLater);
+    // We don't gather any statistics for a repeated task, so make sure that we
+    // don't report those of a previous run
 
-        connect(mWorker, &SimulationWorker::error,
-                this, &Simulation::error);
+    mStatistics.clear();
 
-        connect(thread, &QThread::finished,
-                thread, &QThread::deleteLater);
+    // Determine the changes to be made for each iteration of our repeated task
 
-        // Start our worker by starting the thread in which it is
+    CellMLSupport::CellmlFileRuntimeParameters parameters = mRuntime->parameters();
+    QList<SimulationRepeatedTaskChanges> iterationsChanges;
 
-        thread->start();
+    for (const auto &iteration : mSedmlFile->repeatedTaskIterations()) {
+        SimulationRepeatedTaskChanges changes;
+
+        for (auto change = iteration.constBegin(), changeEnd = iteration.constEnd();
+             change != changeEnd; ++change) {
+            CellMLSupport::CellmlFileRuntimeParameter *changeParameter = nullptr;
+
+            for (auto parameter : parameters) {
+                if (   (parameter->degree() == 0)
+                    && (   (parameter->type() == CellMLSupport::CellmlFileRuntimeParameter::Type::Constant)
+                        || (parameter->type() == CellMLSupport::CellmlFileRuntimeParameter::Type::State))
+                    && (parameter->name() == change.key().second)
+                    && (parameter->componentHierarchy().last() == change.key().first)) {
+                    changeParameter = parameter;
+
+                    break;
+                }
+            }
+
+            if (changeParameter == nullptr) {
+                emit error(tr("the value of %1 in %2 cannot be set").arg(change.key().second,
+                                                                         change.key().first));
+
+                return false;
+            }
+
+            changes << qMakePair(changeParameter, change.value());
+        }
+
+        iterationsChanges << changes;
     }
+
+    // Add a run for each iteration of our repeated task
+
+    int firstRun = runsCount();
+
+    for (int i = 0, iMax = iterationsChanges.count(); i < iMax; ++i) {
+        if (!addRun()) {
+            emit error(tr("the memory required for the repeated task could not be allocated"));
+
+            return false;
+        }
+    }
+
+    // Create our worker, let it know about our repeated task, and start it
+    // Note: our worker runs the iterations of our repeated task in parallel,
+    //       each in its own run, and lets people know about its progress and
+    //       when it is done (see SimulationWorker::runRepeatedTask())...
+
+    createWorker();
+
+    mWorker->setRepeatedTask(iterationsChanges, firstRun);
+
+    startWorker();
+
+    return true;
 }
 
 //==============================================================================
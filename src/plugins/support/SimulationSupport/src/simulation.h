@@ -72,6 +72,18 @@ class Simulation;
 class SimulationData;
 class SimulationWorker;
 
+//==============================================================================
+// Note: on top of the statistics reported by our solvers (see
+//       solverinterface.h), a run also reports the number of points that were
+//       computed and, if our simulation is instrumented, the time (in
+//       milliseconds) that was spent in our ODE solver and in adding points to
+//       our results...
+
+static const auto PointsStatistic           = QStringLiteral("points");
+static const auto NlaSolvesPerStepStatistic = QStringLiteral("nlaSolvesPerStep");
+static const auto SolverTimeStatistic       = QStringLiteral("solverTime");
+static const auto AddPointTimeStatistic     = QStringLiteral("addPointTime");
+
 //==============================================================================
 // Note: we bind the SimulationData object to the the first parameter of
 //       updateParameters() to create a function object to be called when
@@ -155,6 +167,18 @@ public:
     DataStore::DataStoreValues * statesValues() const;
     DataStore::DataStoreValues * algebraicValues() const;
 
+    int sensitivityConstantIndex(const QString &pUri) const;
+
+    QVector<int> sensitivityConstants() const;
+    bool setSensitivityConstants(const QVector<int> &pSensitivityConstants);
+
+    double * sensitivities() const;
+
+    void resetSensitivities(double pCurrentPoint);
+    void resetSensitivities(double pCurrentPoint, double *pConstants,
+                            double *pRates, const double *pStates,
+                            double *pAlgebraic, double *pSensitivities) const;
+
     void setStartingPoint(double pStartingPoint, bool pRecompute = true);
     void setEndingPoint(double pEndingPoint);
     void setPointInterval(double pPointInterval);
@@ -199,6 +223,9 @@ private:
     double *mInitialStates = nullptr;
     double *mDummyStates = nullptr;
 
+    QVector<int> mSensitivityConstants;
+    double *mSensitivities = nullptr;
+
     QMap<DataStore::DataStore *, double *> mData;
 
     SimulationDataUpdatedFunction mSimulationDataUpdatedFunction;
@@ -270,6 +297,8 @@ public:
     bool addRun();
 
     void addPoint(double pPoint);
+    void addData(double pPoint, int pRun);
+    void addEvents(const QVector<double> &pEvents, int pRun = -1);
 
     double * points(int pRun = -1) const;
 
@@ -286,6 +315,9 @@ public:
     DataStore::DataStoreVariables ratesVariables() const;
     DataStore::DataStoreVariables statesVariables() const;
     DataStore::DataStoreVariables algebraicVariables() const;
+    DataStore::DataStoreVariables sensitivitiesVariables() const;
+
+    QVector<double> events(int pRun = -1) const;
 
 private:
     DataStore::DataStore *mDataStore = nullptr;
@@ -296,6 +328,9 @@ private:
     DataStore::DataStoreVariables mRatesVariables;
     DataStore::DataStoreVariables mStatesVariables;
     DataStore::DataStoreVariables mAlgebraicVariables;
+    DataStore::DataStoreVariables mSensitivitiesVariables;
+
+    QList<QVector<double>> mEvents;
 
     QMap<double *, DataStore::DataStoreVariables> mData;
     QMap<double *, DataStore::DataStore *> mDataDataStores;
@@ -303,8 +338,6 @@ private:
     void createDataStore();
     void deleteDataStore();
 
-    QString uri(const QStringList &pComponentHierarchy, const QString &pName);
-
     double realPoint(double pPoint, int pRun = -1) const;
 
     double realValue(double pPoint, DataStore::DataStoreVariable *pVoi,
@@ -379,6 +412,9 @@ public:
 
     bool addRun();
 
+    bool hasRepeatedTask();
+    bool runRepeatedTask();
+
     void run();
     void pause();
     void resume();
@@ -386,6 +422,12 @@ public:
 
     void reset(bool pAll = true);
 
+    bool isInstrumented() const;
+    void setInstrumented(bool pInstrumented);
+
+    QVariantMap statistics() const;
+    void setStatistics(const QVariantMap &pStatistics);
+
 private:
     QString mFileName;
 
@@ -407,19 +449,29 @@ private:
     SimulationResults *mResults = nullptr;
     SimulationImportData *mImportData = nullptr;
 
+    bool mInstrumented = false;
+    QVariantMap mStatistics;
+
     void checkIssues();
 
     void retrieveFileDetails(bool pRecreateRuntime = true);
 
     bool simulationSettingsOk(bool pEmitSignal = true);
 
+    void createWorker();
+    void startWorker();
+
     QString initializeSolver(const libsedml::SedListOfAlgorithmParameters *pSedmlAlgorithmParameters,
                              const QString &pKisaoId) const;
 
 signals:
+    void workerCreated(OpenCOR::SimulationSupport::SimulationWorker *pWorker);
+
     void running(bool pIsResuming);
     void paused();
 
+    void progress(double pProgress);
+
     void done(qint64 pElapsedTime);
 
     void error(const QString &pMessage);
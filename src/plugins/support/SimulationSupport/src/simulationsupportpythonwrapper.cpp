@@ -30,16 +30,21 @@ along with this program. If not, see <https://gnu.org/licenses>.
 #include "simulation.h"
 #include "simulationmanager.h"
 #include "simulationsupportpythonwrapper.h"
+#include "simulationworker.h"
 
 //==============================================================================
 
 #include <QApplication>
 #include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
 #include <QWidget>
 
 //==============================================================================
 
 #include <array>
+#include <climits>
 #include <memory>
 
 //==============================================================================
@@ -205,6 +210,144 @@ static PyObject * initializeSimulation(const QString &pFileName)
 
 //==============================================================================
 
+// Note: the data of a future is shared with the connections that update it,
+//       so that it remains valid for as long as our simulation or its worker
+//       may need it, i.e. even if Python releases the future before our
+//       simulation is done...
+
+struct SimulationRunFutureData
+{
+    QMutex mutex;
+    QWaitCondition doneCondition;
+
+    bool done = false;
+    qint64 elapsedTime = -1;
+    QString errorMessage;
+
+    QMetaObject::Connection workerCreatedConnection;
+    QMetaObject::Connection simulationErrorConnection;
+};
+
+//==============================================================================
+
+SimulationRunFuture::SimulationRunFuture(Simulation *pSimulation) :
+    mData(new SimulationRunFutureData())
+{
+    // Keep track of the worker that is going to be created for our simulation
+    // and of any error preventing it from being created
+    // Note #1: we only want to know about the next worker, hence we disconnect
+    //          from our simulation as soon as we know about it or about an
+    //          error...
+    // Note #2: we directly connect to our simulation's worker, so that we get
+    //          to know when it is done even if the main thread's event loop is
+    //          not running (e.g. because Python is waiting on us). Also, our
+    //          worker resets our simulation's knowledge of it before letting
+    //          us know that it is done (see SimulationWorker::run()), so our
+    //          simulation is not running anymore by the time we are done...
+
+    QSharedPointer<SimulationRunFutureData> data = mData;
+
+    data->workerCreatedConnection = connect(pSimulation, &Simulation::workerCreated, pSimulation, [data](SimulationWorker *pWorker) {
+        disconnect(data->workerCreatedConnection);
+        disconnect(data->simulationErrorConnection);
+
+        connect(pWorker, &SimulationWorker::error, pWorker, [data](const QString &pErrorMessage) {
+            QMutexLocker locker(&data->mutex);
+
+            data->errorMessage = pErrorMessage;
+        }, Qt::DirectConnection);
+        connect(pWorker, &SimulationWorker::done, pWorker, [data](qint64 pElapsedTime) {
+            QMutexLocker locker(&data->mutex);
+
+            data->done = true;
+            data->elapsedTime = pElapsedTime;
+
+            data->doneCondition.wakeAll();
+        }, Qt::DirectConnection);
+    }, Qt::DirectConnection);
+    data->simulationErrorConnection = connect(pSimulation, &Simulation::error, pSimulation, [data](const QString &pErrorMessage) {
+        disconnect(data->workerCreatedConnection);
+        disconnect(data->simulationErrorConnection);
+
+        QMutexLocker locker(&data->mutex);
+
+        data->done = true;
+        data->errorMessage = pErrorMessage;
+
+        data->doneCondition.wakeAll();
+    }, Qt::DirectConnection);
+}
+
+//==============================================================================
+
+bool SimulationRunFuture::done() const
+{
+    // Return whether our simulation is done
+
+    QMutexLocker locker(&mData->mutex);
+
+    return mData->done;
+}
+
+//==============================================================================
+
+bool SimulationRunFuture::wait(int pTimeout)
+{
+    // Wait for our simulation to be done, if needed, but without holding the
+    // GIL, so that other Python threads (and simulations) can carry on
+    // Note: a negative timeout means that we wait for as long as needed...
+
+    PyThreadState *threadState = PyEval_SaveThread();
+
+    mData->mutex.lock();
+
+    if (!mData->done) {
+        mData->doneCondition.wait(&mData->mutex, (pTimeout < 0)?
+                                                     ULONG_MAX:
+                                                     ulong(pTimeout));
+    }
+
+    bool res = mData->done;
+
+    mData->mutex.unlock();
+
+    PyEval_RestoreThread(threadState);
+
+    return res;
+}
+
+//==============================================================================
+
+bool SimulationRunFuture::result()
+{
+    // Wait for our simulation to be done and return whether it ran fine or
+    // throw any error message that has been generated
+
+    wait();
+
+    QMutexLocker locker(&mData->mutex);
+
+    if (!mData->errorMessage.isEmpty()) {
+        throw std::runtime_error(mData->errorMessage.toStdString());
+    }
+
+    return mData->elapsedTime >= 0;
+}
+
+//==============================================================================
+
+qint64 SimulationRunFuture::elapsed_time() const
+{
+    // Return the time it took to run our simulation, or -1 if it isn't done or
+    // if it failed
+
+    QMutexLocker locker(&mData->mutex);
+
+    return mData->elapsedTime;
+}
+
+//==============================================================================
+
 SimulationSupportPythonWrapper::SimulationSupportPythonWrapper(void *pModule,
                                                                QObject *pParent) :
     QObject(pParent)
@@ -215,6 +358,7 @@ SimulationSupportPythonWrapper::SimulationSupportPythonWrapper(void *pModule,
     PythonQtSupport::registerClass(&Simulation::staticMetaObject);
     PythonQtSupport::registerClass(&SimulationData::staticMetaObject);
     PythonQtSupport::registerClass(&SimulationResults::staticMetaObject);
+    PythonQtSupport::registerClass(&SimulationRunFuture::staticMetaObject);
 
     PythonQtSupport::addInstanceDecorators(this);
 
@@ -265,48 +409,64 @@ bool SimulationSupportPythonWrapper::run(Simulation *pSimulation)
     mElapsedTime = -1;
     mErrorMessage = QString();
 
-    // Try to allocate all the memory we need by adding a run to our simulation
-    // and, if successful, run our simulation
+    // Run all the iterations of our repeated task, if we have one, each in its
+    // own run, or try to allocate all the memory we need by adding a run to
+    // our simulation and, if successful, run our simulation
     // Note: we keep track of our focus widget (which might be our Python
     //       console window), so that we can give the focus back to it once we
     //       are done running our simulation...
 
     QWidget *focusWidget = QApplication::focusWidget();
+    bool hasRepeatedTask = pSimulation->hasRepeatedTask();
 
-    if (pSimulation->addRun()) {
-        // Keep track of any simulation error and of when the simulation is done
+    if (!hasRepeatedTask && !pSimulation->addRun()) {
+        throw std::runtime_error(tr("The memory required for the simulation could not be allocated.").toStdString());
+    }
 
-        connect(pSimulation, &Simulation::error,
-                this, &SimulationSupportPythonWrapper::simulationError,
-                Qt::UniqueConnection);
-        connect(pSimulation, &Simulation::done,
-                this, &SimulationSupportPythonWrapper::simulationDone,
-                Qt::UniqueConnection);
+    // Keep track of any simulation error and of when the simulation is done
 
-        // Run our simulation and wait for it to complete
-        // Note: we use a queued connection because the event is in our
-        //       thread...
+    connect(pSimulation, &Simulation::error,
+            this, &SimulationSupportPythonWrapper::simulationError,
+            Qt::UniqueConnection);
+    connect(pSimulation, &Simulation::done,
+            this, &SimulationSupportPythonWrapper::simulationDone,
+            Qt::UniqueConnection);
 
-        QEventLoop waitLoop;
-        auto connection = std::make_shared<QMetaObject::Connection>();
+    // Run our simulation and wait for it to complete
+    // Note: we use a queued connection because the event is in our thread...
 
-        *connection = connect(pSimulation, &Simulation::done, [&]() {
-            waitLoop.quit();
+    QEventLoop waitLoop;
+    auto connection = std::make_shared<QMetaObject::Connection>();
 
-            disconnect(*connection);
-        });
+    *connection = connect(pSimulation, &Simulation::done, [&]() {
+        waitLoop.quit();
 
-        pSimulation->run();
+        disconnect(*connection);
+    });
 
-        waitLoop.exec();
+    if (hasRepeatedTask) {
+        // Our repeated task may not be started, in which case we either have
+        // been told why or it is because our simulation is already running
 
-        // Throw any error message that has been generated
+        if (!pSimulation->runRepeatedTask()) {
+            disconnect(*connection);
+
+            if (mErrorMessage.isEmpty()) {
+                throw std::runtime_error(tr("The simulation is already running.").toStdString());
+            }
 
-        if (!mErrorMessage.isEmpty()) {
             throw std::runtime_error(mErrorMessage.toStdString());
         }
     } else {
-        throw std::runtime_error(tr("The memory required for the simulation could not be allocated.").toStdString());
+        pSimulation->run();
+    }
+
+    waitLoop.exec();
+
+    // Throw any error message that has been generated
+
+    if (!mErrorMessage.isEmpty()) {
+        throw std::runtime_error(mErrorMessage.toStdString());
     }
 
     // Restore the focus to the previous widget
@@ -320,6 +480,55 @@ bool SimulationSupportPythonWrapper::run(Simulation *pSimulation)
 
 //==============================================================================
 
+PyObject * SimulationSupportPythonWrapper::run_async(Simulation *pSimulation)
+{
+    // Start running the given simulation, but only if it doesn't have blocking
+    // issues, if it is valid and if it isn't already running, and return a
+    // future-like object that can be used to wait for it to be done
+    // Note: each simulation runs in its own worker thread, so several
+    //       simulations can be run concurrently this way...
+
+    if (pSimulation->hasBlockingIssues()) {
+        throw std::runtime_error(tr("The simulation has blocking issues and cannot therefore be run.").toStdString());
+    }
+
+    if (!valid(pSimulation)) {
+        throw std::runtime_error(tr("The simulation has an invalid runtime and cannot therefore be run.").toStdString());
+    }
+
+    if (pSimulation->isRunning()) {
+        throw std::runtime_error(tr("The simulation is already running.").toStdString());
+    }
+
+    bool hasRepeatedTask = pSimulation->hasRepeatedTask();
+
+    if (!hasRepeatedTask && !pSimulation->addRun()) {
+        throw std::runtime_error(tr("The memory required for the simulation could not be allocated.").toStdString());
+    }
+
+    // Create our future and run our simulation
+    // Note: our future is owned by Python, so that it gets deleted as soon as
+    //       it is not needed anymore. This is fine since the data that our
+    //       simulation's worker updates is not owned by our future (see
+    //       SimulationRunFuture::SimulationRunFuture())...
+
+    auto future = new SimulationRunFuture(pSimulation);
+
+    if (hasRepeatedTask) {
+        pSimulation->runRepeatedTask();
+    } else {
+        pSimulation->run();
+    }
+
+    PyObject *res = PythonQtSupport::wrapQObject(future);
+
+    PythonQtSupport::getInstanceWrapper(res)->passOwnershipToPython();
+
+    return res;
+}
+
+//==============================================================================
+
 void SimulationSupportPythonWrapper::reset(Simulation *pSimulation, bool pAll)
 {
     // Reset the given simulation
@@ -366,6 +575,34 @@ PyObject * SimulationSupportPythonWrapper::issues(Simulation *pSimulation) const
 
 //==============================================================================
 
+bool SimulationSupportPythonWrapper::instrumented(Simulation *pSimulation) const
+{
+    // Return whether the given simulation is instrumented
+
+    return pSimulation->isInstrumented();
+}
+
+//==============================================================================
+
+void SimulationSupportPythonWrapper::set_instrumented(Simulation *pSimulation,
+                                                      bool pInstrumented)
+{
+    // Set whether the given simulation is instrumented
+
+    pSimulation->setInstrumented(pInstrumented);
+}
+
+//==============================================================================
+
+QVariantMap SimulationSupportPythonWrapper::statistics(Simulation *pSimulation) const
+{
+    // Return the statistics of the last run of the given simulation
+
+    return pSimulation->statistics();
+}
+
+//==============================================================================
+
 double SimulationSupportPythonWrapper::starting_point(SimulationData *pSimulationData)
 {
     // Return the starting point for the given simulation data
@@ -545,6 +782,50 @@ PyObject * SimulationSupportPythonWrapper::algebraic(SimulationData *pSimulation
 
 //==============================================================================
 
+QStringList SimulationSupportPythonWrapper::sensitivity_parameters(SimulationData *pSimulationData) const
+{
+    // Return the URI of the constants with respect to which we compute the
+    // sensitivities of our states
+
+    QStringList res;
+
+    for (auto constantIndex : pSimulationData->sensitivityConstants()) {
+        res << pSimulationData->constantsValues()->uri(constantIndex);
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+void SimulationSupportPythonWrapper::set_sensitivity_parameters(SimulationData *pSimulationData,
+                                                                const QStringList &pUris)
+{
+    // Set the constants with respect to which we want to compute the
+    // sensitivities of our states, making sure that they are all "proper"
+    // constants (i.e. not computed constants) and that we are not running
+
+    QVector<int> sensitivityConstants;
+
+    for (const auto &uri : pUris) {
+        int constantIndex = pSimulationData->sensitivityConstantIndex(uri);
+
+        if (constantIndex == -1) {
+            throw std::runtime_error(tr("The requested sensitivity parameter (%1) is not a constant.").arg(uri).toStdString());
+        }
+
+        if (!sensitivityConstants.contains(constantIndex)) {
+            sensitivityConstants << constantIndex;
+        }
+    }
+
+    if (!pSimulationData->setSensitivityConstants(sensitivityConstants)) {
+        throw std::runtime_error(tr("The sensitivity parameters cannot be set while the simulation is running.").toStdString());
+    }
+}
+
+//==============================================================================
+
 DataStore::DataStore * SimulationSupportPythonWrapper::data_store(SimulationResults *pSimulationResults) const
 {
     // Return the data store for the given simulation results
@@ -599,6 +880,68 @@ PyObject * SimulationSupportPythonWrapper::algebraic(SimulationResults *pSimulat
 
 //==============================================================================
 
+PyObject * SimulationSupportPythonWrapper::sensitivities(SimulationResults *pSimulationResults,
+                                                         int pRun) const
+{
+    // Return NumPy arrays for the sensitivities of the given simulation results
+    // and run, without copying any data
+
+    return DataStore::DataStorePythonWrapper::dataStoreVariablesArraysDict(pSimulationResults->sensitivitiesVariables(),
+                                                                           QStringList(), pRun);
+}
+
+//==============================================================================
+
+QVariantList SimulationSupportPythonWrapper::events(SimulationResults *pSimulationResults,
+                                                    int pRun) const
+{
+    // Return the events (i.e. the points at which the condition of a piecewise
+    // expression changed value) of the given simulation results and run
+
+    QVariantList res;
+
+    for (auto event : pSimulationResults->events(pRun)) {
+        res << event;
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+PyObject * SimulationSupportPythonWrapper::arrays(SimulationResults *pSimulationResults,
+                                                  const QStringList &pUris,
+                                                  int pRun) const
+{
+    // Return NumPy arrays for the VOI and (given) variables of the given
+    // simulation results and run, without copying any data
+
+    if (pSimulationResults->dataStore() == nullptr) {
+        throw std::runtime_error(tr("The simulation has no results.").toStdString());
+    }
+
+    return DataStore::DataStorePythonWrapper::dataStoreVariablesArraysDict(pSimulationResults->dataStore()->voiAndVariables(),
+                                                                           pUris, pRun);
+}
+
+//==============================================================================
+
+PyObject * SimulationSupportPythonWrapper::runs_arrays(SimulationResults *pSimulationResults,
+                                                       const QStringList &pUris) const
+{
+    // Return lists of NumPy arrays (one per run) for the VOI and (given)
+    // variables of the given simulation results, without copying any data
+
+    if (pSimulationResults->dataStore() == nullptr) {
+        throw std::runtime_error(tr("The simulation has no results.").toStdString());
+    }
+
+    return DataStore::DataStorePythonWrapper::dataStoreVariablesRunsArraysDict(pSimulationResults->dataStore()->voiAndVariables(),
+                                                                               pUris);
+}
+
+//==============================================================================
+
 void SimulationSupportPythonWrapper::set_value(DataStore::DataStoreValue *pDataStoreValue,
                                                double pValue)
 {
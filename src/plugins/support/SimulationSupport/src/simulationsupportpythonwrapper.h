@@ -26,6 +26,8 @@ along with this program. If not, see <https://gnu.org/licenses>.
 //==============================================================================
 
 #include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
 
 //==============================================================================
 
@@ -54,6 +56,30 @@ namespace SimulationSupport {
 class Simulation;
 class SimulationData;
 class SimulationResults;
+class SimulationWorker;
+
+//==============================================================================
+
+struct SimulationRunFutureData;
+
+class SimulationRunFuture : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SimulationRunFuture(Simulation *pSimulation);
+
+private:
+    QSharedPointer<SimulationRunFutureData> mData;
+
+public slots:
+    bool done() const;
+    bool wait(int pTimeout = -1);
+
+    bool result();
+
+    qint64 elapsed_time() const;
+};
 
 //==============================================================================
 
@@ -72,6 +98,7 @@ public slots:
     bool valid(OpenCOR::SimulationSupport::Simulation *pSimulation);
 
     bool run(OpenCOR::SimulationSupport::Simulation *pSimulation);
+    PyObject * run_async(OpenCOR::SimulationSupport::Simulation *pSimulation);
 
     void reset(OpenCOR::SimulationSupport::Simulation *pSimulation,
                bool pAll = true);
@@ -79,6 +106,12 @@ public slots:
 
     PyObject * issues(OpenCOR::SimulationSupport::Simulation *pSimulation) const;
 
+    bool instrumented(OpenCOR::SimulationSupport::Simulation *pSimulation) const;
+    void set_instrumented(OpenCOR::SimulationSupport::Simulation *pSimulation,
+                          bool pInstrumented);
+
+    QVariantMap statistics(OpenCOR::SimulationSupport::Simulation *pSimulation) const;
+
     double starting_point(OpenCOR::SimulationSupport::SimulationData *pSimulationData);
     void set_starting_point(OpenCOR::SimulationSupport::SimulationData *pSimulationData,
                             double pStartingPoint);
@@ -114,6 +147,10 @@ public slots:
     PyObject * states(OpenCOR::SimulationSupport::SimulationData *pSimulationData) const;
     PyObject * algebraic(OpenCOR::SimulationSupport::SimulationData *pSimulationData) const;
 
+    QStringList sensitivity_parameters(OpenCOR::SimulationSupport::SimulationData *pSimulationData) const;
+    void set_sensitivity_parameters(OpenCOR::SimulationSupport::SimulationData *pSimulationData,
+                                    const QStringList &pUris);
+
     OpenCOR::DataStore::DataStore * data_store(OpenCOR::SimulationSupport::SimulationResults *pSimulationResults) const;
 
     OpenCOR::DataStore::DataStoreVariable * voi(OpenCOR::SimulationSupport::SimulationResults *pSimulationResults) const;
@@ -123,6 +160,18 @@ public slots:
     PyObject * rates(OpenCOR::SimulationSupport::SimulationResults *pSimulationResults) const;
     PyObject * algebraic(OpenCOR::SimulationSupport::SimulationResults *pSimulationResults) const;
 
+    PyObject * sensitivities(OpenCOR::SimulationSupport::SimulationResults *pSimulationResults,
+                             int pRun = -1) const;
+
+    QVariantList events(OpenCOR::SimulationSupport::SimulationResults *pSimulationResults,
+                        int pRun = -1) const;
+
+    PyObject * arrays(OpenCOR::SimulationSupport::SimulationResults *pSimulationResults,
+                      const QStringList &pUris = QStringList(),
+                      int pRun = -1) const;
+    PyObject * runs_arrays(OpenCOR::SimulationSupport::SimulationResults *pSimulationResults,
+                           const QStringList &pUris = QStringList()) const;
+
     void set_value(OpenCOR::DataStore::DataStoreValue *pDataStoreValue,
                    double pValue);
 
@@ -25,12 +25,14 @@ along with this program. If not, see <https://gnu.org/licenses>.
 #include "corecliutils.h"
 #include "simulation.h"
 #include "simulationworker.h"
+#include "tracer.h"
 
 //==============================================================================
 
 #include <QElapsedTimer>
 #include <QMutex>
 #include <QThread>
+#include <QThreadPool>
 
 //==============================================================================
 
@@ -81,6 +83,18 @@ double SimulationWorker::currentPoint() const
 
 void SimulationWorker::run()
 {
+    // Trace ourselves
+
+    Core::TraceEvent traceEvent("SimulationWorker::run");
+
+    // Run our repeated task instead, if we have one
+
+    if (!mIterationsChanges.isEmpty()) {
+        runRepeatedTask();
+
+        return;
+    }
+
     // Let people know that we are running
 
     emit running(false);
@@ -90,13 +104,16 @@ void SimulationWorker::run()
     auto odeSolver = static_cast<Solver::OdeSolver *>(mSimulation->data()->odeSolverInterface()->solverInstance());
 
     // Set up our NLA solver, if needed
+    // Note: our ODE solver may solve our NLA systems as part of its own
+    //       iteration, in which case we must use the NLA solver it gives us
+    //       (and which relies on our NLA solver whenever needed)...
 
     Solver::NlaSolver *nlaSolver = nullptr;
 
     if (mRuntime->needNlaSolver()) {
         nlaSolver = static_cast<Solver::NlaSolver *>(mSimulation->data()->nlaSolverInterface()->solverInstance());
 
-        Solver::setNlaSolver(mRuntime, nlaSolver);
+        CellMLSupport::CellmlFileRuntime::setNlaSolver(odeSolver->nlaSolver(nlaSolver));
     }
 
     // Keep track of any error that might be reported by any of our solvers
@@ -121,21 +138,54 @@ void SimulationWorker::run()
 
     mCurrentPoint = startingPoint;
 
-    // Initialise our ODE solver
+    // Initialise our NLA solver, if any
+
+    if (nlaSolver != nullptr) {
+        nlaSolver->setProperties(mSimulation->data()->nlaSolverProperties());
+    }
+
+    // Initialise our ODE solver, after having asked it to compute the
+    // sensitivities of our states with respect to some constants and to locate
+    // the roots of our model (i.e. where the condition of one of its piecewise
+    // expressions changes value), if needed, and after having told it how many
+    // algebraic variables our model has and what our ending point is
+    // Note: the initial value of our sensitivities depends on our current
+    //       constants and states, so we reset them now, i.e. while our NLA
+    //       solver (if any) is set...
 
     odeSolver->setProperties(mSimulation->data()->odeSolverProperties());
 
-    odeSolver->initialize(mCurrentPoint, mRuntime->statesCount(),
-                          mSimulation->data()->constants(),
-                          mSimulation->data()->rates(),
-                          mSimulation->data()->states(),
-                          mSimulation->data()->algebraic(),
-                          mRuntime->computeRates());
+    QVector<int> sensitivityConstants = mSimulation->data()->sensitivityConstants();
 
-    // Initialise our NLA solver, if any
+    if (!sensitivityConstants.isEmpty()) {
+        if (odeSolver->supportsSensitivities()) {
+            mSimulation->data()->resetSensitivities(mCurrentPoint);
 
-    if (nlaSolver != nullptr) {
-        nlaSolver->setProperties(mSimulation->data()->nlaSolverProperties());
+            odeSolver->setSensitivities(sensitivityConstants,
+                                        mRuntime->constantsCount(),
+                                        mSimulation->data()->sensitivities(),
+                                        mRuntime->computeComputedConstants());
+        } else {
+            emitError(tr("the %1 solver cannot compute sensitivities").arg(mSimulation->data()->odeSolverName()));
+        }
+    }
+
+    if (mRuntime->rootsCount() != 0) {
+        odeSolver->setRoots(mRuntime->rootsCount(), mRuntime->computeRoots());
+    }
+
+    odeSolver->setAlgebraicCount(mRuntime->algebraicCount());
+    odeSolver->setEndingPoint(endingPoint);
+
+    {
+        Core::TraceEvent odeSolverTraceEvent("OdeSolver::initialize");
+
+        odeSolver->initialize(mCurrentPoint, mRuntime->statesCount(),
+                              mSimulation->data()->constants(),
+                              mSimulation->data()->rates(),
+                              mSimulation->data()->states(),
+                              mSimulation->data()->algebraic(),
+                              mRuntime->computeRates());
     }
 
     // Now, we are ready to compute our model, but only if no error has occurred
@@ -143,18 +193,34 @@ void SimulationWorker::run()
     // Note: we use -1 as a way to indicate that something went wrong...
 
     qint64 elapsedTime = 0;
+    quint64 pointsCount = 0;
+
+    bool instrumented = mSimulation->isInstrumented();
+    qint64 solverTime = 0;
+    qint64 addPointTime = 0;
 
     if (!mError) {
         // Start our timer
 
         QElapsedTimer timer;
+        QElapsedTimer instrumentationTimer;
 
         timer.start();
 
-        // Add our first point
+        // Add our first point, after having computed our rates since our ODE
+        // solver only guarantees that they are up to date once it has solved
+        // our model
+
+        mRuntime->computeRates()(mCurrentPoint,
+                                 mSimulation->data()->constants(),
+                                 mSimulation->data()->rates(),
+                                 mSimulation->data()->states(),
+                                 mSimulation->data()->algebraic());
 
         mSimulation->results()->addPoint(mCurrentPoint);
 
+        ++pointsCount;
+
         // Our main work loop
         // Note: for performance reasons, it is essential that the following
         //       loop doesn't emit any signal, be it directly or indirectly,
@@ -165,23 +231,32 @@ void SimulationWorker::run()
         QMutex pausedMutex;
 
         forever {
-            // Reinitialise our solver, if we have an NLA solver or if the model
-            // got reset
+            // Reinitialise our solver, if the model got reset
             // Note: indeed, with a solver such as CVODE, we need to update our
             //       internals...
 
-            if ((nlaSolver != nullptr) || mReset) {
+            if (mReset) {
                 odeSolver->reinitialize(mCurrentPoint);
 
                 mReset = false;
             }
 
             // Determine our next point and compute our model up to it
+            // Note: if we are instrumented, then we time how long it takes to
+            //       compute our model and to add our new point...
+
+            if (instrumented) {
+                instrumentationTimer.start();
+            }
 
             odeSolver->solve(mCurrentPoint,
                              qMin(endingPoint,
                                   startingPoint+double(++pointCounter)*pointInterval));
 
+            if (instrumented) {
+                solverTime += instrumentationTimer.nsecsElapsed();
+            }
+
             // Make sure that no error occurred
 
             if (mError) {
@@ -190,8 +265,18 @@ void SimulationWorker::run()
 
             // Add our new point
 
+            if (instrumented) {
+                instrumentationTimer.start();
+            }
+
             mSimulation->results()->addPoint(mCurrentPoint);
 
+            if (instrumented) {
+                addPointTime += instrumentationTimer.nsecsElapsed();
+            }
+
+            ++pointsCount;
+
             // Some post-processing, if needed
 
             if (qFuzzyCompare(mCurrentPoint, endingPoint) || mStopped) {
@@ -245,12 +330,54 @@ void SimulationWorker::run()
         }
     }
 
+    // Keep track of the events located by our ODE solver, if any
+
+    mSimulation->results()->addEvents(odeSolver->events());
+
+    // Keep track of our statistics, before deleting our solver(s)
+
+    QVariantMap statistics;
+    Solver::Solver::Statistics odeSolverStatistics = odeSolver->statistics();
+    Solver::Solver::Statistics nlaSolverStatistics = (nlaSolver != nullptr)?
+                                                         nlaSolver->statistics():
+                                                         Solver::Solver::Statistics();
+
+    for (auto statistic = odeSolverStatistics.constBegin(),
+              statisticEnd = odeSolverStatistics.constEnd();
+         statistic != statisticEnd; ++statistic) {
+        statistics.insert(statistic.key(), statistic.value());
+    }
+
+    for (auto statistic = nlaSolverStatistics.constBegin(),
+              statisticEnd = nlaSolverStatistics.constEnd();
+         statistic != statisticEnd; ++statistic) {
+        statistics.insert(statistic.key(), statistic.value());
+    }
+
+    quint64 stepsCount = odeSolverStatistics.value(Solver::StepsStatistic);
+
+    if ((nlaSolver != nullptr) && (stepsCount != 0)) {
+        statistics.insert(NlaSolvesPerStepStatistic,
+                          double(nlaSolverStatistics.value(Solver::NlaSolvesStatistic))/stepsCount);
+    }
+
+    statistics.insert(PointsStatistic, pointsCount);
+
+    if (instrumented) {
+        statistics.insert(SolverTimeStatistic, 1.0e-6*solverTime);
+        statistics.insert(AddPointTimeStatistic, 1.0e-6*addPointTime);
+    }
+
+    mSimulation->setStatistics(statistics);
+
     // Delete our solver(s)
 
     delete odeSolver;
 
     if (nlaSolver != nullptr) {
         delete nlaSolver;
+
+        CellMLSupport::CellmlFileRuntime::setNlaSolver(nullptr);
     }
 
     // Reset our simulation owner's knowledge of us
@@ -267,6 +394,110 @@ void SimulationWorker::run()
 
 //==============================================================================
 
+void SimulationWorker::runRepeatedTask()
+{
+    // Let people know that we are running
+
+    emit running(false);
+
+    // Run the iterations of our repeated task using a thread pool, each
+    // iteration in its own run
+
+    mStopped = false;
+    mError = false;
+
+    mRepeatedTaskIterationsDone = 0;
+
+    QThreadPool threadPool;
+    QList<SimulationRepeatedTaskWorker *> workers;
+    int iterationsCount = mIterationsChanges.count();
+
+    QElapsedTimer timer;
+    qint64 elapsedTime = 0;
+
+    timer.start();
+
+    for (int i = 0; i < iterationsCount; ++i) {
+        auto worker = new SimulationRepeatedTaskWorker(mSimulation, this,
+                                                       mIterationsChanges[i],
+                                                       mFirstRun+i);
+
+        workers << worker;
+
+        threadPool.start(worker);
+    }
+
+    // Wait for our iterations to be done, letting people know about our
+    // progress every now and then, and pausing ourselves, if needed
+    // Note: our iterations pause themselves while we are paused (see
+    //       canContinueRepeatedTask())...
+
+    static const int ProgressInterval = 100;
+
+    QMutex pausedMutex;
+
+    while (!threadPool.waitForDone(ProgressInterval)) {
+        emit progress(double(mRepeatedTaskIterationsDone.load())/iterationsCount);
+
+        if (mPaused) {
+            // We should be paused, so stop our timer, let people know that we
+            // are paused and actually pause ourselves
+
+            elapsedTime += timer.elapsed();
+
+            emit paused();
+
+            pausedMutex.lock();
+                mPausedCondition.wait(&pausedMutex);
+            pausedMutex.unlock();
+
+            // We are not paused anymore, so let our iterations know about it
+
+            mRepeatedTaskMutex.lock();
+                mPaused = false;
+
+                mRepeatedTaskCondition.wakeAll();
+            mRepeatedTaskMutex.unlock();
+
+            // Let people know that we are running again and (re)start our
+            // timer
+
+            emit running(true);
+
+            timer.start();
+        }
+    }
+
+    elapsedTime += timer.elapsed();
+
+    emit progress(double(mRepeatedTaskIterationsDone.load())/iterationsCount);
+
+    // Keep track of the events located by our iterations, report the first
+    // error, if any, that occurred and clean up after ourselves
+    // Note: we keep track of the events of our iterations here rather than in
+    //       our iterations since our simulation results expect to be updated
+    //       from only one thread...
+
+    for (auto worker : workers) {
+        mSimulation->results()->addEvents(worker->events(), worker->runIndex());
+
+        if (!worker->errorMessage().isEmpty()) {
+            emitError(worker->errorMessage());
+        }
+
+        delete worker;
+    }
+
+    // Reset our simulation owner's knowledge of us (see run()) and let people
+    // know that we are done and give them the elapsed time
+
+    mSelf = nullptr;
+
+    emit done(mError?-1:elapsedTime);
+}
+
+//==============================================================================
+
 void SimulationWorker::pause()
 {
     // Pause ourselves, if we are currently running
@@ -315,6 +546,46 @@ void SimulationWorker::reset()
 
 //==============================================================================
 
+void SimulationWorker::setRepeatedTask(const QList<SimulationRepeatedTaskChanges> &pIterationsChanges,
+                                       int pFirstRun)
+{
+    // Keep track of the changes to be made for each iteration of our repeated
+    // task and of the run in which its first iteration is to be stored
+
+    mIterationsChanges = pIterationsChanges;
+    mFirstRun = pFirstRun;
+}
+
+//==============================================================================
+
+bool SimulationWorker::canContinueRepeatedTask()
+{
+    // Wait for as long as we are paused and then let the caller, i.e. one of
+    // the iterations of our repeated task, know whether it can continue, i.e.
+    // whether we have not been asked to stop
+
+    if (mPaused) {
+        QMutexLocker locker(&mRepeatedTaskMutex);
+
+        while (mPaused && !mStopped) {
+            mRepeatedTaskCondition.wait(&mRepeatedTaskMutex);
+        }
+    }
+
+    return !mStopped;
+}
+
+//==============================================================================
+
+void SimulationWorker::repeatedTaskIterationDone()
+{
+    // One of the iterations of our repeated task is done
+
+    mRepeatedTaskIterationsDone.ref();
+}
+
+//==============================================================================
+
 void SimulationWorker::emitError(const QString &pMessage)
 {
     // A solver error occurred, so keep track of it and let people know about
@@ -329,6 +600,268 @@ void SimulationWorker::emitError(const QString &pMessage)
 
 //==============================================================================
 
+SimulationRepeatedTaskWorker::SimulationRepeatedTaskWorker(Simulation *pSimulation,
+                                                           SimulationWorker *pOwner,
+                                                           const SimulationRepeatedTaskChanges &pChanges,
+                                                           int pRun) :
+    mSimulation(pSimulation),
+    mOwner(pOwner),
+    mRuntime(pSimulation->runtime()),
+    mChanges(pChanges),
+    mRun(pRun)
+{
+    // We don't want to be deleted by our thread pool since our owner needs to
+    // retrieve our events and error message, if any
+
+    setAutoDelete(false);
+
+    // Allocate our own model data, so that we can run several iterations of a
+    // repeated task in parallel
+    // Note: our runtime only contains pure functions, so it can be shared
+    //       between iterations...
+
+    mConstants = QVector<double>(mRuntime->constantsCount());
+    mRates = QVector<double>(mRuntime->ratesCount());
+    mStates = QVector<double>(mRuntime->statesCount());
+    mAlgebraic = QVector<double>(mRuntime->algebraicCount());
+    mSensitivities = QVector<double>(pSimulation->data()->sensitivityConstants().count()*mRuntime->statesCount());
+
+    // Keep track of the variables to which we need to add our results
+
+    SimulationResults *results = pSimulation->results();
+
+    mPointsVariable = results->pointsVariable();
+
+    mConstantsVariables = results->constantsVariables();
+    mRatesVariables = results->ratesVariables();
+    mStatesVariables = results->statesVariables();
+    mAlgebraicVariables = results->algebraicVariables();
+    mSensitivitiesVariables = results->sensitivitiesVariables();
+}
+
+//==============================================================================
+
+void SimulationRepeatedTaskWorker::applyChanges(bool pStatesOnly)
+{
+    // Apply our changes, or only those that are about states
+
+    for (const auto &change : mChanges) {
+        CellMLSupport::CellmlFileRuntimeParameter *parameter = change.first;
+
+        if (parameter->type() == CellMLSupport::CellmlFileRuntimeParameter::Type::State) {
+            mStates[parameter->index()] = change.second;
+        } else if (!pStatesOnly) {
+            mConstants[parameter->index()] = change.second;
+        }
+    }
+}
+
+//==============================================================================
+
+void SimulationRepeatedTaskWorker::addPoint(double pPoint)
+{
+    // Make sure that all our variables are up to date and add them to our run
+    // Note: our rates are up to date (see run())...
+
+    mRuntime->computeVariables()(pPoint, mConstants.data(), mRates.data(), mStates.data(), mAlgebraic.data());
+
+    mPointsVariable->addValue(pPoint, mRun);
+
+    for (int i = 0, iMax = mConstantsVariables.count(); i < iMax; ++i) {
+        mConstantsVariables[i]->addValue(mConstants[i], mRun);
+    }
+
+    for (int i = 0, iMax = mRatesVariables.count(); i < iMax; ++i) {
+        mRatesVariables[i]->addValue(mRates[i], mRun);
+    }
+
+    for (int i = 0, iMax = mStatesVariables.count(); i < iMax; ++i) {
+        mStatesVariables[i]->addValue(mStates[i], mRun);
+    }
+
+    for (int i = 0, iMax = mAlgebraicVariables.count(); i < iMax; ++i) {
+        mAlgebraicVariables[i]->addValue(mAlgebraic[i], mRun);
+    }
+
+    for (int i = 0, iMax = mSensitivitiesVariables.count(); i < iMax; ++i) {
+        mSensitivitiesVariables[i]->addValue(mSensitivities[i], mRun);
+    }
+
+    // Add the values of our imported data, if any, at the given point
+
+    mSimulation->results()->addData(pPoint, mRun);
+}
+
+//==============================================================================
+
+void SimulationRepeatedTaskWorker::run()
+{
+    // Set up our ODE solver and our NLA solver, if needed
+    // Note #1: our NLA solver is specific to our thread, so several iterations
+    //          can be run in parallel even if an NLA solver is needed...
+    // Note #2: like in SimulationWorker::run(), we must use the NLA solver that
+    //          our ODE solver gives us...
+
+    SimulationData *data = mSimulation->data();
+    auto odeSolver = static_cast<Solver::OdeSolver *>(data->odeSolverInterface()->solverInstance());
+    Solver::NlaSolver *nlaSolver = nullptr;
+
+    if (mRuntime->needNlaSolver()) {
+        nlaSolver = static_cast<Solver::NlaSolver *>(data->nlaSolverInterface()->solverInstance());
+
+        CellMLSupport::CellmlFileRuntime::setNlaSolver(odeSolver->nlaSolver(nlaSolver));
+    }
+
+    // Keep track of any error that might be reported by any of our solvers
+
+    auto errorHandler = [this](const QString &pMessage) {
+        if (mErrorMessage.isEmpty()) {
+            mErrorMessage = pMessage;
+        }
+    };
+
+    QObject::connect(odeSolver, &Solver::OdeSolver::error, errorHandler);
+
+    if (nlaSolver != nullptr) {
+        QObject::connect(nlaSolver, &Solver::NlaSolver::error, errorHandler);
+
+        nlaSolver->setProperties(data->nlaSolverProperties());
+    }
+
+    // Retrieve our simulation properties
+
+    double startingPoint = data->startingPoint();
+    double endingPoint = data->endingPoint();
+    double pointInterval = data->pointInterval();
+    quint64 pointCounter = 0;
+    double currentPoint = startingPoint;
+
+    // Initialise our model data, like SimulationData::reset() does, so that
+    // each iteration starts from our model's initial values rather than from
+    // wherever our simulation currently is, apply our changes and recompute
+    // our 'computed constants'
+    // Note: we reapply our changes to our states since computing our 'computed
+    //       constants' may have overwritten some of them...
+
+    mRuntime->initializeConstants()(mConstants.data(), mRates.data(), mStates.data());
+
+    applyChanges();
+
+    mRuntime->computeComputedConstants()(currentPoint, mConstants.data(), mRates.data(), mStates.data(), mAlgebraic.data());
+
+    applyChanges(true);
+
+    // Initialise our ODE solver, after having asked it to compute the
+    // sensitivities of our states and to locate the roots of our model, if
+    // needed (see SimulationWorker::run())
+
+    odeSolver->setProperties(data->odeSolverProperties());
+
+    QVector<int> sensitivityConstants = data->sensitivityConstants();
+
+    if (!sensitivityConstants.isEmpty()) {
+        if (odeSolver->supportsSensitivities()) {
+            data->resetSensitivities(currentPoint, mConstants.data(),
+                                     mRates.data(), mStates.data(),
+                                     mAlgebraic.data(), mSensitivities.data());
+
+            odeSolver->setSensitivities(sensitivityConstants,
+                                        mRuntime->constantsCount(),
+                                        mSensitivities.data(),
+                                        mRuntime->computeComputedConstants());
+        } else {
+            errorHandler(SimulationWorker::tr("the %1 solver cannot compute sensitivities").arg(data->odeSolverName()));
+        }
+    }
+
+    if (mRuntime->rootsCount() != 0) {
+        odeSolver->setRoots(mRuntime->rootsCount(), mRuntime->computeRoots());
+    }
+
+    odeSolver->setAlgebraicCount(mRuntime->algebraicCount());
+    odeSolver->setEndingPoint(endingPoint);
+
+    odeSolver->initialize(currentPoint, mRuntime->statesCount(),
+                          mConstants.data(), mRates.data(), mStates.data(),
+                          mAlgebraic.data(), mRuntime->computeRates());
+
+    // Compute our model, if no error has occurred so far
+
+    if (mErrorMessage.isEmpty()) {
+        // Add our first point, after having computed our rates (see
+        // SimulationWorker::run()), and then our other points
+        // Note: we stop early if our owner has been asked to stop and we pause
+        //       ourselves while our owner is paused (see
+        //       SimulationWorker::canContinueRepeatedTask())...
+
+        mRuntime->computeRates()(currentPoint, mConstants.data(), mRates.data(), mStates.data(), mAlgebraic.data());
+
+        addPoint(currentPoint);
+
+        forever {
+            odeSolver->solve(currentPoint,
+                             qMin(endingPoint,
+                                  startingPoint+double(++pointCounter)*pointInterval));
+
+            if (!mErrorMessage.isEmpty()) {
+                break;
+            }
+
+            addPoint(currentPoint);
+
+            if (   qFuzzyCompare(currentPoint, endingPoint)
+                || !mOwner->canContinueRepeatedTask()) {
+                break;
+            }
+        }
+    }
+
+    // Keep track of the events located by our ODE solver, if any
+
+    mEvents = odeSolver->events();
+
+    // Delete our solver(s)
+
+    delete odeSolver;
+    delete nlaSolver;
+
+    CellMLSupport::CellmlFileRuntime::setNlaSolver(nullptr);
+
+    // Let our owner know that we are done
+
+    mOwner->repeatedTaskIterationDone();
+}
+
+//==============================================================================
+
+int SimulationRepeatedTaskWorker::runIndex() const
+{
+    // Return the index of our run
+
+    return mRun;
+}
+
+
+//==============================================================================
+
+QVector<double> SimulationRepeatedTaskWorker::events() const
+{
+    // Return our events
+
+    return mEvents;
+}
+
+//==============================================================================
+
+QString SimulationRepeatedTaskWorker::errorMessage() const
+{
+    // Return our error message
+
+    return mErrorMessage;
+}
+
+//==============================================================================
+
 } // namespace SimulationSupport
 } // namespace OpenCOR
 
@@ -25,7 +25,12 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QAtomicInt>
+#include <QMutex>
 #include <QObject>
+#include <QPair>
+#include <QRunnable>
+#include <QVector>
 #include <QWaitCondition>
 
 //==============================================================================
@@ -36,10 +41,17 @@ namespace OpenCOR {
 
 namespace CellMLSupport {
     class CellmlFileRuntime;
+    class CellmlFileRuntimeParameter;
 } // namespace CellMLSupport
 
 //==============================================================================
 
+namespace DataStore {
+    class DataStoreVariable;
+} // namespace DataStore
+
+//==============================================================================
+
 namespace SimulationSupport {
 
 //==============================================================================
@@ -48,6 +60,10 @@ class Simulation;
 
 //==============================================================================
 
+using SimulationRepeatedTaskChanges = QList<QPair<CellMLSupport::CellmlFileRuntimeParameter *, double>>;
+
+//==============================================================================
+
 class SimulationWorker : public QObject
 {
     Q_OBJECT
@@ -67,6 +83,12 @@ public:
 
     void reset();
 
+    void setRepeatedTask(const QList<SimulationRepeatedTaskChanges> &pIterationsChanges,
+                         int pFirstRun);
+
+    bool canContinueRepeatedTask();
+    void repeatedTaskIterationDone();
+
 private:
     Simulation *mSimulation;
 
@@ -85,12 +107,23 @@ private:
 
     bool mError = false;
 
+    QList<SimulationRepeatedTaskChanges> mIterationsChanges;
+    int mFirstRun = -1;
+
+    QMutex mRepeatedTaskMutex;
+    QWaitCondition mRepeatedTaskCondition;
+    QAtomicInt mRepeatedTaskIterationsDone;
+
     SimulationWorker *&mSelf;
 
+    void runRepeatedTask();
+
 signals:
     void running(bool pIsResuming);
     void paused();
 
+    void progress(double pProgress);
+
     void done(qint64 pElapsedTime);
 
     void error(const QString &pMessage);
@@ -104,6 +137,55 @@ private slots:
 
 //==============================================================================
 
+class SimulationRepeatedTaskWorker : public QRunnable
+{
+public:
+    explicit SimulationRepeatedTaskWorker(Simulation *pSimulation,
+                                          SimulationWorker *pOwner,
+                                          const SimulationRepeatedTaskChanges &pChanges,
+                                          int pRun);
+
+    void run() override;
+
+    int runIndex() const;
+
+    QVector<double> events() const;
+    QString errorMessage() const;
+
+private:
+    Simulation *mSimulation;
+    SimulationWorker *mOwner;
+
+    CellMLSupport::CellmlFileRuntime *mRuntime;
+
+    SimulationRepeatedTaskChanges mChanges;
+
+    int mRun;
+
+    QVector<double> mConstants;
+    QVector<double> mRates;
+    QVector<double> mStates;
+    QVector<double> mAlgebraic;
+    QVector<double> mSensitivities;
+
+    DataStore::DataStoreVariable *mPointsVariable;
+
+    QList<DataStore::DataStoreVariable *> mConstantsVariables;
+    QList<DataStore::DataStoreVariable *> mRatesVariables;
+    QList<DataStore::DataStoreVariable *> mStatesVariables;
+    QList<DataStore::DataStoreVariable *> mAlgebraicVariables;
+    QList<DataStore::DataStoreVariable *> mSensitivitiesVariables;
+
+    QVector<double> mEvents;
+    QString mErrorMessage;
+
+    void applyChanges(bool pStatesOnly = false);
+
+    void addPoint(double pPoint);
+};
+
+//==============================================================================
+
 } // namespace SimulationSupport
 } // namespace OpenCOR
 
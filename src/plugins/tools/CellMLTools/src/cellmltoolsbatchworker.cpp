@@ -0,0 +1,178 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+//==============================================================================
+// CellML tools batch worker
+//==============================================================================
+
+#include "cellmlfile.h"
+#include "cellmltoolsbatchworker.h"
+#include "corecliutils.h"
+
+//==============================================================================
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutexLocker>
+
+//==============================================================================
+
+#include <iostream>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace CellMLTools {
+
+//==============================================================================
+
+static const auto Cellml10Export = QStringLiteral("cellml_1_0");
+
+//==============================================================================
+
+CellmlToolsBatchWorker::CellmlToolsBatchWorker(Task pTask,
+                                               const QString &pFileName,
+                                               const QString &pFormatOrFileName,
+                                               QMutex *pOutputMutex,
+                                               bool *pSuccess) :
+    mTask(pTask),
+    mFileName(pFileName),
+    mFormatOrFileName(pFormatOrFileName),
+    mOutputMutex(pOutputMutex),
+    mSuccess(pSuccess)
+{
+}
+
+//==============================================================================
+
+void CellmlToolsBatchWorker::run()
+{
+    // Export or validate our file and output the result as a single line of
+    // JSON
+    // Note: we don't manage our file (unlike CellMLToolsPlugin::runCommand())
+    //       since the file manager is not thread safe. This means that we only
+    //       support local files, but it also means that our CellmlFile object
+    //       and its CellML API model are only ever accessed from our thread...
+
+    QElapsedTimer timer;
+    QJsonObject result;
+    bool success = false;
+
+    timer.start();
+
+    result.insert("file", mFileName);
+
+    if (!QFile::exists(mFileName)) {
+        result.insert("message", "The file could not be found.");
+    } else if (mTask == Task::Export) {
+        success = exportFile(result);
+    } else {
+        success = validateFile(result);
+    }
+
+    result.insert("success", success);
+    result.insert("time", timer.elapsed());
+
+    QMutexLocker outputLocker(mOutputMutex);
+
+    std::cout << QJsonDocument(result).toJson(QJsonDocument::Compact).toStdString() << std::endl;
+
+    if (!success) {
+        *mSuccess = false;
+    }
+}
+
+//==============================================================================
+
+bool CellmlToolsBatchWorker::exportFile(QJsonObject &pResult)
+{
+    // Export our file to the requested format, next to our file
+
+    CellMLSupport::CellmlFile cellmlFile(mFileName);
+
+    if (!cellmlFile.load()) {
+        pResult.insert("message", "The file could not be loaded.");
+
+        return false;
+    }
+
+    bool isCellml10Format = mFormatOrFileName == Cellml10Export;
+
+    if (   isCellml10Format
+        && (cellmlFile.version() != CellMLSupport::CellmlFile::Version::Cellml_1_1)) {
+        pResult.insert("message", "The file must be a CellML 1.1 file.");
+
+        return false;
+    }
+
+    QString outputFileName = mFileName+"."+(isCellml10Format?
+                                                Cellml10Export:
+                                                QFileInfo(mFormatOrFileName).completeBaseName().toLower());
+
+    if (   (isCellml10Format && !cellmlFile.exportTo(outputFileName, CellMLSupport::CellmlFile::Version::Cellml_1_0))
+        || (!isCellml10Format && !cellmlFile.exportTo(outputFileName, mFormatOrFileName))) {
+        pResult.insert("message", cellmlFile.issues().isEmpty()?
+                                      QString("The file could not be exported."):
+                                      QString("The file could not be exported (%1).").arg(cellmlFile.issues().first().message()));
+
+        return false;
+    }
+
+    pResult.insert("output", outputFileName);
+
+    return true;
+}
+
+//==============================================================================
+
+bool CellmlToolsBatchWorker::validateFile(QJsonObject &pResult)
+{
+    // Validate our file and keep track of all its errors and warnings
+
+    CellMLSupport::CellmlFile cellmlFile(mFileName);
+    bool res = cellmlFile.isValid();
+    QJsonArray issues;
+
+    for (const auto &cellmlFileIssue : cellmlFile.issues()) {
+        QJsonObject issue;
+
+        issue.insert("type", (cellmlFileIssue.type() == CellMLSupport::CellmlFileIssue::Type::Error)?"error":"warning");
+        issue.insert("line", cellmlFileIssue.line());
+        issue.insert("column", cellmlFileIssue.column());
+        issue.insert("message", Core::plainString(cellmlFileIssue.formattedMessage()));
+
+        issues << issue;
+    }
+
+    pResult.insert("issues", issues);
+
+    return res;
+}
+
+//==============================================================================
+
+} // namespace CellMLTools
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,77 @@
+/*******************************************************************************
+
+Copyright (C) The University of Auckland
+
+OpenCOR is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenCOR is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://gnu.org/licenses>.
+
+*******************************************************************************/
+
+//==============================================================================
+// CellML tools batch worker
+//==============================================================================
+
+#pragma once
+
+//==============================================================================
+
+#include <QJsonObject>
+#include <QRunnable>
+#include <QString>
+
+//==============================================================================
+
+class QMutex;
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace CellMLTools {
+
+//==============================================================================
+
+class CellmlToolsBatchWorker : public QRunnable
+{
+public:
+    enum class Task {
+        Export,
+        Validate
+    };
+
+    explicit CellmlToolsBatchWorker(Task pTask, const QString &pFileName,
+                                    const QString &pFormatOrFileName,
+                                    QMutex *pOutputMutex, bool *pSuccess);
+
+    void run() override;
+
+private:
+    Task mTask;
+
+    QString mFileName;
+    QString mFormatOrFileName;
+
+    QMutex *mOutputMutex;
+    bool *mSuccess;
+
+    bool exportFile(QJsonObject &pResult);
+    bool validateFile(QJsonObject &pResult);
+};
+
+//==============================================================================
+
+} // namespace CellMLTools
+} // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
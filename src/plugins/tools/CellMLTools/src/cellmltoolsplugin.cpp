@@ -23,6 +23,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 #include "cellmlfilemanager.h"
 #include "cellmlinterface.h"
+#include "cellmltoolsbatchworker.h"
 #include "cellmltoolsplugin.h"
 #include "corecliutils.h"
 #include "coreguiutils.h"
@@ -32,9 +33,14 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 #include <QApplication>
 #include <QDir>
+#include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
 #include <QMainWindow>
 #include <QMenu>
+#include <QMutex>
+#include <QRegularExpression>
+#include <QThreadPool>
 
 //==============================================================================
 
@@ -70,9 +76,11 @@ bool CellMLToolsPlugin::executeCommand(const QString &pCommand,
 
     // Run the given CLI command
 
-    static const QString Help     = "help";
-    static const QString Export   = "export";
-    static const QString Validate = "validate";
+    static const QString Help          = "help";
+    static const QString Export        = "export";
+    static const QString Validate      = "validate";
+    static const QString BatchExport   = "batchexport";
+    static const QString BatchValidate = "batchvalidate";
 
     if (pCommand == Help) {
         // Display the commands that we support
@@ -94,6 +102,18 @@ bool CellMLToolsPlugin::executeCommand(const QString &pCommand,
         return runValidateCommand(pArguments);
     }
 
+    if (pCommand == BatchExport) {
+        // Export several files from one format to another
+
+        return runBatchExportCommand(pArguments);
+    }
+
+    if (pCommand == BatchValidate) {
+        // Validate several files
+
+        return runBatchValidateCommand(pArguments);
+    }
+
     // Not a CLI command that we support
 
     runHelpCommand();
@@ -321,6 +341,15 @@ void CellMLToolsPlugin::runHelpCommand()
     std::cout << "      cellml_1_0: to export a CellML 1.1 file to CellML 1.0" << std::endl;
     std::cout << " * Validate <file>:" << std::endl;
     std::cout << "      validate <file>" << std::endl;
+    std::cout << " * Export several <files> to a <predefined_format> or a <user_defined_format_file>:" << std::endl;
+    std::cout << "      batchexport <predefined_format>|<user_defined_format_file> <files>" << std::endl;
+    std::cout << " * Validate several <files>:" << std::endl;
+    std::cout << "      batchvalidate <files>" << std::endl;
+    std::cout << "   <files> is a list of local files, directories (all their *.cellml files)," << std::endl;
+    std::cout << "   wildcards (e.g. models/*.cellml) and/or @<file_list> (one file per line)." << std::endl;
+    std::cout << "   Files are processed in parallel, with one JSON line being output per file." << std::endl;
+    std::cout << "   Exported files are saved next to their original file, using the name of" << std::endl;
+    std::cout << "   the format as an extra extension (e.g. model.cellml.cellml_1_0)." << std::endl;
 }
 
 //==============================================================================
@@ -504,6 +533,147 @@ bool CellMLToolsPlugin::runValidateCommand(const QStringList &pArguments)
 
 //==============================================================================
 
+QStringList CellMLToolsPlugin::batchFileNames(const QStringList &pArguments)
+{
+    // Retrieve the (local) files referenced by the given arguments, which can
+    // be files, directories, wildcards or lists of files
+
+    QStringList res;
+
+    for (const auto &argument : pArguments) {
+        if (argument.startsWith('@')) {
+            QString fileList;
+
+            if (Core::readFile(argument.mid(1), fileList)) {
+                for (const auto &line : fileList.split('\n')) {
+                    QString fileName = line.trimmed();
+
+                    if (!fileName.isEmpty() && !fileName.startsWith('#')) {
+                        res << fileName;
+                    }
+                }
+            } else {
+                res << argument.mid(1);
+                // Note: this will result in the file list being reported as
+                //       not found...
+            }
+        } else if (QFileInfo(argument).isDir()) {
+            QDirIterator dirIterator(argument, { "*.cellml" }, QDir::Files,
+                                     QDirIterator::Subdirectories);
+
+            while (dirIterator.hasNext()) {
+                res << dirIterator.next();
+            }
+        } else if (argument.contains(QRegularExpression(R"([*?[])"))) {
+            QFileInfo fileInfo(argument);
+            QDir dir = fileInfo.dir();
+
+            for (const auto &fileName : dir.entryList({ fileInfo.fileName() }, QDir::Files, QDir::Name)) {
+                res << dir.filePath(fileName);
+            }
+        } else {
+            res << argument;
+        }
+    }
+
+    res.removeDuplicates();
+
+    return res;
+}
+
+//==============================================================================
+
+bool CellMLToolsPlugin::runBatchCommand(CellmlToolsBatchWorker::Task pTask,
+                                        const QStringList &pArguments,
+                                        const QString &pFormatOrFileName)
+{
+    // Retrieve the files to process
+
+    QStringList fileNames = batchFileNames(pArguments);
+
+    if (fileNames.isEmpty()) {
+        std::cout << "No files could be found." << std::endl;
+
+        return false;
+    }
+
+    // Make sure that our file manager exists before processing our files
+    // Note: our CellmlFile objects use our file manager (to retrieve and set
+    //       their dependencies), but creating it involves registering it as a
+    //       global instance with our application, something that is not thread
+    //       safe and must therefore be done from the main thread. Once created,
+    //       our workers only look up unmanaged files in it...
+
+    Core::FileManager::instance();
+
+    // Process our files in parallel, each of them with its own CellmlFile
+    // object, and wait for all of them to be processed
+
+    QThreadPool threadPool;
+    QMutex outputMutex;
+    bool res = true;
+
+    for (const auto &fileName : fileNames) {
+        threadPool.start(new CellmlToolsBatchWorker(pTask, fileName,
+                                                    pFormatOrFileName,
+                                                    &outputMutex, &res));
+    }
+
+    threadPool.waitForDone();
+
+    return res;
+}
+
+//==============================================================================
+
+bool CellMLToolsPlugin::runBatchExportCommand(const QStringList &pArguments)
+{
+    // Make sure that we have a format and at least one file
+
+    if (pArguments.count() < 2) {
+        runHelpCommand();
+
+        return false;
+    }
+
+    // Make sure that our format is valid
+
+    static const QString Cellml10Export = "cellml_1_0";
+
+    QString formatOrFileName = pArguments[0];
+
+    if (   (formatOrFileName != Cellml10Export)
+        && !QFile::exists(formatOrFileName)) {
+        std::cout << "The user-defined format file could not be found." << std::endl;
+
+        return false;
+    }
+
+    // Export our files
+
+    return runBatchCommand(CellmlToolsBatchWorker::Task::Export,
+                           pArguments.mid(1), formatOrFileName);
+}
+
+//==============================================================================
+
+bool CellMLToolsPlugin::runBatchValidateCommand(const QStringList &pArguments)
+{
+    // Make sure that we have at least one file
+
+    if (pArguments.isEmpty()) {
+        runHelpCommand();
+
+        return false;
+    }
+
+    // Validate our files
+
+    return runBatchCommand(CellmlToolsBatchWorker::Task::Validate, pArguments);
+}
+
+//==============================================================================
+
 void CellMLToolsPlugin::exportToCellml10()
 {
     // Export the current file to CellML 1.0
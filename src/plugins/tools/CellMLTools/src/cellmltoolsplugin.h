@@ -26,6 +26,7 @@ along with this program. If not, see <https://gnu.org/licenses>.
 //==============================================================================
 
 #include "cellmlfile.h"
+#include "cellmltoolsbatchworker.h"
 #include "cliinterface.h"
 #include "guiinterface.h"
 #include "i18ninterface.h"
@@ -84,6 +85,14 @@ private:
 
     bool runCommand(Command pCommand, const QStringList &pArguments);
 
+    bool runBatchExportCommand(const QStringList &pArguments);
+    bool runBatchValidateCommand(const QStringList &pArguments);
+
+    QStringList batchFileNames(const QStringList &pArguments);
+    bool runBatchCommand(CellmlToolsBatchWorker::Task pTask,
+                         const QStringList &pArguments,
+                         const QString &pFormatOrFileName = QString());
+
 private slots:
     void exportToCellml10();
 
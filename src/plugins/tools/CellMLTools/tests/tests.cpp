@@ -34,6 +34,11 @@ along with this program. If not, see <https://gnu.org/licenses>.
 
 //==============================================================================
 
+#include <QDirIterator>
+#include <QTemporaryDir>
+
+//==============================================================================
+
 void Tests::helpTests()
 {
     // Ask for the plugin's help
@@ -151,6 +156,90 @@ void Tests::validateCellmlFiles()
 
 //==============================================================================
 
+void Tests::batchValidateCellmlFiles()
+{
+    // Try to batch validate without any file
+
+    QVERIFY(OpenCOR::runCli({ "-c", "CellMLTools::batchvalidate" }, mOutput));
+    QCOMPARE(mOutput, OpenCOR::fileContents(OpenCOR::fileName("src/plugins/tools/CellMLTools/tests/data/help.out")));
+
+    // Batch validate a valid CellML file and a non-existing one, and make sure
+    // that we get one JSON line for each of them
+
+    QString fileName = OpenCOR::fileName("models/noble_model_1962.cellml");
+
+    QVERIFY(OpenCOR::runCli({ "-c", "CellMLTools::batchvalidate", fileName, "non_existing_file" }, mOutput));
+    QCOMPARE(mOutput.count(), 3);
+
+    mOutput.sort();
+
+    QVERIFY(mOutput[1].startsWith(QString(R"({"file":"%1","issues":[],"success":true,"time":)").arg(fileName)));
+    QVERIFY(mOutput[2].startsWith(R"({"file":"non_existing_file","message":"The file could not be found.","success":false,"time":)"));
+}
+
+//==============================================================================
+
+void Tests::batchExportCellmlFiles()
+{
+    // Try to batch export without any file
+
+    QVERIFY(OpenCOR::runCli({ "-c", "CellMLTools::batchexport", "cellml_1_0" }, mOutput));
+    QCOMPARE(mOutput, OpenCOR::fileContents(OpenCOR::fileName("src/plugins/tools/CellMLTools/tests/data/help.out")));
+
+    // Try to batch export to a user-defined format, which file description
+    // doesn't exist
+
+    QVERIFY(OpenCOR::runCli({ "-c", "CellMLTools::batchexport", "non_existing_user_defined_format_file", "non_existing_file" }, mOutput));
+    QCOMPARE(mOutput, QStringList() << "The user-defined format file could not be found." << QString());
+
+    // Copy our CellML 1.1 files to a temporary directory, since our exports
+    // are saved next to the files being exported
+
+    QTemporaryDir temporaryDir;
+
+    QVERIFY(temporaryDir.isValid());
+
+    QString cellml11DirName = OpenCOR::dirName("models/tests/cellml/cellml_1_1");
+    QDirIterator dirIterator(cellml11DirName, QDir::Files, QDirIterator::Subdirectories);
+
+    while (dirIterator.hasNext()) {
+        QString fileName = dirIterator.next();
+        QString newFileName = temporaryDir.filePath(QDir(cellml11DirName).relativeFilePath(fileName));
+
+        QVERIFY(QDir().mkpath(QFileInfo(newFileName).path()));
+        QVERIFY(QFile::copy(fileName, newFileName));
+    }
+
+    // Batch export a CellML 1.1 file, a CellML 1.0 file and a non-existing
+    // file to CellML 1.0, and make sure that we get one JSON line for each of
+    // them and that our CellML 1.1 file has been properly exported
+
+    QString cellml11FileName = temporaryDir.filePath("experiments/periodic-stimulus.xml");
+    QString cellml10FileName = OpenCOR::fileName("models/noble_model_1962.cellml");
+
+    QVERIFY(OpenCOR::runCli({ "-c", "CellMLTools::batchexport", "cellml_1_0", cellml11FileName, cellml10FileName, "non_existing_file" }, mOutput));
+    QCOMPARE(mOutput.count(), 4);
+
+    auto hasOutputLine = [this](const QString &pStart) {
+        for (const auto &outputLine : mOutput) {
+            if (outputLine.startsWith(pStart)) {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    QVERIFY(hasOutputLine(QString(R"({"file":"%1","output":"%1.cellml_1_0","success":true,"time":)").arg(cellml11FileName)));
+    QVERIFY(hasOutputLine(QString(R"({"file":"%1","message":"The file must be a CellML 1.1 file.","success":false,"time":)").arg(cellml10FileName)));
+    QVERIFY(hasOutputLine(R"({"file":"non_existing_file","message":"The file could not be found.","success":false,"time":)"));
+
+    QCOMPARE(OpenCOR::fileContents(cellml11FileName+".cellml_1_0"),
+             OpenCOR::fileContents(OpenCOR::fileName("src/plugins/tools/CellMLTools/tests/data/cellml_1_0_export.out")));
+}
+
+//==============================================================================
+
 QTEST_APPLESS_MAIN(Tests)
 
 //==============================================================================
@@ -41,6 +41,8 @@ private slots:
     void exportToUserDefinedFormatTests();
     void exportToCellml10Tests();
     void validateCellmlFiles();
+    void batchValidateCellmlFiles();
+    void batchExportCellmlFiles();
 };
 
 //==============================================================================